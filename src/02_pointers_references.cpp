@@ -13,6 +13,11 @@
 
 #include <iostream>
 #include <string>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+
+#include "inplace_function.h"
 
 // TODO: Implement these functions for function pointer demonstrations
 
@@ -24,6 +29,10 @@ void greet(const std::string& name);
 // 2. Function that takes function pointer
 int calculate(int a, int b, int (*operation)(int, int));
 
+// Same, but also takes capturing lambdas; the callable is stored inline, so
+// passing one never allocates
+int calculateWith(int a, int b, const inplace_function<int(int, int)>& operation);
+
 // 3. Function that returns function pointer
 int (*getOperation(char op))(int, int);
 
@@ -55,6 +64,7 @@ void demonstrateDanglingPointers();
 void demonstrateDoublePointers();
 void demonstrateFunctionPointers();
 void demonstratePointerToMembers();
+void benchmarkCallbackDispatch();
 
 int main() {
     std::cout << "=== Pointers and References Examples ===\n\n";
@@ -68,6 +78,7 @@ int main() {
     demonstrateDoublePointers();
     demonstrateFunctionPointers();
     demonstratePointerToMembers();
+    benchmarkCallbackDispatch();
     
     return 0;
 }
@@ -206,6 +217,51 @@ void demonstratePointerToMembers() {
     std::cout << "---\n\n";
 }
 
+static volatile long long callbackSink = 0;
+
+template<typename Fn>
+static double nsPerCall(int calls, Fn fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    long long sum = 0;
+    for (int i = 0; i < calls; ++i) {
+        sum += fn(i);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    callbackSink = sum;
+    return std::chrono::duration<double, std::nano>(end - start).count() / calls;
+}
+
+void benchmarkCallbackDispatch() {
+    std::cout << "9. Callback Dispatch Cost:\n";
+    const int calls = 10000000;
+    int offset = 3;
+    // Callables are built once; the loop measures only the call path
+    inplace_function<int(int, int)> inplacePointer = add;
+    inplace_function<int(int, int)> inplaceLambda = [offset](int a, int b) { return a + b + offset; };
+    std::function<int(int, int)> stdFunction = [offset](int a, int b) { return a + b + offset; };
+    
+    struct Row {
+        const char* name;
+        double ns;
+    };
+    Row rows[] = {
+        {"direct call add()", nsPerCall(calls, [](int i) { return add(i, 3); })},
+        {"calculate(function pointer)", nsPerCall(calls, [](int i) { return calculate(i, 3, add); })},
+        {"calculateWith(inplace_function = add)",
+         nsPerCall(calls, [&](int i) { return calculateWith(i, 3, inplacePointer); })},
+        {"calculateWith(inplace_function = lambda)",
+         nsPerCall(calls, [&](int i) { return calculateWith(i, 3, inplaceLambda); })},
+        {"std::function = lambda", nsPerCall(calls, [&](int i) { return stdFunction(i, 3); })},
+    };
+    std::cout << calls << " calls\n";
+    for (const Row& row : rows) {
+        std::cout << std::left << std::setw(44) << row.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(8) << row.ns << " ns/call\n";
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << "---\n\n";
+}
+
 // TODO: Implement the helper functions
 int add(int a, int b) {
     return a + b;
@@ -223,6 +279,10 @@ int calculate(int a, int b, int (*operation)(int, int)) {
     return operation(a, b);
 }
 
+int calculateWith(int a, int b, const inplace_function<int(int, int)>& operation) {
+    return operation(a, b);
+}
+
 int (*getOperation(char op))(int, int) {
     switch (op) {
         case '+': return add;
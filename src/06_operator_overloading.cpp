@@ -14,6 +14,14 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+#include <utility>
+
+#include "allocation_counter.h"
 
 // TODO: Implement these classes
 
@@ -56,13 +64,76 @@ public:
 };
 
 // 2. Vector-like class demonstrating subscript and function call operators
-class MyVector {
+// Element-wise +, - and * build expression templates instead of vectors:
+// a + b * c - d is a small tree of nodes holding references to the leaf
+// MyVectors, and one fused loop runs when the tree is assigned to a
+// MyVector. Expressions reference their operands, so keep them inside one
+// full-expression rather than storing them in auto variables.
+class MyVector;
+
+template<typename E>
+class VecExpr {
+public:
+    int operator[](size_t i) const { return static_cast<const E&>(*this)[i]; }
+    size_t size() const { return static_cast<const E&>(*this).size(); }
+};
+
+// Leaves are held by reference, intermediate nodes by value
+template<typename E>
+struct VecExprStorage {
+    using type = const E;
+};
+
+template<>
+struct VecExprStorage<MyVector> {
+    using type = const MyVector&;
+};
+
+template<typename L, typename R, typename Op>
+class VecBinary : public VecExpr<VecBinary<L, R, Op>> {
+private:
+    typename VecExprStorage<L>::type lhs;
+    typename VecExprStorage<R>::type rhs;
+
+public:
+    VecBinary(const L& l, const R& r) : lhs(l), rhs(r) {
+        if (l.size() != r.size()) {
+            throw std::invalid_argument("MyVector expression: size mismatch");
+        }
+    }
+    int operator[](size_t i) const { return Op::apply(lhs[i], rhs[i]); }
+    size_t size() const { return lhs.size(); }
+};
+
+template<typename E>
+class VecScaled : public VecExpr<VecScaled<E>> {
+private:
+    int scalar;
+    typename VecExprStorage<E>::type expr;
+
+public:
+    VecScaled(int s, const E& e) : scalar(s), expr(e) {}
+    int operator[](size_t i) const { return scalar * expr[i]; }
+    size_t size() const { return expr.size(); }
+};
+
+struct VecAddOp { static int apply(int a, int b) { return a + b; } };
+struct VecSubOp { static int apply(int a, int b) { return a - b; } };
+struct VecMulOp { static int apply(int a, int b) { return a * b; } };
+
+class MyVector : public VecExpr<MyVector> {
 private:
     std::vector<int> data;
     
 public:
     MyVector(size_t size = 0, int defaultValue = 0);
     MyVector(std::initializer_list<int> list);
+    MyVector(const MyVector& other) = default;
+    MyVector(MyVector&& other) noexcept = default;
+
+    // Evaluates an expression in a single pass
+    template<typename E>
+    MyVector(const VecExpr<E>& expr);
     
     // Subscript operators
     int& operator[](size_t index);
@@ -74,6 +145,9 @@ public:
     
     // Assignment operator
     MyVector& operator=(const MyVector& other);
+    MyVector& operator=(MyVector&& other) noexcept = default;
+    template<typename E>
+    MyVector& operator=(const VecExpr<E>& expr);
     
     // Comparison operators
     bool operator==(const MyVector& other) const;
@@ -87,15 +161,40 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const MyVector& vec);
 };
 
+template<typename L, typename R>
+VecBinary<L, R, VecAddOp> operator+(const VecExpr<L>& l, const VecExpr<R>& r);
+template<typename L, typename R>
+VecBinary<L, R, VecSubOp> operator-(const VecExpr<L>& l, const VecExpr<R>& r);
+template<typename L, typename R>
+VecBinary<L, R, VecMulOp> operator*(const VecExpr<L>& l, const VecExpr<R>& r);  // Element-wise
+template<typename E>
+VecScaled<E> operator*(int scalar, const VecExpr<E>& e);
+template<typename E>
+VecScaled<E> operator*(const VecExpr<E>& e, int scalar);
+template<typename E>
+std::ostream& operator<<(std::ostream& os, const VecExpr<E>& expr);
+
 // 3. String class demonstrating various operators
+// Small-string optimization: up to SSO_CAPACITY chars live in inlineBuffer
+// (str points at it), longer strings go to the heap. += grows geometrically
+// and operator+ on an rvalue left operand appends into its buffer.
 class MyString {
 private:
+    static constexpr size_t SSO_CAPACITY = 15;
+
     char* str;
     size_t len;
+    size_t cap;  // Usable chars, excluding the terminator
+    char inlineBuffer[SSO_CAPACITY + 1];
+
+    bool isInline() const { return str == inlineBuffer; }
+    void resetToInline();
+    void assign(const char* s, size_t n);
     
 public:
     MyString();
     MyString(const char* s);
+    MyString(const char* s, size_t n);
     MyString(const MyString& other);             // Copy constructor
     MyString(MyString&& other) noexcept;         // Move constructor
     ~MyString();
@@ -106,8 +205,10 @@ public:
     MyString& operator=(const char* s);
     
     // Arithmetic operators
-    MyString operator+(const MyString& other) const;
+    MyString operator+(const MyString& other) const&;
+    MyString operator+(const MyString& other) &&;   // Reuses this buffer
     MyString& operator+=(const MyString& other);
+    MyString& append(const char* s, size_t n);
     
     // Subscript operators
     char& operator[](size_t index);
@@ -126,6 +227,9 @@ public:
     
     // Utility functions
     size_t length() const { return len; }
+    size_t capacity() const { return cap; }
+    bool isSmall() const { return isInline(); }
+    void reserve(size_t newCapacity);
     const char* c_str() const { return str; }
     
     // Stream operators
@@ -133,6 +237,38 @@ public:
     friend std::istream& operator>>(std::istream& is, MyString& s);
 };
 
+// Lazy concatenation: records pieces and allocates the result once in
+// build(), after the final length is known. Pieces are not copied, so
+// they must outlive the builder.
+class MyStringBuilder {
+private:
+    struct Piece {
+        const char* data;
+        size_t size;
+    };
+
+    static constexpr size_t INLINE_PIECES = 16;
+    std::array<Piece, INLINE_PIECES> inlinePieces;
+    std::vector<Piece> overflow;
+    size_t pieceCount = 0;
+    size_t totalLength = 0;
+
+    void addPiece(const char* data, size_t size);
+    
+public:
+    MyStringBuilder& append(const MyString& s) { addPiece(s.c_str(), s.length()); return *this; }
+    MyStringBuilder& append(const char* s) { addPiece(s, std::strlen(s)); return *this; }
+    MyStringBuilder& operator+=(const MyString& s) { return append(s); }
+    MyStringBuilder& operator+=(const char* s) { return append(s); }
+    
+    size_t length() const { return totalLength; }
+    MyString build() const;
+};
+
+// One-shot variadic form of the builder: concat(a, " ", b)
+template<typename... Parts>
+MyString concat(const Parts&... parts);
+
 // 4. Smart pointer class demonstrating pointer-like operators
 template<typename T>
 class SmartPtr {
@@ -173,6 +309,10 @@ void demonstrateSubscriptOperator();
 void demonstrateFunctionCallOperator();
 void demonstrateUnaryOperators();
 void demonstrateConversionOperators();
+void demonstrateStringConcatenation();
+void benchmarkStringConcatenation();
+void demonstrateExpressionTemplates();
+void benchmarkExpressionTemplates();
 
 int main() {
     std::cout << "=== Operator Overloading Examples ===\n\n";
@@ -186,6 +326,10 @@ int main() {
     demonstrateFunctionCallOperator();
     demonstrateUnaryOperators();
     demonstrateConversionOperators();
+    demonstrateStringConcatenation();
+    benchmarkStringConcatenation();
+    demonstrateExpressionTemplates();
+    benchmarkExpressionTemplates();
     
     return 0;
 }
@@ -291,4 +435,592 @@ void demonstrateConversionOperators() {
     std::cout << "---\n\n";
 }
 
+void demonstrateStringConcatenation() {
+    std::cout << "9. String Concatenation (SSO and rvalue operator+):\n";
+
+    MyString shortStr("short");
+    MyString longStr("a string that is too long for the inline buffer");
+    std::cout << "\"" << shortStr << "\" inline: " << (shortStr.isSmall() ? "yes" : "no")
+              << ", capacity " << shortStr.capacity() << "\n";
+    std::cout << "\"" << longStr << "\" inline: " << (longStr.isSmall() ? "yes" : "no")
+              << ", capacity " << longStr.capacity() << "\n";
+
+    // Each + after the first appends into the temporary from the previous one
+    MyString user("user");
+    MyString domain("example.com");
+    MyString email = user + "_" + "42" + "@" + domain;
+    std::cout << "Chained +: " << email << " (capacity " << email.capacity() << ")\n";
+
+    MyString grown;
+    for (int i = 0; i < 10; ++i) {
+        grown += "abcd";
+        std::cout << grown.capacity() << (i < 9 ? " " : " <- capacity after each += \"abcd\"\n");
+    }
+
+    MyStringBuilder builder;
+    builder.append(user).append("_").append("42").append("@").append(domain);
+    std::cout << "Builder (" << builder.length() << " chars): " << builder.build() << "\n";
+    std::cout << "concat(): " << concat(domain, "/", user) << "\n";
+    std::cout << "---\n\n";
+}
+
+template<typename Build>
+static void reportConcat(const char* label, int iterations, Build build) {
+    size_t checksum = 0;
+    AllocationRun run = measureAllocations(iterations, [&] {
+        for (int i = 0; i < iterations; ++i) {
+            checksum += build(i);
+        }
+    });
+    std::cout << std::left << std::setw(36) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << run.allocationsPerOp
+              << std::setw(10) << std::setprecision(1) << run.nsPerOp
+              << "   (checksum " << checksum << ")\n" << std::defaultfloat;
+}
+
+void benchmarkStringConcatenation() {
+    std::cout << "10. String Concatenation Benchmark:\n";
+    constexpr int ITERATIONS = 200000;
+
+    const char* shortParts[] = {"id", "_", "42", ":", "ok"};                 // 8 chars total
+    const char* longParts[] = {"customer_account", "/", "region-eu-west", "/", "shard-0042"};  // 42 chars
+
+    for (const char** parts : {shortParts, longParts}) {
+        std::cout << (parts == shortParts ? "Short result (8 chars, fits SSO):\n"
+                                          : "Long result (42 chars, heap):\n");
+        std::cout << std::left << std::setw(36) << "  Method" << std::right << std::setw(12) << "allocs/op"
+                  << std::setw(10) << "ns/op" << "\n";
+
+        std::string s0 = parts[0], s1 = parts[1], s2 = parts[2], s3 = parts[3], s4 = parts[4];
+        MyString m0 = parts[0], m1 = parts[1], m2 = parts[2], m3 = parts[3], m4 = parts[4];
+
+        reportConcat("  std::string a + b + c + d + e", ITERATIONS, [&](int) {
+            std::string r = s0 + s1 + s2 + s3 + s4;
+            return r.size();
+        });
+        reportConcat("  MyString a + b + c + d + e", ITERATIONS, [&](int) {
+            MyString r = m0 + m1 + m2 + m3 + m4;
+            return r.length();
+        });
+        reportConcat("  MyStringBuilder", ITERATIONS, [&](int) {
+            MyStringBuilder builder;
+            builder.append(m0).append(m1).append(m2).append(m3).append(m4);
+            return builder.build().length();
+        });
+        reportConcat("  concat(a, b, c, d, e)", ITERATIONS, [&](int) {
+            return concat(m0, m1, m2, m3, m4).length();
+        });
+    }
+    std::cout << "---\n\n";
+}
+
+// Expression template demonstration and benchmark
+void demonstrateExpressionTemplates() {
+    std::cout << "11. Expression Templates:\n";
+
+    MyVector a{1, 2, 3, 4};
+    MyVector b{10, 20, 30, 40};
+    MyVector c{2, 2, 2, 2};
+    MyVector d{1, 1, 1, 1};
+
+    // One loop, one allocation (for result); no per-operator temporaries
+    size_t before = allocationCount.load(std::memory_order_relaxed);
+    MyVector result = a + b * c - d;
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
+    std::cout << "a + b * c - d = " << result << " (" << allocations << " allocation)\n";
+
+    // Lazy evaluation: printing an expression evaluates it element by element
+    std::cout << "3 * a + d = " << 3 * a + d << "\n";
+    result = result - a;  // Element-wise, so reading and writing result is safe
+    std::cout << "result - a = " << result << ", equals b * c - d: "
+              << (result == b * c - d ? "yes" : "no") << "\n";
+
+    Complex z1(1, 2), z2(3, -1), z3(0.5, 0.5), z4(2, 0);
+    std::cout << "Complex z1 + z2 * z3 - z4 = " << (z1 + z2 * z3 - z4) << "\n";
+    std::cout << "---\n\n";
+}
+
+// The pre-expression-template behavior: every operator returns a new vector
+static MyVector eagerAdd(const MyVector& l, const MyVector& r) {
+    MyVector out(l.size());
+    for (size_t i = 0; i < l.size(); ++i) {
+        out[i] = l[i] + r[i];
+    }
+    return out;
+}
+
+static MyVector eagerSub(const MyVector& l, const MyVector& r) {
+    MyVector out(l.size());
+    for (size_t i = 0; i < l.size(); ++i) {
+        out[i] = l[i] - r[i];
+    }
+    return out;
+}
+
+static MyVector eagerMul(const MyVector& l, const MyVector& r) {
+    MyVector out(l.size());
+    for (size_t i = 0; i < l.size(); ++i) {
+        out[i] = l[i] * r[i];
+    }
+    return out;
+}
+
+template<typename Fn>
+static void reportExpression(const char* label, int repeats, Fn fn) {
+    long long checksum = 0;
+    AllocationRun run = measureAllocations(repeats, [&] {
+        for (int r = 0; r < repeats; ++r) {
+            checksum += fn();
+        }
+    });
+    std::cout << std::left << std::setw(42) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << run.allocationsPerOp
+              << std::setw(10) << std::setprecision(2) << run.nsPerOp / 1e6 << "   (checksum " << checksum << ")\n";
+}
+
+void benchmarkExpressionTemplates() {
+    std::cout << "12. Expression Template Benchmark:\n";
+    constexpr size_t N = 1000000;
+    constexpr int REPEATS = 10;
+
+    std::vector<MyVector> v;
+    for (int k = 0; k < 8; ++k) {
+        MyVector vec(N);
+        for (size_t i = 0; i < N; ++i) {
+            vec[i] = static_cast<int>((i * (k + 3)) % 17) - 8;
+        }
+        v.push_back(vec);
+    }
+    MyVector out(N);
+
+    std::cout << N << "-element MyVector, averaged over " << REPEATS << " runs\n";
+    std::cout << std::left << std::setw(42) << "Expression" << std::right << std::setw(10) << "allocs"
+              << std::setw(10) << "ms" << "\n";
+
+    reportExpression("4 terms, eager temporaries", REPEATS, [&]() {
+        out = eagerSub(eagerAdd(v[0], eagerMul(v[1], v[2])), v[3]);
+        return static_cast<long long>(out[N / 2]);
+    });
+    reportExpression("4 terms, expression template", REPEATS, [&]() {
+        out = v[0] + v[1] * v[2] - v[3];
+        return static_cast<long long>(out[N / 2]);
+    });
+    reportExpression("8 terms, eager temporaries", REPEATS, [&]() {
+        out = eagerAdd(eagerSub(eagerAdd(v[0], eagerMul(v[1], v[2])), v[3]),
+                       eagerSub(eagerAdd(eagerMul(v[4], v[5]), v[6]), v[7]));
+        return static_cast<long long>(out[N / 2]);
+    });
+    reportExpression("8 terms, expression template", REPEATS, [&]() {
+        out = v[0] + v[1] * v[2] - v[3] + (v[4] * v[5] + v[6] - v[7]);
+        return static_cast<long long>(out[N / 2]);
+    });
+
+    // Complex is two doubles: its temporaries live in registers, so plain
+    // operators already allocate nothing and there is nothing to fuse
+    std::vector<Complex> za(N, Complex(1, 2)), zb(N, Complex(0.5, -1)), zc(N, Complex(2, 0.25)), zd(N, Complex(1, 1));
+    std::vector<Complex> zout(N);
+    reportExpression("Complex 4 terms, plain operators", REPEATS, [&]() {
+        for (size_t i = 0; i < N; ++i) {
+            zout[i] = za[i] + zb[i] * zc[i] - zd[i];
+        }
+        return static_cast<long long>(zout[N / 2].getReal());
+    });
+    reportExpression("Complex 8 terms, plain operators", REPEATS, [&]() {
+        for (size_t i = 0; i < N; ++i) {
+            zout[i] = za[i] + zb[i] * zc[i] - zd[i] + (zd[i] * zc[i] + zb[i] - za[i]);
+        }
+        return static_cast<long long>(zout[N / 2].getReal());
+    });
+    std::cout << "---\n\n";
+}
+
+// Complex implementation
+Complex::Complex(double r, double i) : real(r), imag(i) {}
+
+Complex Complex::operator+(const Complex& other) const {
+    return Complex(real + other.real, imag + other.imag);
+}
+
+Complex Complex::operator-(const Complex& other) const {
+    return Complex(real - other.real, imag - other.imag);
+}
+
+Complex Complex::operator*(const Complex& other) const {
+    return Complex(real * other.real - imag * other.imag, real * other.imag + imag * other.real);
+}
+
+Complex Complex::operator/(const Complex& other) const {
+    double denominator = other.real * other.real + other.imag * other.imag;
+    return Complex((real * other.real + imag * other.imag) / denominator,
+                   (imag * other.real - real * other.imag) / denominator);
+}
+
+Complex& Complex::operator+=(const Complex& other) {
+    return *this = *this + other;
+}
+
+Complex& Complex::operator-=(const Complex& other) {
+    return *this = *this - other;
+}
+
+Complex& Complex::operator*=(const Complex& other) {
+    return *this = *this * other;
+}
+
+Complex& Complex::operator/=(const Complex& other) {
+    return *this = *this / other;
+}
+
+Complex Complex::operator-() const {
+    return Complex(-real, -imag);
+}
+
+Complex& Complex::operator++() {
+    real += 1;
+    return *this;
+}
+
+Complex Complex::operator++(int) {
+    Complex old = *this;
+    real += 1;
+    return old;
+}
+
+bool Complex::operator==(const Complex& other) const {
+    return real == other.real && imag == other.imag;
+}
+
+bool Complex::operator!=(const Complex& other) const {
+    return !(*this == other);
+}
+
+std::ostream& operator<<(std::ostream& os, const Complex& c) {
+    return os << c.real << (c.imag < 0 ? " - " : " + ") << std::abs(c.imag) << "i";
+}
+
+std::istream& operator>>(std::istream& is, Complex& c) {
+    return is >> c.real >> c.imag;
+}
+
+// MyVector implementation
+MyVector::MyVector(size_t size, int defaultValue) : data(size, defaultValue) {}
+
+MyVector::MyVector(std::initializer_list<int> list) : data(list) {}
+
+template<typename E>
+MyVector::MyVector(const VecExpr<E>& expr) : data(expr.size()) {
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = expr[i];
+    }
+}
+
+int& MyVector::operator[](size_t index) {
+    return data[index];
+}
+
+const int& MyVector::operator[](size_t index) const {
+    return data[index];
+}
+
+int MyVector::operator()(size_t index) const {
+    return data.at(index);
+}
+
+void MyVector::operator()(size_t index, int value) {
+    data.at(index) = value;
+}
+
+MyVector& MyVector::operator=(const MyVector& other) {
+    if (this != &other) {
+        data = other.data;
+    }
+    return *this;
+}
+
+template<typename E>
+MyVector& MyVector::operator=(const VecExpr<E>& expr) {
+    if (expr.size() != data.size()) {
+        // Resizing could move storage the expression still reads from
+        MyVector evaluated(expr);
+        data.swap(evaluated.data);
+        return *this;
+    }
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = expr[i];
+    }
+    return *this;
+}
+
+bool MyVector::operator==(const MyVector& other) const {
+    return data == other.data;
+}
+
+bool MyVector::operator!=(const MyVector& other) const {
+    return !(*this == other);
+}
+
+std::ostream& operator<<(std::ostream& os, const MyVector& vec) {
+    os << "[";
+    for (size_t i = 0; i < vec.data.size(); ++i) {
+        os << (i ? ", " : "") << vec.data[i];
+    }
+    return os << "]";
+}
+
+// Expression template operators
+template<typename L, typename R>
+VecBinary<L, R, VecAddOp> operator+(const VecExpr<L>& l, const VecExpr<R>& r) {
+    return VecBinary<L, R, VecAddOp>(static_cast<const L&>(l), static_cast<const R&>(r));
+}
+
+template<typename L, typename R>
+VecBinary<L, R, VecSubOp> operator-(const VecExpr<L>& l, const VecExpr<R>& r) {
+    return VecBinary<L, R, VecSubOp>(static_cast<const L&>(l), static_cast<const R&>(r));
+}
+
+template<typename L, typename R>
+VecBinary<L, R, VecMulOp> operator*(const VecExpr<L>& l, const VecExpr<R>& r) {
+    return VecBinary<L, R, VecMulOp>(static_cast<const L&>(l), static_cast<const R&>(r));
+}
+
+template<typename E>
+VecScaled<E> operator*(int scalar, const VecExpr<E>& e) {
+    return VecScaled<E>(scalar, static_cast<const E&>(e));
+}
+
+template<typename E>
+VecScaled<E> operator*(const VecExpr<E>& e, int scalar) {
+    return VecScaled<E>(scalar, static_cast<const E&>(e));
+}
+
+template<typename E>
+std::ostream& operator<<(std::ostream& os, const VecExpr<E>& expr) {
+    os << "[";
+    for (size_t i = 0; i < expr.size(); ++i) {
+        os << (i ? ", " : "") << expr[i];
+    }
+    return os << "]";
+}
+
+// MyString implementation
+MyString::MyString() : str(inlineBuffer), len(0), cap(SSO_CAPACITY) {
+    inlineBuffer[0] = '\0';
+}
+
+MyString::MyString(const char* s) : MyString(s, s ? std::strlen(s) : 0) {}
+
+MyString::MyString(const char* s, size_t n) : MyString() {
+    assign(s, n);
+}
+
+MyString::MyString(const MyString& other) : MyString(other.str, other.len) {}
+
+MyString::MyString(MyString&& other) noexcept : str(inlineBuffer), len(other.len), cap(SSO_CAPACITY) {
+    if (other.isInline()) {
+        std::memcpy(inlineBuffer, other.inlineBuffer, len + 1);
+    } else {
+        str = other.str;
+        cap = other.cap;
+    }
+    other.resetToInline();
+}
+
+MyString::~MyString() {
+    if (!isInline()) {
+        delete[] str;
+    }
+}
+
+void MyString::resetToInline() {
+    str = inlineBuffer;
+    len = 0;
+    cap = SSO_CAPACITY;
+    inlineBuffer[0] = '\0';
+}
+
+// Reuses the current buffer whenever it is large enough
+void MyString::assign(const char* s, size_t n) {
+    if (n > cap) {
+        char* buffer = new char[n + 1];
+        if (!isInline()) {
+            delete[] str;
+        }
+        str = buffer;
+        cap = n;
+    }
+    if (n > 0) {
+        std::memmove(str, s, n);
+    }
+    len = n;
+    str[len] = '\0';
+}
+
+MyString& MyString::operator=(const MyString& other) {
+    if (this != &other) {
+        assign(other.str, other.len);
+    }
+    return *this;
+}
+
+MyString& MyString::operator=(MyString&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.isInline()) {
+        // Fits in any buffer we already have, so this cannot allocate
+        std::memcpy(str, other.inlineBuffer, other.len + 1);
+        len = other.len;
+    } else {
+        if (!isInline()) {
+            delete[] str;
+        }
+        str = other.str;
+        len = other.len;
+        cap = other.cap;
+    }
+    other.resetToInline();
+    return *this;
+}
+
+MyString& MyString::operator=(const char* s) {
+    assign(s, s ? std::strlen(s) : 0);
+    return *this;
+}
+
+void MyString::reserve(size_t newCapacity) {
+    if (newCapacity <= cap) {
+        return;
+    }
+    char* buffer = new char[newCapacity + 1];
+    std::memcpy(buffer, str, len + 1);
+    if (!isInline()) {
+        delete[] str;
+    }
+    str = buffer;
+    cap = newCapacity;
+}
+
+MyString& MyString::append(const char* s, size_t n) {
+    if (len + n > cap) {
+        // Geometric growth; copy before freeing in case s points into us
+        size_t newCapacity = std::max(len + n, cap * 2);
+        char* buffer = new char[newCapacity + 1];
+        std::memcpy(buffer, str, len);
+        std::memcpy(buffer + len, s, n);
+        if (!isInline()) {
+            delete[] str;
+        }
+        str = buffer;
+        cap = newCapacity;
+    } else {
+        std::memmove(str + len, s, n);
+    }
+    len += n;
+    str[len] = '\0';
+    return *this;
+}
+
+MyString MyString::operator+(const MyString& other) const& {
+    MyString result;
+    result.reserve(len + other.len);
+    result.append(str, len);
+    result.append(other.str, other.len);
+    return result;
+}
+
+MyString MyString::operator+(const MyString& other) && {
+    append(other.str, other.len);
+    return std::move(*this);
+}
+
+MyString& MyString::operator+=(const MyString& other) {
+    return append(other.str, other.len);
+}
+
+char& MyString::operator[](size_t index) {
+    return str[index];
+}
+
+const char& MyString::operator[](size_t index) const {
+    return str[index];
+}
+
+bool MyString::operator==(const MyString& other) const {
+    return len == other.len && std::memcmp(str, other.str, len) == 0;
+}
+
+bool MyString::operator!=(const MyString& other) const {
+    return !(*this == other);
+}
+
+bool MyString::operator<(const MyString& other) const {
+    int cmp = std::memcmp(str, other.str, std::min(len, other.len));
+    return cmp < 0 || (cmp == 0 && len < other.len);
+}
+
+bool MyString::operator>(const MyString& other) const {
+    return other < *this;
+}
+
+bool MyString::operator<=(const MyString& other) const {
+    return !(other < *this);
+}
+
+bool MyString::operator>=(const MyString& other) const {
+    return !(*this < other);
+}
+
+MyString::operator const char*() const {
+    return str;
+}
+
+std::ostream& operator<<(std::ostream& os, const MyString& s) {
+    return os.write(s.str, static_cast<std::streamsize>(s.len));
+}
+
+std::istream& operator>>(std::istream& is, MyString& s) {
+    std::string word;
+    if (is >> word) {
+        s.assign(word.data(), word.size());
+    }
+    return is;
+}
+
+// MyStringBuilder implementation
+void MyStringBuilder::addPiece(const char* data, size_t size) {
+    if (pieceCount < INLINE_PIECES) {
+        inlinePieces[pieceCount] = {data, size};
+    } else {
+        overflow.push_back({data, size});
+    }
+    ++pieceCount;
+    totalLength += size;
+}
+
+MyString MyStringBuilder::build() const {
+    MyString result;
+    result.reserve(totalLength);
+    for (size_t i = 0; i < pieceCount && i < INLINE_PIECES; ++i) {
+        result.append(inlinePieces[i].data, inlinePieces[i].size);
+    }
+    for (const Piece& piece : overflow) {
+        result.append(piece.data, piece.size);
+    }
+    return result;
+}
+
+// concat implementation
+inline size_t concatPieceLength(const MyString& s) { return s.length(); }
+inline size_t concatPieceLength(const char* s) { return std::strlen(s); }
+inline const char* concatPieceData(const MyString& s) { return s.c_str(); }
+inline const char* concatPieceData(const char* s) { return s; }
+
+template<typename... Parts>
+MyString concat(const Parts&... parts) {
+    MyString result;
+    result.reserve((concatPieceLength(parts) + ... + 0));
+    (result.append(concatPieceData(parts), concatPieceLength(parts)), ...);
+    return result;
+}
+
 // TODO: Implement all class methods
@@ -14,6 +14,20 @@
 #include <iostream>
 #include <new>
 #include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory_resource>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "memory_arena.h"
 
 // TODO: Implement these classes and functions
 
@@ -88,19 +102,121 @@ public:
 };
 
 // 5. Custom Memory Allocator (Simple)
+// Facade over SizeClassAllocator from memory_arena.h (growable, thread-safe,
+// reclaims freed blocks). A size header in front of each block lets
+// deallocate(ptr) work without the caller passing the size back.
 class SimpleAllocator {
 private:
-    static constexpr size_t POOL_SIZE = 1024;
-    static char memoryPool[POOL_SIZE];
-    static size_t currentOffset;
+    static constexpr size_t HEADER_SIZE = SizeClassAllocator::Alignment;
+    static std::atomic<size_t> bytesUsed;
+    static SizeClassAllocator& backend();
     
 public:
     static void* allocate(size_t size);
     static void deallocate(void* ptr);
-    static void reset();
     static size_t getBytesUsed();
 };
 
+// 6. Typed Object Pool
+// Fixed-size slots carved from aligned slabs, recycled through an intrusive
+// free list (the next pointer lives in the dead object's storage).
+// construct() is placement new into a free slot; destroy() runs the
+// destructor and pushes the slot back. With CrossThreadFree, threads other
+// than the owner push freed slots onto a lock-free stack that the owner
+// takes over wholesale when its own list runs dry.
+// On destruction the pool releases its slabs WITHOUT destroying objects
+// still alive, so every object must be destroyed first.
+enum class PoolSync { SingleThreaded, CrossThreadFree };
+
+template<typename T, PoolSync Sync = PoolSync::SingleThreaded>
+class ObjectPool {
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t SLAB_ALIGNMENT = alignof(Slot) > 64 ? alignof(Slot) : 64;
+
+    std::vector<std::pair<Slot*, size_t>> slabs;
+    Slot* freeList = nullptr;
+    Slot* bumpCursor = nullptr;  // Never-used slots of the newest slab
+    Slot* bumpEnd = nullptr;
+    size_t nextSlabSize;
+    const size_t maxSlabSize;
+
+    std::atomic<Slot*> remoteFrees{nullptr};
+    std::atomic<size_t> remoteFreed{0};
+    const std::thread::id owner;
+
+    size_t capacity = 0;
+    size_t localLive = 0;  // Constructed minus locally destroyed
+    size_t highWater = 0;
+
+    Slot* acquireSlot();
+    void addSlab();
+    void releaseSlot(Slot* slot);
+
+public:
+    // RAII handle: returns the object to its pool when it goes out of scope
+    class Handle {
+    private:
+        ObjectPool* pool = nullptr;
+        T* object = nullptr;
+
+    public:
+        Handle() = default;
+        Handle(ObjectPool* p, T* obj) : pool(p), object(obj) {}
+        ~Handle() { reset(); }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        Handle(Handle&& other) noexcept
+            : pool(std::exchange(other.pool, nullptr)), object(std::exchange(other.object, nullptr)) {}
+        Handle& operator=(Handle&& other) noexcept {
+            if (this != &other) {
+                reset();
+                pool = std::exchange(other.pool, nullptr);
+                object = std::exchange(other.object, nullptr);
+            }
+            return *this;
+        }
+
+        void reset() {
+            if (object) {
+                pool->destroy(object);
+                object = nullptr;
+            }
+        }
+
+        T* get() const { return object; }
+        T& operator*() const { return *object; }
+        T* operator->() const { return object; }
+        explicit operator bool() const { return object != nullptr; }
+    };
+
+    explicit ObjectPool(size_t initialSlabObjects = 64, size_t maxSlabObjects = 4096);
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Owner thread only
+    template<typename... Args>
+    T* construct(Args&&... args);
+    template<typename... Args>
+    Handle make(Args&&... args);
+
+    // Owner thread only, unless Sync is CrossThreadFree
+    void destroy(T* object);
+
+    size_t liveCount() const;
+    size_t getCapacity() const { return capacity; }
+    size_t getHighWater() const { return highWater; }
+    size_t getSlabCount() const { return slabs.size(); }
+    double occupancy() const { return capacity ? static_cast<double>(liveCount()) / capacity : 0.0; }
+};
+
 // Function prototypes
 void demonstrateStackVsHeap();
 void demonstrateNewDelete();
@@ -110,6 +226,9 @@ void demonstrateDynamicArrays();
 void demonstratePlacementNew();
 void demonstrateMemoryAlignment();
 void demonstrateCustomAllocator();
+void benchmarkAllocators();
+void demonstrateObjectPool();
+void benchmarkObjectPool();
 
 int main() {
     std::cout << "=== Memory Management Examples ===\n\n";
@@ -123,6 +242,9 @@ int main() {
     demonstratePlacementNew();
     demonstrateMemoryAlignment();
     demonstrateCustomAllocator();
+    benchmarkAllocators();
+    demonstrateObjectPool();
+    benchmarkObjectPool();
     
     return 0;
 }
@@ -180,7 +302,449 @@ void demonstrateMemoryAlignment() {
 
 void demonstrateCustomAllocator() {
     std::cout << "8. Custom Allocator:\n";
-    // Use simple memory pool
-    // Show allocation patterns
+
+    // Monotonic arena: pointer bumps, geometric block growth
+    MonotonicArena arena(256, 2.0);
+    for (int i = 0; i < 100; ++i) {
+        arena.allocate(24);
+    }
+    std::cout << "Arena: " << arena.getBytesUsed() << " bytes used in "
+              << arena.getBlockCount() << " blocks (" << arena.getBytesReserved()
+              << " bytes reserved)\n";
+    arena.release();
+    std::cout << "After release: " << arena.getBlockCount() << " blocks\n";
+
+    // Size classes: requests are rounded up and freed blocks are reused
+    SizeClassAllocator sizeClasses;
+    for (size_t request : {1, 17, 100, 200, 700, 4096}) {
+        std::cout << "Request " << request << " -> class "
+                  << SizeClassAllocator::roundedSize(request) << " bytes\n";
+    }
+    void* first = sizeClasses.allocate(40);
+    sizeClasses.deallocate(first, 40);
+    void* second = sizeClasses.allocate(48);
+    std::cout << "48-byte block reuses the freed 40-byte block: "
+              << (first == second ? "yes" : "no") << "\n";
+    sizeClasses.deallocate(second, 48);
+
+    // SimpleAllocator keeps its old interface on top of the size classes
+    int* numbers = static_cast<int*>(SimpleAllocator::allocate(10 * sizeof(int)));
+    for (int i = 0; i < 10; ++i) {
+        numbers[i] = i * i;
+    }
+    std::cout << "SimpleAllocator bytes in use: " << SimpleAllocator::getBytesUsed()
+              << ", numbers[9] = " << numbers[9] << "\n";
+    SimpleAllocator::deallocate(numbers);
+    std::cout << "After deallocate: " << SimpleAllocator::getBytesUsed() << " bytes\n";
+
+    // Same resource behind a pmr container
+    SizeClassMemoryResource resource;
+    std::pmr::vector<int> values(&resource);
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    std::cout << "pmr::vector of " << values.size() << " ints, arena reserved "
+              << resource.getBytesReserved() << " bytes\n";
     std::cout << "---\n\n";
 }
+
+// Allocator benchmark helpers
+static long residentKB() {
+    std::ifstream statm("/proc/self/statm");
+    long totalPages = 0;
+    long residentPages = 0;
+    statm >> totalPages >> residentPages;
+    return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+struct ChurnSlot {
+    void* ptr = nullptr;
+    size_t size = 0;
+};
+
+// Random free + allocate over a fixed window of live blocks (16-256 bytes)
+template<typename AllocFn, typename FreeFn>
+static void churn(std::vector<ChurnSlot>& slots, size_t ops, uint32_t seed, AllocFn& allocFn, FreeFn& freeFn) {
+    uint32_t state = seed;
+    for (size_t i = 0; i < ops; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        ChurnSlot& slot = slots[state % slots.size()];
+        if (slot.ptr) {
+            freeFn(slot.ptr, slot.size);
+        }
+        slot.size = 16 + (state >> 8) % 241;
+        slot.ptr = allocFn(slot.size);
+        static_cast<char*>(slot.ptr)[0] = static_cast<char>(i);
+    }
+}
+
+// Each run happens in a forked child so RSS is not polluted by earlier runs
+template<typename AllocFn, typename FreeFn>
+static void runChurnBenchmark(const char* name, size_t threads, AllocFn allocFn, FreeFn freeFn) {
+    constexpr size_t TOTAL_OPS = 2000000;
+    constexpr size_t SLOTS_PER_THREAD = 8192;
+
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::cout << "fork failed, skipping " << name << "\n";
+        return;
+    }
+    if (pid > 0) {
+        waitpid(pid, nullptr, 0);
+        return;
+    }
+
+    const size_t opsPerThread = TOTAL_OPS / threads;
+    std::vector<std::vector<ChurnSlot>> slots(threads, std::vector<ChurnSlot>(SLOTS_PER_THREAD));
+    const long rssBefore = residentKB();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            churn(slots[t], opsPerThread, static_cast<uint32_t>(2463534242u + t * 7919), allocFn, freeFn);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const long rssPeak = residentKB();
+
+    for (auto& threadSlots : slots) {
+        for (auto& slot : threadSlots) {
+            if (slot.ptr) {
+                freeFn(slot.ptr, slot.size);
+            }
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::setw(4) << threads
+              << std::setw(14) << std::fixed << std::setprecision(2)
+              << (opsPerThread * threads / seconds / 1e6) << std::setw(12) << (rssPeak - rssBefore) << "\n";
+    std::cout.flush();
+    _exit(0);
+}
+
+void benchmarkAllocators() {
+    std::cout << "9. Allocator Benchmark:\n";
+    std::cout << "Churn of 2M random 16-256 byte allocations over 8192 live blocks per thread\n";
+    std::cout << std::left << std::setw(28) << "Allocator" << std::right << std::setw(4) << "Thr"
+              << std::setw(14) << "M allocs/s" << std::setw(12) << "RSS +KB" << "\n";
+
+    SizeClassAllocator sizeClasses;
+    SizeClassMemoryResource sizeClassResource;
+    std::pmr::synchronized_pool_resource stdPool;
+
+    size_t maxThreads = std::max(2u, std::thread::hardware_concurrency());
+    for (size_t threads : {size_t(1), maxThreads}) {
+        runChurnBenchmark("new/delete", threads,
+            [](size_t n) { return static_cast<void*>(new char[n]); },
+            [](void* p, size_t) { delete[] static_cast<char*>(p); });
+        runChurnBenchmark("malloc/free", threads,
+            [](size_t n) { return std::malloc(n); },
+            [](void* p, size_t) { std::free(p); });
+        runChurnBenchmark("SizeClassAllocator", threads,
+            [&](size_t n) { return sizeClasses.allocate(n); },
+            [&](void* p, size_t n) { sizeClasses.deallocate(p, n); });
+        runChurnBenchmark("SizeClassMemoryResource", threads,
+            [&](size_t n) { return sizeClassResource.allocate(n); },
+            [&](void* p, size_t n) { sizeClassResource.deallocate(p, n); });
+        runChurnBenchmark("pmr::synchronized_pool", threads,
+            [&](size_t n) { return stdPool.allocate(n); },
+            [&](void* p, size_t n) { stdPool.deallocate(p, n); });
+    }
+    std::cout << "---\n\n";
+}
+
+// Object pool demonstration and benchmark
+void demonstrateObjectPool() {
+    std::cout << "10. Object Pool:\n";
+
+    ObjectPool<PlacementDemo> pool(4);
+    {
+        std::vector<ObjectPool<PlacementDemo>::Handle> handles;
+        for (int i = 0; i < 10; ++i) {
+            handles.push_back(pool.make(i * 10));
+        }
+        std::cout << "Live " << pool.liveCount() << " / capacity " << pool.getCapacity()
+                  << " in " << pool.getSlabCount() << " slabs, occupancy "
+                  << std::fixed << std::setprecision(2) << pool.occupancy() << "\n";
+        handles.resize(3);  // Handles return their objects to the pool
+        std::cout << "After dropping 7 handles: live " << pool.liveCount()
+                  << ", high-water " << pool.getHighWater() << "\n";
+    }
+
+    // Freed slots are reused before any new slab is allocated
+    PlacementDemo* first = pool.construct(1);
+    pool.destroy(first);
+    PlacementDemo* second = pool.construct(2);
+    std::cout << "Slot reused after destroy: " << (first == second ? "yes" : "no")
+              << ", value " << second->getValue() << "\n";
+    pool.destroy(second);
+
+    // Cross-thread frees land on the lock-free remote stack
+    ObjectPool<PlacementDemo, PoolSync::CrossThreadFree> sharedPool;
+    std::vector<PlacementDemo*> objects;
+    for (int i = 0; i < 100; ++i) {
+        objects.push_back(sharedPool.construct(i));
+    }
+    std::thread releaser([&]() {
+        for (PlacementDemo* object : objects) {
+            sharedPool.destroy(object);
+        }
+    });
+    releaser.join();
+    std::cout << "After remote frees: live " << sharedPool.liveCount() << ", capacity "
+              << sharedPool.getCapacity() << "\n";
+    std::cout << "---\n\n";
+}
+
+// HeapObject-shaped payload: a header plus a pointer-sized field
+struct ChurnRecord {
+    long long id;
+    int* data;
+    size_t size;
+    double weight;
+
+    explicit ChurnRecord(long long i) : id(i), data(nullptr), size(0), weight(i * 0.5) {}
+};
+
+template<typename Make, typename Release>
+static double measureChurnNs(size_t ops, Make make, Release release) {
+    constexpr size_t WINDOW = 4096;
+    std::vector<decltype(make(0))> live(WINDOW);
+    uint32_t state = 2463534242u;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        auto& slot = live[state % WINDOW];
+        release(slot);
+        slot = make(static_cast<long long>(i));
+    }
+    for (auto& slot : live) {
+        release(slot);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / ops;
+}
+
+// Owner constructs a batch, another thread destroys it while the next one is built
+template<typename Make, typename Destroy>
+static double measureCrossThreadNs(size_t rounds, size_t batch, Make make, Destroy destroy) {
+    std::vector<ChurnRecord*> current(batch);
+    std::vector<ChurnRecord*> handedOff;
+    std::thread releaser;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < batch; ++i) {
+            current[i] = make(static_cast<long long>(i));
+        }
+        if (releaser.joinable()) {
+            releaser.join();
+        }
+        handedOff.swap(current);
+        current.resize(batch);
+        releaser = std::thread([&handedOff, &destroy]() {
+            for (ChurnRecord* record : handedOff) {
+                destroy(record);
+            }
+        });
+    }
+    releaser.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (rounds * batch);
+}
+
+void benchmarkObjectPool() {
+    std::cout << "11. Object Pool Benchmark:\n";
+    constexpr size_t OPS = 2000000;
+
+    std::cout << std::left << std::setw(40) << "Workload" << std::right << std::setw(10) << "ns/op" << "\n";
+    auto report = [](const char* label, double ns) {
+        std::cout << std::left << std::setw(40) << label << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(1) << ns << "\n";
+    };
+
+    report("make_unique<ChurnRecord> churn", measureChurnNs(OPS,
+        [](long long i) { return std::make_unique<ChurnRecord>(i); },
+        [](std::unique_ptr<ChurnRecord>& p) { p.reset(); }));
+
+    ObjectPool<ChurnRecord> pool;
+    report("ObjectPool<ChurnRecord>::make churn", measureChurnNs(OPS,
+        [&](long long i) { return pool.make(i); },
+        [](ObjectPool<ChurnRecord>::Handle& h) { h.reset(); }));
+
+    ObjectPool<ChurnRecord, PoolSync::CrossThreadFree> crossPool;
+    report("ObjectPool (CrossThreadFree) churn", measureChurnNs(OPS,
+        [&](long long i) { return crossPool.make(i); },
+        [](ObjectPool<ChurnRecord, PoolSync::CrossThreadFree>::Handle& h) { h.reset(); }));
+    std::cout << "Pool high-water " << pool.getHighWater() << " of capacity " << pool.getCapacity()
+              << " (" << pool.getSlabCount() << " slabs)\n";
+
+    constexpr size_t ROUNDS = 200;
+    constexpr size_t BATCH = 4096;
+    report("new + remote delete", measureCrossThreadNs(ROUNDS, BATCH,
+        [](long long i) { return new ChurnRecord(i); },
+        [](ChurnRecord* p) { delete p; }));
+    report("ObjectPool construct + remote destroy", measureCrossThreadNs(ROUNDS, BATCH,
+        [&](long long i) { return crossPool.construct(i); },
+        [&](ChurnRecord* p) { crossPool.destroy(p); }));
+    std::cout << "Cross-thread pool high-water " << crossPool.getHighWater() << ", live "
+              << crossPool.liveCount() << "\n";
+    std::cout << "---\n\n";
+}
+
+// PlacementDemo implementation
+PlacementDemo::PlacementDemo(int val) : value(val) {}
+
+PlacementDemo::~PlacementDemo() {}
+
+void PlacementDemo::display() const {
+    std::cout << "PlacementDemo value: " << value << "\n";
+}
+
+int PlacementDemo::getValue() const {
+    return value;
+}
+
+// SimpleAllocator implementation
+std::atomic<size_t> SimpleAllocator::bytesUsed{0};
+
+SizeClassAllocator& SimpleAllocator::backend() {
+    static SizeClassAllocator allocator;
+    return allocator;
+}
+
+void* SimpleAllocator::allocate(size_t size) {
+    char* block = static_cast<char*>(backend().allocate(size + HEADER_SIZE));
+    *reinterpret_cast<size_t*>(block) = size;
+    bytesUsed.fetch_add(size, std::memory_order_relaxed);
+    return block + HEADER_SIZE;
+}
+
+void SimpleAllocator::deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    char* block = static_cast<char*>(ptr) - HEADER_SIZE;
+    size_t size = *reinterpret_cast<size_t*>(block);
+    bytesUsed.fetch_sub(size, std::memory_order_relaxed);
+    backend().deallocate(block, size + HEADER_SIZE);
+}
+
+size_t SimpleAllocator::getBytesUsed() {
+    return bytesUsed.load(std::memory_order_relaxed);
+}
+
+// ObjectPool implementation
+template<typename T, PoolSync Sync>
+ObjectPool<T, Sync>::ObjectPool(size_t initialSlabObjects, size_t maxSlabObjects)
+    : nextSlabSize(std::max<size_t>(initialSlabObjects, 1)),
+      maxSlabSize(std::max(maxSlabObjects, nextSlabSize)),
+      owner(std::this_thread::get_id()) {}
+
+template<typename T, PoolSync Sync>
+ObjectPool<T, Sync>::~ObjectPool() {
+    for (auto& slab : slabs) {
+        ::operator delete(slab.first, std::align_val_t(SLAB_ALIGNMENT));
+    }
+}
+
+template<typename T, PoolSync Sync>
+void ObjectPool<T, Sync>::addSlab() {
+    const size_t count = nextSlabSize;
+    Slot* slab = static_cast<Slot*>(::operator new(count * sizeof(Slot), std::align_val_t(SLAB_ALIGNMENT)));
+    slabs.emplace_back(slab, count);
+    bumpCursor = slab;
+    bumpEnd = slab + count;
+    capacity += count;
+    nextSlabSize = std::min(maxSlabSize, nextSlabSize * 2);
+}
+
+template<typename T, PoolSync Sync>
+typename ObjectPool<T, Sync>::Slot* ObjectPool<T, Sync>::acquireSlot() {
+    if (freeList) {
+        Slot* slot = freeList;
+        freeList = slot->next;
+        return slot;
+    }
+    if constexpr (Sync == PoolSync::CrossThreadFree) {
+        // Take every remotely freed slot at once; exchange avoids ABA
+        Slot* remote = remoteFrees.exchange(nullptr, std::memory_order_acquire);
+        if (remote) {
+            freeList = remote->next;
+            return remote;
+        }
+    }
+    if (bumpCursor == bumpEnd) {
+        addSlab();
+    }
+    return bumpCursor++;
+}
+
+template<typename T, PoolSync Sync>
+void ObjectPool<T, Sync>::releaseSlot(Slot* slot) {
+    slot->next = freeList;
+    freeList = slot;
+}
+
+template<typename T, PoolSync Sync>
+template<typename... Args>
+T* ObjectPool<T, Sync>::construct(Args&&... args) {
+    Slot* slot = acquireSlot();
+    T* object;
+    try {
+        object = new (slot->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+        releaseSlot(slot);
+        throw;
+    }
+    ++localLive;
+    highWater = std::max(highWater, liveCount());
+    return object;
+}
+
+template<typename T, PoolSync Sync>
+template<typename... Args>
+typename ObjectPool<T, Sync>::Handle ObjectPool<T, Sync>::make(Args&&... args) {
+    return Handle(this, construct(std::forward<Args>(args)...));
+}
+
+template<typename T, PoolSync Sync>
+void ObjectPool<T, Sync>::destroy(T* object) {
+    if (!object) {
+        return;
+    }
+    object->~T();
+    Slot* slot = reinterpret_cast<Slot*>(object);
+
+    if constexpr (Sync == PoolSync::CrossThreadFree) {
+        if (std::this_thread::get_id() != owner) {
+            Slot* head = remoteFrees.load(std::memory_order_relaxed);
+            do {
+                slot->next = head;
+            } while (!remoteFrees.compare_exchange_weak(head, slot, std::memory_order_release,
+                                                        std::memory_order_relaxed));
+            remoteFreed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    releaseSlot(slot);
+    --localLive;
+}
+
+template<typename T, PoolSync Sync>
+size_t ObjectPool<T, Sync>::liveCount() const {
+    if constexpr (Sync == PoolSync::CrossThreadFree) {
+        return localLive - remoteFreed.load(std::memory_order_relaxed);
+    }
+    return localLive;
+}
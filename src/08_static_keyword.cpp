@@ -8,10 +8,21 @@
  * - Static initialization order
  * - Static storage duration
  * - Static in different contexts
+ * - Lazy, per-thread and timed static initialization
  */
 
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <new>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // TODO: Implement these examples demonstrating static keyword usage
@@ -59,10 +70,48 @@ public:
 // TODO: Define these in implementation
 
 // 3. Singleton pattern using static
+// Double-checked lazy holder. The fast path is one acquire load of the
+// pointer, pairing with the release store that publishes the finished
+// object, so a reader can never see it half-built. The constructor is
+// constexpr: a static LazyHolder is constant-initialized, with no guard
+// variable and no dynamic initializer of its own.
+template<typename T>
+class LazyHolder {
+private:
+    std::atomic<T*> instance{nullptr};
+    std::mutex initMutex;
+    alignas(T) unsigned char storage[sizeof(T)] = {};
+    
+    template<typename Factory>
+    T& initialize(Factory&& make);
+    
+public:
+    constexpr LazyHolder() noexcept {}
+    ~LazyHolder();
+    
+    LazyHolder(const LazyHolder&) = delete;
+    LazyHolder& operator=(const LazyHolder&) = delete;
+    
+    // make() runs once, on the first call; a throw leaves the holder empty
+    template<typename Factory>
+    T& get(Factory&& make) {
+        T* ptr = instance.load(std::memory_order_acquire);
+        return ptr ? *ptr : initialize(std::forward<Factory>(make));
+    }
+    T& get() {
+        return get([] { return T(); });
+    }
+    
+    bool isInitialized() const noexcept { return instance.load(std::memory_order_acquire) != nullptr; }
+    
+    // Destroys the object; only safe once no other thread can be using it
+    void reset() noexcept;
+};
+
 class Singleton {
 private:
-    static Singleton* instance;
-    static bool destroyed;
+    static LazyHolder<Singleton> holder;
+    friend class LazyHolder<Singleton>;
     
     int value;
     std::string data;
@@ -90,12 +139,54 @@ public:
 };
 
 // 4. Static initialization demonstration
+struct StaticInitRecord {
+    std::atomic<bool> complete;
+    const char* name;
+    int64_t startNs;     // Since the first recorded initializer started
+    int64_t durationNs;  // Includes any initializer it triggered
+    bool beforeMain;
+};
+
+// Times dynamic initializers: wrap one in StaticInitRegistry::timed(name,
+// init) and it is recorded in start order with its cost. The registry is
+// fixed-size and constant-initialized, so initializers in any translation
+// unit can record into it before main() without an init-order problem of
+// their own. Constant-initialized statics never show up: they cost nothing.
+class StaticInitRegistry {
+public:
+    static constexpr size_t Capacity = 64;
+    
+private:
+    static inline StaticInitRecord records[Capacity] = {};
+    static inline std::atomic<size_t> recordCount{0};
+    static inline std::atomic<int64_t> epochNs{0};      // Start of the first record; 0 until then
+    static inline std::atomic<int64_t> mainStartNs{0};
+    
+    static int64_t nowNs();
+    static int64_t sinceEpoch(int64_t ns);
+    
+public:
+    template<typename Init>
+    static auto timed(const char* name, Init&& init);
+    
+    // Call first thing in main(): later records count as lazy
+    static void markMainStarted();
+    static size_t size();
+    static void report(std::ostream& out);
+};
+
 class StaticInitOrder {
 private:
     static int staticVar1;
     static int staticVar2;
     static std::vector<int> staticVector;
     
+    // The same table twice: built before main() on every start, or on first use
+    static constexpr uint32_t PrimeLimit = 1u << 20;
+    static const std::vector<uint32_t> eagerPrimes;
+    static LazyHolder<std::vector<uint32_t>> lazyPrimes;
+    static std::vector<uint32_t> buildPrimeTable(uint32_t limit);
+    
 public:
     StaticInitOrder();
     
@@ -103,6 +194,8 @@ public:
     static void printStatics();
     static int getStaticVar1();
     static int getStaticVar2();
+    static const std::vector<uint32_t>& getEagerPrimes();
+    static const std::vector<uint32_t>& getLazyPrimes();
 };
 
 // 5. Static in namespaces
@@ -159,6 +252,31 @@ template<typename T>
 T StaticTemplate<T>::templateStaticValue = T{};
 
 // 8. Local static with threading implications
+// One T per thread, built on that thread's first get() and destroyed when
+// the thread exits. get() takes no lock and touches no shared memory; its
+// only check is the thread-local guard flag. The live count is updated
+// only when an instance is created or destroyed.
+template<typename T>
+class thread_local_singleton {
+private:
+    struct Slot {
+        T value;
+        Slot() { live.fetch_add(1, std::memory_order_relaxed); }
+        ~Slot() { live.fetch_sub(1, std::memory_order_relaxed); }
+    };
+    static inline std::atomic<size_t> live{0};
+    
+public:
+    thread_local_singleton() = delete;
+    
+    static T& get() {
+        thread_local Slot slot;
+        return slot.value;
+    }
+    
+    static size_t liveInstances() noexcept { return live.load(std::memory_order_relaxed); }
+};
+
 class ThreadSafeStatic {
 public:
     static int& getStaticCounter();
@@ -176,6 +294,10 @@ public:
     int getData() const;
 };
 
+struct ThreadStats {
+    uint64_t calls = 0;
+};
+
 // Function prototypes for demonstrations
 void demonstrateStaticFunctionVariables();
 void demonstrateStaticClassMembers();
@@ -186,8 +308,10 @@ void demonstrateStaticStorageDuration();
 void demonstrateStaticTemplates();
 void demonstrateThreadSafeStatics();
 void demonstrateStaticBestPractices();
+void benchmarkStaticAccess();
 
 int main() {
+    StaticInitRegistry::markMainStarted();
     std::cout << "=== Static Keyword Examples ===\n\n";
     
     // TODO: Call these functions to demonstrate concepts
@@ -293,6 +417,12 @@ void demonstrateStaticInitialization() {
     StaticInitOrder obj1;
     StaticInitOrder obj2;
     
+    // Behind a LazyHolder the table costs nothing at startup, only on first use
+    std::cout << "Eager prime table: " << StaticInitOrder::getEagerPrimes().size() << " primes\n";
+    std::cout << "Lazy prime table: " << StaticInitOrder::getLazyPrimes().size() << " primes\n";
+    std::cout << "Static initializer profile:\n";
+    StaticInitRegistry::report(std::cout);
+    
     std::cout << "---\n\n";
 }
 
@@ -362,6 +492,46 @@ void demonstrateThreadSafeStatics() {
     counter1++;
     std::cout << "Counter value: " << counter2 << "\n";
     
+    // Per-thread state: each thread counts into its own instance
+    std::vector<uint64_t> perThread(4);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < perThread.size(); ++t) {
+        workers.emplace_back([t, &perThread] {
+            for (size_t i = 0; i < (t + 1) * 1000; ++i) {
+                ++thread_local_singleton<ThreadStats>::get().calls;
+            }
+            perThread[t] = thread_local_singleton<ThreadStats>::get().calls;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::cout << "thread_local_singleton counts:";
+    for (uint64_t count : perThread) {
+        std::cout << " " << count;
+    }
+    std::cout << " (live instances after join: " << thread_local_singleton<ThreadStats>::liveInstances() << ")\n";
+    
+    // Racing first calls: exactly one thread runs the factory
+    LazyHolder<std::string> config;
+    std::atomic<int> constructions{0};
+    workers.clear();
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&config, &constructions] {
+            config.get([&constructions] {
+                constructions.fetch_add(1);
+                return std::string("loaded config");
+            });
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::cout << "LazyHolder raced by 4 threads: " << constructions.load() << " construction, value \""
+              << config.get() << "\"\n";
+    
+    benchmarkStaticAccess();
+    
     std::cout << "---\n\n";
 }
 
@@ -387,6 +557,60 @@ void demonstrateStaticBestPractices() {
     std::cout << "---\n\n";
 }
 
+static std::atomic<unsigned> staticAccessSink{0};
+
+// Wall time per access with every thread hammering the same accessor
+template<typename Access>
+static double measureAccessNs(size_t threads, size_t iterations, Access access) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([iterations, &access] {
+            unsigned sum = 0;
+            for (size_t i = 0; i < iterations; ++i) {
+                sum += static_cast<unsigned>(access());
+            }
+            staticAccessSink.fetch_add(sum, std::memory_order_relaxed);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(threads * iterations);
+}
+
+// Once initialized, the function-local static and LazyHolder both cost one
+// acquire load (a plain load on x86); thread_local_singleton needs no
+// shared load at all; a mutex makes every access a locked read-modify-write
+// on one shared cache line
+void benchmarkStaticAccess() {
+    constexpr size_t Iterations = 1000000;
+    LazyHolder<int> lazyValue;
+    lazyValue.get([] { return 42; });
+    std::mutex valueMutex;
+    int sharedValue = 42;
+    
+    std::cout << "Access cost after initialization (ns per call):\n";
+    std::cout << std::left << std::setw(30) << "accessor" << std::right << std::setw(12) << "1 thread"
+              << std::setw(12) << "4 threads" << "\n";
+    auto row = [](const char* name, auto access) {
+        double single = measureAccessNs(1, Iterations, access);
+        double contended = measureAccessNs(4, Iterations, access);
+        std::cout << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << single << std::setw(12) << contended << "\n" << std::defaultfloat;
+    };
+    row("function-local static", [] { return ThreadSafeStatic::getInstance().getData(); });
+    row("LazyHolder::get", [&lazyValue] { return lazyValue.get([] { return 42; }); });
+    row("thread_local_singleton::get", [] {
+        return static_cast<unsigned>(++thread_local_singleton<ThreadStats>::get().calls);
+    });
+    row("mutex-guarded pointer", [&valueMutex, &sharedValue] {
+        std::lock_guard<std::mutex> lock(valueMutex);
+        return sharedValue;
+    });
+}
+
 // TODO: Implement all function definitions and static member definitions
 
 // Function implementations
@@ -400,4 +624,228 @@ int staticCounter() {
     return ++count;
 }
 
+// LazyHolder implementation
+template<typename T>
+template<typename Factory>
+T& LazyHolder<T>::initialize(Factory&& make) {
+    std::lock_guard<std::mutex> lock(initMutex);
+    // Another thread may have finished while this one waited for the lock
+    T* ptr = instance.load(std::memory_order_relaxed);
+    if (!ptr) {
+        ptr = ::new (static_cast<void*>(storage)) T(std::forward<Factory>(make)());
+        instance.store(ptr, std::memory_order_release);
+    }
+    return *ptr;
+}
+
+template<typename T>
+LazyHolder<T>::~LazyHolder() {
+    reset();
+}
+
+template<typename T>
+void LazyHolder<T>::reset() noexcept {
+    std::lock_guard<std::mutex> lock(initMutex);
+    T* ptr = instance.load(std::memory_order_relaxed);
+    if (ptr) {
+        instance.store(nullptr, std::memory_order_release);
+        ptr->~T();
+    }
+}
+
+// Singleton implementation
+// Constant-initialized: no guard variable, nothing runs before main()
+LazyHolder<Singleton> Singleton::holder;
+
+Singleton::Singleton(int val, const std::string& str) : value(val), data(str) {
+    std::cout << "Singleton instance created\n";
+}
+
+Singleton::~Singleton() {
+    std::cout << "Singleton instance destroyed\n";
+}
+
+Singleton& Singleton::getInstance() {
+    return holder.get([] { return Singleton(); });
+}
+
+void Singleton::destroyInstance() {
+    holder.reset();
+}
+
+void Singleton::setValue(int val) {
+    value = val;
+}
+
+int Singleton::getValue() const {
+    return value;
+}
+
+void Singleton::setData(const std::string& str) {
+    data = str;
+}
+
+const std::string& Singleton::getData() const {
+    return data;
+}
+
+void Singleton::printInfo() const {
+    std::cout << "Value: " << value << ", Data: " << data << "\n";
+}
+
+// StaticInitRegistry implementation
+int64_t StaticInitRegistry::nowNs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+int64_t StaticInitRegistry::sinceEpoch(int64_t ns) {
+    return ns - epochNs.load(std::memory_order_relaxed);
+}
+
+template<typename Init>
+auto StaticInitRegistry::timed(const char* name, Init&& init) {
+    int64_t start = nowNs();
+    int64_t unset = 0;
+    epochNs.compare_exchange_strong(unset, start);
+    // The slot is taken before init() runs, so an initializer it triggers
+    // is listed after it
+    size_t slot = recordCount.fetch_add(1);
+    auto value = std::forward<Init>(init)();
+    if (slot < Capacity) {
+        StaticInitRecord& record = records[slot];
+        record.name = name;
+        record.startNs = sinceEpoch(start);
+        record.durationNs = nowNs() - start;
+        record.beforeMain = mainStartNs.load(std::memory_order_relaxed) == 0;
+        record.complete.store(true, std::memory_order_release);
+    }
+    return value;
+}
+
+void StaticInitRegistry::markMainStarted() {
+    int64_t now = nowNs();
+    int64_t unset = 0;
+    epochNs.compare_exchange_strong(unset, now);
+    mainStartNs.store(now, std::memory_order_relaxed);
+}
+
+size_t StaticInitRegistry::size() {
+    return std::min(recordCount.load(std::memory_order_acquire), Capacity);
+}
+
+void StaticInitRegistry::report(std::ostream& out) {
+    out << std::setw(6) << "order" << "  " << std::left << std::setw(32) << "initializer" << std::right
+        << std::setw(12) << "start us" << std::setw(12) << "cost us" << "  phase\n";
+    size_t count = size();
+    for (size_t i = 0; i < count; ++i) {
+        const StaticInitRecord& record = records[i];
+        if (!record.complete.load(std::memory_order_acquire)) {
+            out << std::setw(6) << i << "  (running, or threw)\n";
+            continue;
+        }
+        out << std::setw(6) << i << "  " << std::left << std::setw(32) << record.name << std::right << std::fixed
+            << std::setprecision(1) << std::setw(12) << record.startNs / 1e3 << std::setw(12)
+            << record.durationNs / 1e3 << "  " << (record.beforeMain ? "before main" : "lazy") << "\n"
+            << std::defaultfloat;
+    }
+    size_t recorded = recordCount.load(std::memory_order_acquire);
+    if (recorded > Capacity) {
+        out << "(" << recorded - Capacity << " initializers not recorded: registry full)\n";
+    }
+    int64_t mainStart = mainStartNs.load(std::memory_order_relaxed);
+    if (mainStart != 0) {
+        out << "main() entered " << std::fixed << std::setprecision(1) << sinceEpoch(mainStart) / 1e3
+            << " us after the first initializer started\n" << std::defaultfloat;
+    }
+}
+
+// StaticInitOrder implementation
+// Constant-initialized, so they never run code and never show up in the
+// registry
+int StaticInitOrder::staticVar1 = 0;
+int StaticInitOrder::staticVar2 = 0;
+
+// Dynamic initializers run in definition order within this file
+std::vector<int> StaticInitOrder::staticVector =
+    StaticInitRegistry::timed("StaticInitOrder::staticVector", [] { return std::vector<int>{1, 2, 3}; });
+
+const std::vector<uint32_t> StaticInitOrder::eagerPrimes =
+    StaticInitRegistry::timed("StaticInitOrder::eagerPrimes", [] { return buildPrimeTable(PrimeLimit); });
+
+LazyHolder<std::vector<uint32_t>> StaticInitOrder::lazyPrimes;
+
+std::vector<uint32_t> StaticInitOrder::buildPrimeTable(uint32_t limit) {
+    std::vector<bool> composite(limit + 1, false);
+    std::vector<uint32_t> primes;
+    for (uint32_t n = 2; n <= limit; ++n) {
+        if (composite[n]) {
+            continue;
+        }
+        primes.push_back(n);
+        for (uint64_t multiple = uint64_t(n) * n; multiple <= limit; multiple += n) {
+            composite[multiple] = true;
+        }
+    }
+    return primes;
+}
+
+StaticInitOrder::StaticInitOrder() {
+    std::cout << "StaticInitOrder instance created (staticVar1 = " << staticVar1 << ")\n";
+}
+
+void StaticInitOrder::initializeStatics() {
+    staticVar1 = 10;
+    staticVar2 = staticVar1 * 2;
+    staticVector.push_back(4);
+}
+
+void StaticInitOrder::printStatics() {
+    std::cout << "staticVar1 = " << staticVar1 << ", staticVar2 = " << staticVar2 << ", staticVector size = "
+              << staticVector.size() << "\n";
+}
+
+int StaticInitOrder::getStaticVar1() {
+    return staticVar1;
+}
+
+int StaticInitOrder::getStaticVar2() {
+    return staticVar2;
+}
+
+const std::vector<uint32_t>& StaticInitOrder::getEagerPrimes() {
+    return eagerPrimes;
+}
+
+const std::vector<uint32_t>& StaticInitOrder::getLazyPrimes() {
+    return lazyPrimes.get(
+        [] { return StaticInitRegistry::timed("StaticInitOrder::lazyPrimes", [] { return buildPrimeTable(PrimeLimit); }); });
+}
+
+// ThreadSafeStatic implementation
+int& ThreadSafeStatic::getStaticCounter() {
+    static int counter = 0;
+    return counter;
+}
+
+std::string& ThreadSafeStatic::getStaticString() {
+    static std::string str = "Thread-safe static string";
+    return str;
+}
+
+// The compiler guards the first call with a lock; later calls only load
+// the guard byte
+ThreadSafeStatic& ThreadSafeStatic::getInstance() {
+    static ThreadSafeStatic instance;
+    return instance;
+}
+
+void ThreadSafeStatic::processData() {
+    ++data;
+}
+
+int ThreadSafeStatic::getData() const {
+    return data;
+}
+
 // TODO: Implement remaining class methods and static member definitions...
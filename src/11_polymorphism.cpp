@@ -13,6 +13,17 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 // TODO: Implement these classes
 
@@ -42,6 +53,8 @@ private:
 public:
     Rectangle(double w, double h);
     
+    double getWidth() const { return width; }
+    double getHeight() const { return height; }
     double area() const override;
     double perimeter() const override;
     void draw() const override;
@@ -55,6 +68,7 @@ private:
 public:
     Circle(double r);
     
+    double getRadius() const { return radius; }
     double area() const override;
     double perimeter() const override;
     void draw() const override;
@@ -67,6 +81,9 @@ private:
 public:
     Triangle(double s1, double s2, double s3);
     
+    double getSide1() const { return side1; }
+    double getSide2() const { return side2; }
+    double getSide3() const { return side3; }
     double area() const override;
     double perimeter() const override;
     void draw() const override;
@@ -161,6 +178,65 @@ public:
     void derivedSpecific() const;
 };
 
+// 5. Data-Oriented Shape Batch (Structure of Arrays)
+// Shapes are grouped by kind and each dimension lives in its own contiguous
+// column, so areas/perimeters are computed in bulk by SIMD kernels with no
+// per-object allocation or virtual call. A ShapeHandle names one shape;
+// view() wraps it in a Shape so code written against the virtual API still
+// works on batch members.
+enum class ShapeKind : uint8_t { Rectangle, Circle, Triangle };
+
+struct ShapeHandle {
+    ShapeKind kind;
+    uint32_t index;  // Row within the kind's columns
+};
+
+class ShapeBatch {
+public:
+    enum class Kernel { Scalar, SSE2, AVX };
+    static Kernel bestKernel();
+    static const char* kernelName(Kernel kernel);
+
+    // Shape facade over one batch row; valid while the batch is alive
+    class View : public Shape {
+    private:
+        const ShapeBatch* batch;
+        ShapeHandle handle;
+
+    public:
+        View(const ShapeBatch& owner, ShapeHandle h);
+
+        double area() const override;
+        double perimeter() const override;
+        void draw() const override;
+    };
+
+private:
+    std::vector<double> rectWidths, rectHeights;
+    std::vector<double> circleRadii;
+    std::vector<double> triSides1, triSides2, triSides3;
+    
+public:
+    ShapeHandle addRectangle(double w, double h);
+    ShapeHandle addCircle(double r);
+    ShapeHandle addTriangle(double s1, double s2, double s3);
+    ShapeHandle add(const Shape& shape);  // Copies the dimensions of a known shape type
+    void reserve(size_t rectangles, size_t circles, size_t triangles);
+
+    size_t size() const;
+    size_t count(ShapeKind kind) const;
+
+    // Results are laid out rectangles, then circles, then triangles
+    size_t position(ShapeHandle handle) const;
+    void computeMetrics(std::vector<double>& areas, std::vector<double>& perimeters,
+                        Kernel kernel = bestKernel()) const;
+
+    double area(ShapeHandle handle) const;
+    double perimeter(ShapeHandle handle) const;
+    View view(ShapeHandle handle) const { return View(*this, handle); }
+    std::unique_ptr<Shape> materialize(ShapeHandle handle) const;  // Standalone heap copy
+};
+
 // Function prototypes for demonstrations
 void demonstrateAbstractClasses();
 void demonstrateCompileTimePolymorphism();
@@ -169,6 +245,8 @@ void demonstrateVirtualDestructor();
 void demonstratePolymorphicContainers();
 void demonstrateDynamicBinding();
 void demonstrateOverridingVsOverloading();
+void demonstrateShapeBatch();
+void benchmarkShapeProcessing();
 
 int main() {
     std::cout << "=== Polymorphism Examples ===\n\n";
@@ -181,6 +259,8 @@ int main() {
     demonstratePolymorphicContainers();
     demonstrateDynamicBinding();
     demonstrateOverridingVsOverloading();
+    demonstrateShapeBatch();
+    benchmarkShapeProcessing();
     
     return 0;
 }
@@ -244,6 +324,158 @@ void demonstrateOverridingVsOverloading() {
     std::cout << "---\n\n";
 }
 
+void demonstrateShapeBatch() {
+    std::cout << "8. Data-Oriented Shape Batch:\n";
+
+    ShapeBatch batch;
+    ShapeHandle rect = batch.addRectangle(3.0, 4.0);
+    ShapeHandle circle = batch.addCircle(1.0);
+    ShapeHandle triangle = batch.addTriangle(3.0, 4.0, 5.0);
+    batch.add(Rectangle(2.0, 5.0));  // Imported from the virtual API
+
+    std::vector<double> areas, perimeters;
+    batch.computeMetrics(areas, perimeters);
+    std::cout << "Batch of " << batch.size() << " shapes, kernel "
+              << ShapeBatch::kernelName(ShapeBatch::bestKernel()) << "\n";
+    for (ShapeHandle h : {rect, circle, triangle}) {
+        size_t pos = batch.position(h);
+        std::cout << "  row " << pos << ": area " << areas[pos] << ", perimeter " << perimeters[pos] << "\n";
+    }
+
+    // A View is a Shape, so virtual-API code works on batch rows
+    ShapeBatch::View view = batch.view(triangle);
+    const Shape& asShape = view;
+    asShape.displayInfo();
+    std::unique_ptr<Shape> standalone = batch.materialize(circle);
+    standalone->draw();
+    std::cout << "---\n\n";
+}
+
+// Value types for the std::variant comparison: same formulas, no vtable
+struct RectangleValue {
+    double width, height;
+    double area() const { return width * height; }
+    double perimeter() const { return 2 * (width + height); }
+};
+
+struct CircleValue {
+    double radius;
+    double area() const { return M_PI * radius * radius; }
+    double perimeter() const { return 2 * M_PI * radius; }
+};
+
+struct TriangleValue {
+    double side1, side2, side3;
+    double area() const {
+        double s = (side1 + side2 + side3) / 2;
+        return std::sqrt(s * (s - side1) * (s - side2) * (s - side3));
+    }
+    double perimeter() const { return side1 + side2 + side3; }
+};
+
+using ShapeValue = std::variant<RectangleValue, CircleValue, TriangleValue>;
+
+static volatile double shapeChecksumSink = 0;
+
+template<typename Frame>
+static double measureFrameNs(size_t shapes, int frames, Frame frame) {
+    double checksum = frame();  // Warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        checksum += frame();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    shapeChecksumSink = checksum;  // Keeps the work observable
+    return ns / (static_cast<double>(shapes) * frames);
+}
+
+void benchmarkShapeProcessing() {
+    std::cout << "9. Shape Processing Benchmark:\n";
+    constexpr size_t SHAPES = 1000000;
+    constexpr int FRAMES = 10;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dim(1.0, 10.0);
+    std::uniform_int_distribution<int> pick(0, 2);
+
+    std::vector<std::unique_ptr<Shape>> objects;
+    std::vector<ShapeValue> values;
+    ShapeBatch batch;
+    objects.reserve(SHAPES);
+    values.reserve(SHAPES);
+    for (size_t i = 0; i < SHAPES; ++i) {
+        switch (pick(rng)) {
+            case 0: {
+                double w = dim(rng), h = dim(rng);
+                objects.push_back(std::make_unique<Rectangle>(w, h));
+                values.push_back(RectangleValue{w, h});
+                batch.addRectangle(w, h);
+                break;
+            }
+            case 1: {
+                double r = dim(rng);
+                objects.push_back(std::make_unique<Circle>(r));
+                values.push_back(CircleValue{r});
+                batch.addCircle(r);
+                break;
+            }
+            default: {
+                // Two random sides and a third that always closes the triangle
+                double a = dim(rng), b = dim(rng);
+                double c = std::abs(a - b) + (a + b - std::abs(a - b)) * 0.5;
+                objects.push_back(std::make_unique<Triangle>(a, b, c));
+                values.push_back(TriangleValue{a, b, c});
+                batch.addTriangle(a, b, c);
+                break;
+            }
+        }
+    }
+
+    std::cout << SHAPES << " mixed shapes, area + perimeter per shape, " << FRAMES << " frames\n";
+    std::cout << std::left << std::setw(36) << "Layout" << std::right << std::setw(12) << "ns/shape" << "\n";
+    auto report = [](const std::string& label, double ns) {
+        std::cout << std::left << std::setw(36) << label << std::right << std::setw(12)
+                  << std::fixed << std::setprecision(2) << ns << "\n";
+    };
+
+    report("vector<unique_ptr<Shape>> virtual", measureFrameNs(SHAPES, FRAMES, [&]() {
+        double sum = 0;
+        for (const auto& shape : objects) {
+            sum += shape->area() + shape->perimeter();
+        }
+        return sum;
+    }));
+
+    report("vector<variant> + visit", measureFrameNs(SHAPES, FRAMES, [&]() {
+        double sum = 0;
+        for (const auto& value : values) {
+            sum += std::visit([](const auto& shape) { return shape.area() + shape.perimeter(); }, value);
+        }
+        return sum;
+    }));
+
+    std::vector<double> areas, perimeters;
+    std::vector<ShapeBatch::Kernel> kernels = {ShapeBatch::Kernel::Scalar};
+    if (ShapeBatch::bestKernel() != ShapeBatch::Kernel::Scalar) {
+        kernels.push_back(ShapeBatch::Kernel::SSE2);
+    }
+    if (ShapeBatch::bestKernel() == ShapeBatch::Kernel::AVX) {
+        kernels.push_back(ShapeBatch::Kernel::AVX);
+    }
+    for (ShapeBatch::Kernel kernel : kernels) {
+        report(std::string("ShapeBatch SoA (") + ShapeBatch::kernelName(kernel) + ")",
+               measureFrameNs(SHAPES, FRAMES, [&]() {
+                   batch.computeMetrics(areas, perimeters, kernel);
+                   double sum = 0;
+                   for (size_t i = 0; i < areas.size(); ++i) {
+                       sum += areas[i] + perimeters[i];
+                   }
+                   return sum;
+               }));
+    }
+    std::cout << "---\n\n";
+}
+
 // TODO: Implement all the class methods
 Shape::Shape(const std::string& name) : name(name) {}
 
@@ -275,4 +507,320 @@ void Rectangle::displayInfo() const {
               << ", Area: " << area() << ", Perimeter: " << perimeter() << "\n";
 }
 
-// TODO: Continue implementing other classes...
+Circle::Circle(double r) : Shape("Circle"), radius(r) {}
+
+double Circle::area() const {
+    return M_PI * radius * radius;
+}
+
+double Circle::perimeter() const {
+    return 2 * M_PI * radius;
+}
+
+void Circle::draw() const {
+    std::cout << "Drawing a circle with radius " << radius << "\n";
+}
+
+Triangle::Triangle(double s1, double s2, double s3) : Shape("Triangle"), side1(s1), side2(s2), side3(s3) {}
+
+// Heron's formula
+double Triangle::area() const {
+    double s = (side1 + side2 + side3) / 2;
+    return std::sqrt(s * (s - side1) * (s - side2) * (s - side3));
+}
+
+double Triangle::perimeter() const {
+    return side1 + side2 + side3;
+}
+
+void Triangle::draw() const {
+    std::cout << "Drawing a triangle " << side1 << ", " << side2 << ", " << side3 << "\n";
+}
+
+// ShapeBatch implementation
+// Kernels fill area[i] and perimeter[i] for n rows of one shape kind
+static void rectangleKernelScalar(const double* w, const double* h, double* area, double* perim, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        area[i] = w[i] * h[i];
+        perim[i] = 2 * (w[i] + h[i]);
+    }
+}
+
+static void circleKernelScalar(const double* r, double* area, double* perim, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        area[i] = M_PI * r[i] * r[i];
+        perim[i] = 2 * M_PI * r[i];
+    }
+}
+
+static void triangleKernelScalar(const double* a, const double* b, const double* c,
+                                 double* area, double* perim, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        double p = a[i] + b[i] + c[i];
+        double s = p / 2;
+        area[i] = std::sqrt(s * (s - a[i]) * (s - b[i]) * (s - c[i]));
+        perim[i] = p;
+    }
+}
+
+#if defined(__SSE2__)
+static void rectangleKernelSSE2(const double* w, const double* h, double* area, double* perim, size_t n) {
+    const __m128d two = _mm_set1_pd(2.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d vw = _mm_loadu_pd(w + i);
+        __m128d vh = _mm_loadu_pd(h + i);
+        _mm_storeu_pd(area + i, _mm_mul_pd(vw, vh));
+        _mm_storeu_pd(perim + i, _mm_mul_pd(two, _mm_add_pd(vw, vh)));
+    }
+    rectangleKernelScalar(w + i, h + i, area + i, perim + i, n - i);
+}
+
+static void circleKernelSSE2(const double* r, double* area, double* perim, size_t n) {
+    const __m128d pi = _mm_set1_pd(M_PI);
+    const __m128d twoPi = _mm_set1_pd(2 * M_PI);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d vr = _mm_loadu_pd(r + i);
+        _mm_storeu_pd(area + i, _mm_mul_pd(pi, _mm_mul_pd(vr, vr)));
+        _mm_storeu_pd(perim + i, _mm_mul_pd(twoPi, vr));
+    }
+    circleKernelScalar(r + i, area + i, perim + i, n - i);
+}
+
+static void triangleKernelSSE2(const double* a, const double* b, const double* c,
+                               double* area, double* perim, size_t n) {
+    const __m128d half = _mm_set1_pd(0.5);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d va = _mm_loadu_pd(a + i);
+        __m128d vb = _mm_loadu_pd(b + i);
+        __m128d vc = _mm_loadu_pd(c + i);
+        __m128d p = _mm_add_pd(_mm_add_pd(va, vb), vc);
+        __m128d s = _mm_mul_pd(p, half);
+        __m128d prod = _mm_mul_pd(_mm_mul_pd(s, _mm_sub_pd(s, va)),
+                                  _mm_mul_pd(_mm_sub_pd(s, vb), _mm_sub_pd(s, vc)));
+        _mm_storeu_pd(area + i, _mm_sqrt_pd(prod));
+        _mm_storeu_pd(perim + i, p);
+    }
+    triangleKernelScalar(a + i, b + i, c + i, area + i, perim + i, n - i);
+}
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHAPE_BATCH_HAVE_AVX_KERNEL 1
+// Compiled for AVX regardless of -march; only called when the CPU reports AVX
+__attribute__((target("avx")))
+static void rectangleKernelAVX(const double* w, const double* h, double* area, double* perim, size_t n) {
+    const __m256d two = _mm256_set1_pd(2.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vw = _mm256_loadu_pd(w + i);
+        __m256d vh = _mm256_loadu_pd(h + i);
+        _mm256_storeu_pd(area + i, _mm256_mul_pd(vw, vh));
+        _mm256_storeu_pd(perim + i, _mm256_mul_pd(two, _mm256_add_pd(vw, vh)));
+    }
+    rectangleKernelScalar(w + i, h + i, area + i, perim + i, n - i);
+}
+
+__attribute__((target("avx")))
+static void circleKernelAVX(const double* r, double* area, double* perim, size_t n) {
+    const __m256d pi = _mm256_set1_pd(M_PI);
+    const __m256d twoPi = _mm256_set1_pd(2 * M_PI);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vr = _mm256_loadu_pd(r + i);
+        _mm256_storeu_pd(area + i, _mm256_mul_pd(pi, _mm256_mul_pd(vr, vr)));
+        _mm256_storeu_pd(perim + i, _mm256_mul_pd(twoPi, vr));
+    }
+    circleKernelScalar(r + i, area + i, perim + i, n - i);
+}
+
+__attribute__((target("avx")))
+static void triangleKernelAVX(const double* a, const double* b, const double* c,
+                              double* area, double* perim, size_t n) {
+    const __m256d half = _mm256_set1_pd(0.5);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d vb = _mm256_loadu_pd(b + i);
+        __m256d vc = _mm256_loadu_pd(c + i);
+        __m256d p = _mm256_add_pd(_mm256_add_pd(va, vb), vc);
+        __m256d s = _mm256_mul_pd(p, half);
+        __m256d prod = _mm256_mul_pd(_mm256_mul_pd(s, _mm256_sub_pd(s, va)),
+                                     _mm256_mul_pd(_mm256_sub_pd(s, vb), _mm256_sub_pd(s, vc)));
+        _mm256_storeu_pd(area + i, _mm256_sqrt_pd(prod));
+        _mm256_storeu_pd(perim + i, p);
+    }
+    triangleKernelScalar(a + i, b + i, c + i, area + i, perim + i, n - i);
+}
+#endif
+
+ShapeBatch::Kernel ShapeBatch::bestKernel() {
+#if defined(SHAPE_BATCH_HAVE_AVX_KERNEL)
+    static const bool hasAVX = __builtin_cpu_supports("avx");
+    if (hasAVX) {
+        return Kernel::AVX;
+    }
+#endif
+#if defined(__SSE2__)
+    return Kernel::SSE2;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+const char* ShapeBatch::kernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::SSE2: return "SSE2";
+        case Kernel::AVX: return "AVX";
+        default: return "scalar";
+    }
+}
+
+ShapeBatch::View::View(const ShapeBatch& owner, ShapeHandle h)
+    : Shape(h.kind == ShapeKind::Rectangle ? "Rectangle" : h.kind == ShapeKind::Circle ? "Circle" : "Triangle"),
+      batch(&owner), handle(h) {}
+
+double ShapeBatch::View::area() const {
+    return batch->area(handle);
+}
+
+double ShapeBatch::View::perimeter() const {
+    return batch->perimeter(handle);
+}
+
+void ShapeBatch::View::draw() const {
+    batch->materialize(handle)->draw();
+}
+
+ShapeHandle ShapeBatch::addRectangle(double w, double h) {
+    rectWidths.push_back(w);
+    rectHeights.push_back(h);
+    return {ShapeKind::Rectangle, static_cast<uint32_t>(rectWidths.size() - 1)};
+}
+
+ShapeHandle ShapeBatch::addCircle(double r) {
+    circleRadii.push_back(r);
+    return {ShapeKind::Circle, static_cast<uint32_t>(circleRadii.size() - 1)};
+}
+
+ShapeHandle ShapeBatch::addTriangle(double s1, double s2, double s3) {
+    triSides1.push_back(s1);
+    triSides2.push_back(s2);
+    triSides3.push_back(s3);
+    return {ShapeKind::Triangle, static_cast<uint32_t>(triSides1.size() - 1)};
+}
+
+ShapeHandle ShapeBatch::add(const Shape& shape) {
+    if (auto* rect = dynamic_cast<const Rectangle*>(&shape)) {
+        return addRectangle(rect->getWidth(), rect->getHeight());
+    }
+    if (auto* circle = dynamic_cast<const Circle*>(&shape)) {
+        return addCircle(circle->getRadius());
+    }
+    if (auto* triangle = dynamic_cast<const Triangle*>(&shape)) {
+        return addTriangle(triangle->getSide1(), triangle->getSide2(), triangle->getSide3());
+    }
+    throw std::invalid_argument("ShapeBatch::add: unsupported shape type " + shape.getName());
+}
+
+void ShapeBatch::reserve(size_t rectangles, size_t circles, size_t triangles) {
+    rectWidths.reserve(rectangles);
+    rectHeights.reserve(rectangles);
+    circleRadii.reserve(circles);
+    triSides1.reserve(triangles);
+    triSides2.reserve(triangles);
+    triSides3.reserve(triangles);
+}
+
+size_t ShapeBatch::size() const {
+    return rectWidths.size() + circleRadii.size() + triSides1.size();
+}
+
+size_t ShapeBatch::count(ShapeKind kind) const {
+    switch (kind) {
+        case ShapeKind::Rectangle: return rectWidths.size();
+        case ShapeKind::Circle: return circleRadii.size();
+        default: return triSides1.size();
+    }
+}
+
+size_t ShapeBatch::position(ShapeHandle handle) const {
+    switch (handle.kind) {
+        case ShapeKind::Rectangle: return handle.index;
+        case ShapeKind::Circle: return rectWidths.size() + handle.index;
+        default: return rectWidths.size() + circleRadii.size() + handle.index;
+    }
+}
+
+void ShapeBatch::computeMetrics(std::vector<double>& areas, std::vector<double>& perimeters, Kernel kernel) const {
+    areas.resize(size());
+    perimeters.resize(size());
+    const size_t rects = rectWidths.size();
+    const size_t circles = circleRadii.size();
+    const size_t triangles = triSides1.size();
+    double* area = areas.data();
+    double* perim = perimeters.data();
+
+    switch (kernel) {
+#if defined(SHAPE_BATCH_HAVE_AVX_KERNEL)
+        case Kernel::AVX:
+            rectangleKernelAVX(rectWidths.data(), rectHeights.data(), area, perim, rects);
+            circleKernelAVX(circleRadii.data(), area + rects, perim + rects, circles);
+            triangleKernelAVX(triSides1.data(), triSides2.data(), triSides3.data(),
+                              area + rects + circles, perim + rects + circles, triangles);
+            return;
+#endif
+#if defined(__SSE2__)
+        case Kernel::SSE2:
+            rectangleKernelSSE2(rectWidths.data(), rectHeights.data(), area, perim, rects);
+            circleKernelSSE2(circleRadii.data(), area + rects, perim + rects, circles);
+            triangleKernelSSE2(triSides1.data(), triSides2.data(), triSides3.data(),
+                               area + rects + circles, perim + rects + circles, triangles);
+            return;
+#endif
+        default:
+            rectangleKernelScalar(rectWidths.data(), rectHeights.data(), area, perim, rects);
+            circleKernelScalar(circleRadii.data(), area + rects, perim + rects, circles);
+            triangleKernelScalar(triSides1.data(), triSides2.data(), triSides3.data(),
+                                 area + rects + circles, perim + rects + circles, triangles);
+            return;
+    }
+}
+
+double ShapeBatch::area(ShapeHandle handle) const {
+    double a = 0, p = 0;
+    const uint32_t i = handle.index;
+    switch (handle.kind) {
+        case ShapeKind::Rectangle:
+            rectangleKernelScalar(&rectWidths[i], &rectHeights[i], &a, &p, 1);
+            break;
+        case ShapeKind::Circle:
+            circleKernelScalar(&circleRadii[i], &a, &p, 1);
+            break;
+        case ShapeKind::Triangle:
+            triangleKernelScalar(&triSides1[i], &triSides2[i], &triSides3[i], &a, &p, 1);
+            break;
+    }
+    return a;
+}
+
+double ShapeBatch::perimeter(ShapeHandle handle) const {
+    const uint32_t i = handle.index;
+    switch (handle.kind) {
+        case ShapeKind::Rectangle: return 2 * (rectWidths[i] + rectHeights[i]);
+        case ShapeKind::Circle: return 2 * M_PI * circleRadii[i];
+        default: return triSides1[i] + triSides2[i] + triSides3[i];
+    }
+}
+
+std::unique_ptr<Shape> ShapeBatch::materialize(ShapeHandle handle) const {
+    const uint32_t i = handle.index;
+    switch (handle.kind) {
+        case ShapeKind::Rectangle: return std::make_unique<Rectangle>(rectWidths[i], rectHeights[i]);
+        case ShapeKind::Circle: return std::make_unique<Circle>(circleRadii[i]);
+        default: return std::make_unique<Triangle>(triSides1[i], triSides2[i], triSides3[i]);
+    }
+}
+
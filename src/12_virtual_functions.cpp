@@ -12,6 +12,19 @@
 
 #include <iostream>
 #include <memory>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <new>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
 
 // TODO: Implement these classes and functions
 
@@ -109,12 +122,121 @@ public:
     // void finalMethod() override;
 };
 
+// 5. Static Polymorphism
+// final lets the compiler devirtualize: a call through a SealedRectangle&
+// can only reach SealedRectangle::area, so it is inlined like a normal call
+class SealedRectangle final : public Shape {
+private:
+    double width, height;
+public:
+    SealedRectangle(double w, double h) : width(w), height(h) {}
+    double area() const override { return width * height; }
+    void draw() const override;
+};
+
+class SealedCircle final : public Shape {
+private:
+    double radius;
+public:
+    explicit SealedCircle(double r) : radius(r) {}
+    double area() const override { return M_PI * radius * radius; }
+    void draw() const override;
+};
+
+// CRTP base mirroring the Shape interface: calls resolve at compile time,
+// there is no vtable pointer and no virtual call
+template<typename Derived>
+class ShapeBase {
+public:
+    double area() const { return self().areaImpl(); }
+    void draw() const { self().drawImpl(); }
+
+protected:
+    ShapeBase() = default;
+    ~ShapeBase() = default;  // Not deletable through the base; not a polymorphic type
+
+private:
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+class CrtpRectangle : public ShapeBase<CrtpRectangle> {
+private:
+    double width, height;
+public:
+    CrtpRectangle(double w, double h) : width(w), height(h) {}
+    double areaImpl() const { return width * height; }
+    void drawImpl() const;
+};
+
+class CrtpCircle : public ShapeBase<CrtpCircle> {
+private:
+    double radius;
+public:
+    explicit CrtpCircle(double r) : radius(r) {}
+    double areaImpl() const { return M_PI * radius * radius; }
+    void drawImpl() const;
+};
+
+// Heterogeneous container that stores each element inline in a slot sized
+// for the largest of Ts, plus a one-byte type tag. for_each/visit dispatch
+// on the tag through a fold over the type list, which the compiler lowers to
+// a compare chain or jump table with every target inlined.
+template<typename... Ts>
+class poly_vector {
+    static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) < 256, "poly_vector needs 1-255 types");
+
+private:
+    struct alignas(Ts...) Slot {
+        unsigned char bytes[std::max({sizeof(Ts)...})];
+    };
+
+    Slot* slots = nullptr;
+    uint8_t* tags = nullptr;
+    size_t count = 0;
+    size_t capacity = 0;
+
+    template<typename T, size_t I = 0>
+    static constexpr uint8_t tagOf();
+
+    template<typename F, size_t... Is>
+    static void dispatch(uint8_t tag, void* slot, F& f, std::index_sequence<Is...>);
+
+    void grow();
+    void destroyAll();
+    
+public:
+    poly_vector() = default;
+    ~poly_vector();
+
+    poly_vector(const poly_vector&) = delete;
+    poly_vector& operator=(const poly_vector&) = delete;
+    poly_vector(poly_vector&& other) noexcept;
+    poly_vector& operator=(poly_vector&& other) noexcept;
+
+    template<typename T, typename... Args>
+    T& emplace_back(Args&&... args);
+
+    // f is called as f(element) with the element's concrete type
+    template<typename F>
+    void for_each(F&& f);
+    template<typename F>
+    void for_each(F&& f) const;
+    template<typename F>
+    void visit(size_t index, F&& f) const;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { destroyAll(); }
+};
+
 // Function prototypes for demonstrations
 void demonstrateVirtualFunctions();
 void demonstratePureVirtualFunctions();
 void demonstrateVirtualDestructor();
 void demonstrateFinalKeyword();
 void demonstrateVirtualCallResolution();
+void demonstrateStaticPolymorphism();
+void benchmarkDispatch();
 
 int main() {
     std::cout << "=== Virtual Functions Examples ===\n\n";
@@ -125,6 +247,8 @@ int main() {
     demonstrateVirtualDestructor();
     demonstrateFinalKeyword();
     demonstrateVirtualCallResolution();
+    demonstrateStaticPolymorphism();
+    benchmarkDispatch();
     
     return 0;
 }
@@ -163,3 +287,325 @@ void demonstrateVirtualCallResolution() {
     // Show vtable concept in action
     std::cout << "---\n\n";
 }
+
+void demonstrateStaticPolymorphism() {
+    std::cout << "6. Static Polymorphism (final, CRTP, poly_vector):\n";
+
+    // Same interface, three dispatch mechanisms
+    SealedRectangle sealed(2.0, 3.0);
+    const SealedRectangle& sealedRef = sealed;
+    std::cout << "final class, call devirtualized: area " << sealedRef.area() << "\n";
+
+    CrtpCircle crtp(1.0);
+    std::cout << "CRTP circle: area " << crtp.area() << ", sizeof " << sizeof(CrtpCircle)
+              << " (no vptr) vs Circle " << sizeof(Circle) << "\n";
+
+    poly_vector<CrtpRectangle, CrtpCircle> shapes;
+    shapes.emplace_back<CrtpRectangle>(3.0, 4.0);
+    shapes.emplace_back<CrtpCircle>(2.0);
+    shapes.emplace_back<CrtpRectangle>(1.0, 1.0);
+    double total = 0;
+    shapes.for_each([&](const auto& shape) {
+        shape.draw();
+        total += shape.area();
+    });
+    std::cout << "poly_vector of " << shapes.size() << " inline shapes, total area " << total << "\n";
+    std::cout << "---\n\n";
+}
+
+// ns/call harness: best of several runs to filter out scheduling noise
+static volatile double dispatchSink = 0;
+
+template<typename Loop>
+static double bestNsPerCall(size_t calls, Loop loop) {
+    constexpr int RUNS = 7;
+    double best = 1e30;
+    for (int run = 0; run < RUNS; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        double sum = loop();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        dispatchSink = sum;
+        best = std::min(best, ns / calls);
+    }
+    return best;
+}
+
+void benchmarkDispatch() {
+    std::cout << "7. Dispatch Benchmark (ns per area() call):\n";
+    constexpr size_t COUNT = 1 << 18;
+
+    // true = rectangle. Predictable keeps the types sorted; shuffled randomizes them.
+    std::vector<bool> predictable(COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        predictable[i] = i < COUNT / 2;
+    }
+    std::vector<bool> shuffled = predictable;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+
+    std::cout << std::left << std::setw(40) << "Mechanism" << std::right << std::setw(13) << "predictable"
+              << std::setw(11) << "shuffled" << "\n";
+
+    auto row = [&](const char* label, auto build) {
+        double results[2];
+        int column = 0;
+        for (const std::vector<bool>* order : {&predictable, &shuffled}) {
+            results[column++] = build(*order);
+        }
+        std::cout << std::left << std::setw(40) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(13) << results[0] << std::setw(11) << results[1] << "\n";
+    };
+
+    row("virtual via unique_ptr<Shape>", [&](const std::vector<bool>& order) {
+        std::vector<std::unique_ptr<Shape>> shapes;
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (order[i]) {
+                shapes.push_back(std::make_unique<Rectangle>(1.0 + i % 7, 2.0));
+            } else {
+                shapes.push_back(std::make_unique<Circle>(1.0 + i % 5));
+            }
+        }
+        return bestNsPerCall(COUNT, [&]() {
+            double sum = 0;
+            for (const auto& shape : shapes) {
+                sum += shape->area();
+            }
+            return sum;
+        });
+    });
+
+    row("final classes in poly_vector", [&](const std::vector<bool>& order) {
+        poly_vector<SealedRectangle, SealedCircle> shapes;
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (order[i]) {
+                shapes.emplace_back<SealedRectangle>(1.0 + i % 7, 2.0);
+            } else {
+                shapes.emplace_back<SealedCircle>(1.0 + i % 5);
+            }
+        }
+        return bestNsPerCall(COUNT, [&]() {
+            double sum = 0;
+            shapes.for_each([&](const auto& shape) { sum += shape.area(); });
+            return sum;
+        });
+    });
+
+    row("CRTP types in poly_vector", [&](const std::vector<bool>& order) {
+        poly_vector<CrtpRectangle, CrtpCircle> shapes;
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (order[i]) {
+                shapes.emplace_back<CrtpRectangle>(1.0 + i % 7, 2.0);
+            } else {
+                shapes.emplace_back<CrtpCircle>(1.0 + i % 5);
+            }
+        }
+        return bestNsPerCall(COUNT, [&]() {
+            double sum = 0;
+            shapes.for_each([&](const auto& shape) { sum += shape.area(); });
+            return sum;
+        });
+    });
+
+    row("CRTP types in vector<variant> + visit", [&](const std::vector<bool>& order) {
+        std::vector<std::variant<CrtpRectangle, CrtpCircle>> shapes;
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (order[i]) {
+                shapes.emplace_back(CrtpRectangle(1.0 + i % 7, 2.0));
+            } else {
+                shapes.emplace_back(CrtpCircle(1.0 + i % 5));
+            }
+        }
+        return bestNsPerCall(COUNT, [&]() {
+            double sum = 0;
+            for (const auto& shape : shapes) {
+                sum += std::visit([](const auto& s) { return s.area(); }, shape);
+            }
+            return sum;
+        });
+    });
+
+    // Homogeneous containers have no type order to vary, so one number
+    std::vector<SealedRectangle> sealedOnly;
+    std::vector<CrtpRectangle> crtpOnly;
+    for (size_t i = 0; i < COUNT; ++i) {
+        sealedOnly.emplace_back(1.0 + i % 7, 2.0);
+        crtpOnly.emplace_back(1.0 + i % 7, 2.0);
+    }
+    double sealedNs = bestNsPerCall(COUNT, [&]() {
+        double sum = 0;
+        for (const SealedRectangle& shape : sealedOnly) {
+            sum += shape.area();
+        }
+        return sum;
+    });
+    double crtpNs = bestNsPerCall(COUNT, [&]() {
+        double sum = 0;
+        for (const auto& shape : crtpOnly) {
+            sum += shape.area();
+        }
+        return sum;
+    });
+    std::cout << std::left << std::setw(40) << "vector<SealedRectangle> (final)" << std::right
+              << std::setw(13) << sealedNs << std::setw(11) << "-" << "\n";
+    std::cout << std::left << std::setw(40) << "vector<CrtpRectangle>" << std::right
+              << std::setw(13) << crtpNs << std::setw(11) << "-" << "\n";
+    std::cout << "---\n\n";
+}
+
+// Shape implementations
+Rectangle::Rectangle(double w, double h) : width(w), height(h) {}
+
+double Rectangle::area() const {
+    return width * height;
+}
+
+void Rectangle::draw() const {
+    std::cout << "Drawing rectangle " << width << "x" << height << "\n";
+}
+
+Circle::Circle(double r) : radius(r) {}
+
+double Circle::area() const {
+    return M_PI * radius * radius;
+}
+
+void Circle::draw() const {
+    std::cout << "Drawing circle with radius " << radius << "\n";
+}
+
+void SealedRectangle::draw() const {
+    std::cout << "Drawing sealed rectangle " << width << "x" << height << "\n";
+}
+
+void SealedCircle::draw() const {
+    std::cout << "Drawing sealed circle with radius " << radius << "\n";
+}
+
+void CrtpRectangle::drawImpl() const {
+    std::cout << "Drawing CRTP rectangle " << width << "x" << height << "\n";
+}
+
+void CrtpCircle::drawImpl() const {
+    std::cout << "Drawing CRTP circle with radius " << radius << "\n";
+}
+
+// poly_vector implementation
+template<typename... Ts>
+template<typename T, size_t I>
+constexpr uint8_t poly_vector<Ts...>::tagOf() {
+    using Candidate = std::tuple_element_t<I, std::tuple<Ts...>>;
+    if constexpr (std::is_same_v<T, Candidate>) {
+        return static_cast<uint8_t>(I);
+    } else {
+        static_assert(I + 1 < sizeof...(Ts), "type is not stored by this poly_vector");
+        return tagOf<T, I + 1>();
+    }
+}
+
+template<typename... Ts>
+template<typename F, size_t... Is>
+void poly_vector<Ts...>::dispatch(uint8_t tag, void* slot, F& f, std::index_sequence<Is...>) {
+    // Exactly one comparison matches; the rest short-circuit
+    (void)((tag == Is ? (f(*std::launder(reinterpret_cast<std::tuple_element_t<Is, std::tuple<Ts...>>*>(slot))),
+                         true)
+                      : false) || ...);
+}
+
+template<typename... Ts>
+void poly_vector<Ts...>::grow() {
+    size_t newCapacity = capacity ? capacity * 2 : 16;
+    Slot* newSlots = static_cast<Slot*>(::operator new(newCapacity * sizeof(Slot), std::align_val_t(alignof(Slot))));
+    uint8_t* newTags = new uint8_t[newCapacity];
+
+    // Relocate: move-construct into the new slot, destroy the old object
+    for (size_t i = 0; i < count; ++i) {
+        void* target = &newSlots[i];
+        auto relocate = [target](auto& element) {
+            using T = std::decay_t<decltype(element)>;
+            new (target) T(std::move(element));
+            element.~T();
+        };
+        dispatch(tags[i], &slots[i], relocate, std::index_sequence_for<Ts...>{});
+        newTags[i] = tags[i];
+    }
+
+    ::operator delete(slots, std::align_val_t(alignof(Slot)));
+    delete[] tags;
+    slots = newSlots;
+    tags = newTags;
+    capacity = newCapacity;
+}
+
+template<typename... Ts>
+void poly_vector<Ts...>::destroyAll() {
+    auto destroy = [](auto& element) {
+        using T = std::decay_t<decltype(element)>;
+        element.~T();
+    };
+    for (size_t i = 0; i < count; ++i) {
+        dispatch(tags[i], &slots[i], destroy, std::index_sequence_for<Ts...>{});
+    }
+    count = 0;
+}
+
+template<typename... Ts>
+poly_vector<Ts...>::~poly_vector() {
+    destroyAll();
+    ::operator delete(slots, std::align_val_t(alignof(Slot)));
+    delete[] tags;
+}
+
+template<typename... Ts>
+poly_vector<Ts...>::poly_vector(poly_vector&& other) noexcept
+    : slots(std::exchange(other.slots, nullptr)), tags(std::exchange(other.tags, nullptr)),
+      count(std::exchange(other.count, 0)), capacity(std::exchange(other.capacity, 0)) {}
+
+template<typename... Ts>
+poly_vector<Ts...>& poly_vector<Ts...>::operator=(poly_vector&& other) noexcept {
+    if (this != &other) {
+        destroyAll();
+        ::operator delete(slots, std::align_val_t(alignof(Slot)));
+        delete[] tags;
+        slots = std::exchange(other.slots, nullptr);
+        tags = std::exchange(other.tags, nullptr);
+        count = std::exchange(other.count, 0);
+        capacity = std::exchange(other.capacity, 0);
+    }
+    return *this;
+}
+
+template<typename... Ts>
+template<typename T, typename... Args>
+T& poly_vector<Ts...>::emplace_back(Args&&... args) {
+    constexpr uint8_t tag = tagOf<T>();
+    if (count == capacity) {
+        grow();
+    }
+    T* element = new (&slots[count]) T(std::forward<Args>(args)...);
+    tags[count] = tag;
+    ++count;
+    return *element;
+}
+
+template<typename... Ts>
+template<typename F>
+void poly_vector<Ts...>::for_each(F&& f) {
+    for (size_t i = 0; i < count; ++i) {
+        dispatch(tags[i], &slots[i], f, std::index_sequence_for<Ts...>{});
+    }
+}
+
+template<typename... Ts>
+template<typename F>
+void poly_vector<Ts...>::for_each(F&& f) const {
+    auto asConst = [&f](auto& element) { f(std::as_const(element)); };
+    for (size_t i = 0; i < count; ++i) {
+        dispatch(tags[i], &slots[i], asConst, std::index_sequence_for<Ts...>{});
+    }
+}
+
+template<typename... Ts>
+template<typename F>
+void poly_vector<Ts...>::visit(size_t index, F&& f) const {
+    auto asConst = [&f](auto& element) { f(std::as_const(element)); };
+    dispatch(tags[index], &slots[index], asConst, std::index_sequence_for<Ts...>{});
+}
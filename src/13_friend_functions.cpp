@@ -15,6 +15,21 @@
 #include <string>
 #include <ostream>
 #include <istream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "allocation_counter.h"
 
 // TODO: Implement these classes demonstrating friend concepts
 
@@ -22,6 +37,8 @@
 class Vector3D;
 class Matrix;
 class BankAccount;
+class Vector3DArray;
+enum class MathKernel;
 
 // 1. Basic friend function example
 class Point {
@@ -116,6 +133,8 @@ public:
     
     // Friend class
     friend class Matrix;
+    friend class Vector3DArray;  // Packs/unpacks coordinates for the batch API
+    friend void transform(const Matrix& m, const Vector3D* in, Vector3D* out, size_t count);
     
     // Friend operator overloads
     friend Vector3D operator+(const Vector3D& v1, const Vector3D& v2);
@@ -145,6 +164,8 @@ public:
     
     // Friend function for matrix-vector multiplication
     friend Vector3D operator*(const Matrix& m, const Vector3D& v);
+    friend void transform(const Matrix& m, const Vector3D* in, Vector3D* out, size_t count);
+    friend void transform(const Matrix& m, const Vector3DArray& in, Vector3DArray& out, MathKernel kernel);
     
     // Friend class that can access private matrix data
     friend class MatrixAnalyzer;
@@ -192,6 +213,151 @@ public:
     static double calculateInterest(const BankAccount& account, double rate);
 };
 
+// 6. Batch vector math
+// Vector3DArray keeps vectors in AoSoA form: blocks of LANES x, y and z
+// values, 32-byte aligned and zero-padded to a whole block. One AVX
+// register (or two SSE2/NEON registers) then holds one coordinate of four
+// vectors, and the batch functions below process a block per iteration.
+// C++17 has no std::span, so the AoS batch API takes pointer + count.
+enum class MathKernel { Scalar, SSE2, AVX, NEON };
+MathKernel bestMathKernel();
+const char* mathKernelName(MathKernel kernel);
+
+// Expression templates for element-wise Vector3DArray arithmetic:
+// a + 2.0 * b - c builds a tree of nodes referencing the leaf arrays and is
+// evaluated in one fused pass, block by block, when assigned to an array.
+// Keep expressions inside one full-expression; they hold references.
+template<typename E>
+class Vec3Expr {
+public:
+    double x(size_t i) const { return static_cast<const E&>(*this).x(i); }
+    double y(size_t i) const { return static_cast<const E&>(*this).y(i); }
+    double z(size_t i) const { return static_cast<const E&>(*this).z(i); }
+    size_t size() const { return static_cast<const E&>(*this).size(); }
+};
+
+// Leaves are held by reference, intermediate nodes by value
+template<typename E>
+struct Vec3ExprStorage {
+    using type = const E;
+};
+
+template<>
+struct Vec3ExprStorage<Vector3DArray> {
+    using type = const Vector3DArray&;
+};
+
+template<typename L, typename R, typename Op>
+class Vec3Binary : public Vec3Expr<Vec3Binary<L, R, Op>> {
+private:
+    typename Vec3ExprStorage<L>::type lhs;
+    typename Vec3ExprStorage<R>::type rhs;
+
+public:
+    Vec3Binary(const L& l, const R& r) : lhs(l), rhs(r) {
+        if (l.size() != r.size()) {
+            throw std::invalid_argument("Vector3DArray expression: size mismatch");
+        }
+    }
+    double x(size_t i) const { return Op::apply(lhs.x(i), rhs.x(i)); }
+    double y(size_t i) const { return Op::apply(lhs.y(i), rhs.y(i)); }
+    double z(size_t i) const { return Op::apply(lhs.z(i), rhs.z(i)); }
+    size_t size() const { return lhs.size(); }
+};
+
+template<typename E>
+class Vec3Scaled : public Vec3Expr<Vec3Scaled<E>> {
+private:
+    double scalar;
+    typename Vec3ExprStorage<E>::type expr;
+
+public:
+    Vec3Scaled(double s, const E& e) : scalar(s), expr(e) {}
+    double x(size_t i) const { return scalar * expr.x(i); }
+    double y(size_t i) const { return scalar * expr.y(i); }
+    double z(size_t i) const { return scalar * expr.z(i); }
+    size_t size() const { return expr.size(); }
+};
+
+struct Vec3AddOp { static double apply(double a, double b) { return a + b; } };
+struct Vec3SubOp { static double apply(double a, double b) { return a - b; } };
+
+class Vector3DArray : public Vec3Expr<Vector3DArray> {
+public:
+    static constexpr size_t LANES = 4;
+    struct alignas(32) Block {
+        double x[LANES];
+        double y[LANES];
+        double z[LANES];
+    };
+
+private:
+    std::vector<Block> blocks;
+    size_t count = 0;
+
+public:
+    Vector3DArray() = default;
+    explicit Vector3DArray(size_t n);
+    Vector3DArray(const Vector3D* vectors, size_t n);
+    template<typename E>
+    Vector3DArray(const Vec3Expr<E>& expr);
+    template<typename E>
+    Vector3DArray& operator=(const Vec3Expr<E>& expr);
+
+    void resize(size_t n);
+    size_t size() const { return count; }
+    size_t blockCount() const { return blocks.size(); }
+    Block* data() { return blocks.data(); }
+    const Block* data() const { return blocks.data(); }
+
+    Vector3D get(size_t i) const;
+    void set(size_t i, const Vector3D& v);
+    void toAoS(Vector3D* out) const;
+
+    // Expression leaf access; i may index padding lanes up to blockCount() * LANES
+    double x(size_t i) const { return blocks[i / LANES].x[i % LANES]; }
+    double y(size_t i) const { return blocks[i / LANES].y[i % LANES]; }
+    double z(size_t i) const { return blocks[i / LANES].z[i % LANES]; }
+};
+
+template<typename L, typename R>
+Vec3Binary<L, R, Vec3AddOp> operator+(const Vec3Expr<L>& l, const Vec3Expr<R>& r);
+template<typename L, typename R>
+Vec3Binary<L, R, Vec3SubOp> operator-(const Vec3Expr<L>& l, const Vec3Expr<R>& r);
+template<typename E>
+Vec3Scaled<E> operator*(double scalar, const Vec3Expr<E>& e);
+template<typename E>
+Vec3Scaled<E> operator*(const Vec3Expr<E>& e, double scalar);
+
+// Batch operations; outputs are resized to match the input
+void transform(const Matrix& m, const Vector3D* in, Vector3D* out, size_t count);  // Per-vector path
+void transform(const Matrix& m, const Vector3DArray& in, Vector3DArray& out, MathKernel kernel = bestMathKernel());
+void dot(const Vector3DArray& a, const Vector3DArray& b, std::vector<double>& out,
+         MathKernel kernel = bestMathKernel());
+void cross(const Vector3DArray& a, const Vector3DArray& b, Vector3DArray& out, MathKernel kernel = bestMathKernel());
+void normalize(const Vector3DArray& in, Vector3DArray& out, MathKernel kernel = bestMathKernel());
+
+// Row-major dense matrix of any shape
+class MatrixNxM {
+private:
+    size_t rows, cols;
+    std::vector<double> values;
+
+public:
+    MatrixNxM(size_t rows, size_t cols, double fill = 0.0);
+
+    double& operator()(size_t r, size_t c) { return values[r * cols + c]; }
+    double operator()(size_t r, size_t c) const { return values[r * cols + c]; }
+    size_t getRows() const { return rows; }
+    size_t getCols() const { return cols; }
+
+    // Textbook i-j-k loop: strides down a column of b in the inner loop
+    static MatrixNxM multiplyNaive(const MatrixNxM& a, const MatrixNxM& b);
+    // Tiles of blockSize^3 that stay in cache, i-k-j order so the inner loop is contiguous
+    static MatrixNxM multiplyBlocked(const MatrixNxM& a, const MatrixNxM& b, size_t blockSize = 64);
+    friend MatrixNxM operator*(const MatrixNxM& a, const MatrixNxM& b);
+};
+
 // Function prototypes for demonstrations
 void demonstrateBasicFriendFunctions();
 void demonstrateFriendClasses();
@@ -200,6 +366,9 @@ void demonstrateComplexFriendOperations();
 void demonstrateFriendVsMember();
 void demonstratePracticalFriendUsage();
 void demonstrateFriendBestPractices();
+void demonstrateBatchVectorMath();
+void benchmarkBatchVectorMath();
+void benchmarkVectorExpressions();
 
 int main() {
     std::cout << "=== Friend Functions and Classes Examples ===\n\n";
@@ -212,6 +381,9 @@ int main() {
     demonstrateFriendVsMember();
     demonstratePracticalFriendUsage();
     demonstrateFriendBestPractices();
+    demonstrateBatchVectorMath();
+    benchmarkBatchVectorMath();
+    benchmarkVectorExpressions();
     
     return 0;
 }
@@ -430,6 +602,236 @@ void demonstrateFriendBestPractices() {
     std::cout << "---\n\n";
 }
 
+void demonstrateBatchVectorMath() {
+    std::cout << "8. Batch Vector Math (AoSoA + SIMD):\n";
+
+    double rotation[3][3] = {{0, -1, 0}, {1, 0, 0}, {0, 0, 1}};  // 90 degrees about z
+    Matrix rotate(rotation);
+    std::vector<Vector3D> points = {{1, 0, 0}, {0, 2, 0}, {3, 4, 0}, {1, 1, 1}, {0, 0, 5}};
+
+    Vector3DArray packed(points.data(), points.size());
+    Vector3DArray rotated;
+    transform(rotate, packed, rotated);
+    std::cout << "Kernel: " << mathKernelName(bestMathKernel()) << ", " << packed.size()
+              << " vectors in " << packed.blockCount() << " blocks\n";
+    for (size_t i = 0; i < rotated.size(); ++i) {
+        std::cout << "  rotate " << points[i] << " -> " << rotated.get(i)
+                  << " (scalar " << rotate * points[i] << ")\n";
+    }
+
+    std::vector<double> dots;
+    Vector3DArray crosses, units;
+    dot(packed, rotated, dots);
+    cross(packed, rotated, crosses);
+    normalize(packed, units);
+    std::cout << "  dot(p[2], r[2]) = " << dots[2] << ", cross = " << crosses.get(2)
+              << ", normalize(p[2]) = " << units.get(2) << "\n";
+
+    MatrixNxM a(2, 3, 1.0), b(3, 2, 2.0);
+    MatrixNxM c = a * b;
+    std::cout << "  (2x3 of 1) * (3x2 of 2) = " << c.getRows() << "x" << c.getCols()
+              << " of " << c(0, 0) << "\n";
+    std::cout << "---\n\n";
+}
+
+template<typename Fn>
+static double bestSeconds(int runs, Fn fn) {
+    double best = 1e30;
+    for (int run = 0; run < runs; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+static void reportThroughput(const char* op, const std::string& path, size_t vectors, double flopsPerVector,
+                             double seconds) {
+    std::cout << std::left << std::setw(11) << op << std::setw(22) << path << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << vectors / seconds / 1e6
+              << std::setprecision(2) << std::setw(10) << vectors * flopsPerVector / seconds / 1e9 << "\n";
+}
+
+void benchmarkBatchVectorMath() {
+    std::cout << "9. Batch Vector Math Benchmark:\n";
+    constexpr size_t VECTORS = 4000000;
+    constexpr int RUNS = 3;
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> coord(-10.0, 10.0);
+    std::vector<Vector3D> a(VECTORS), b(VECTORS), out(VECTORS);
+    for (size_t i = 0; i < VECTORS; ++i) {
+        a[i] = Vector3D(coord(rng), coord(rng), coord(rng));
+        b[i] = Vector3D(coord(rng), coord(rng), coord(rng));
+    }
+    double values[3][3] = {{0.36, 0.48, -0.8}, {-0.8, 0.6, 0.0}, {0.48, 0.64, 0.6}};
+    Matrix m(values);
+
+    Vector3DArray packedA(a.data(), VECTORS), packedB(b.data(), VECTORS), packedOut;
+    std::vector<double> dots(VECTORS);
+
+    std::vector<MathKernel> kernels = {MathKernel::Scalar};
+    MathKernel best = bestMathKernel();
+    if (best == MathKernel::AVX || best == MathKernel::SSE2) {
+        kernels.push_back(MathKernel::SSE2);
+    }
+    if (best != MathKernel::Scalar && best != MathKernel::SSE2) {
+        kernels.push_back(best);
+    }
+
+    std::cout << VECTORS << " vectors, best of " << RUNS << " runs\n";
+    std::cout << std::left << std::setw(11) << "Operation" << std::setw(22) << "Path" << std::right
+              << std::setw(12) << "M vec/s" << std::setw(10) << "GFLOP/s" << "\n";
+
+    // transform: 9 mul + 6 add; dot: 3 mul + 2 add; cross: 6 mul + 3 sub;
+    // normalize: 3 mul + 2 add + sqrt + div + 3 mul
+    reportThroughput("transform", "AoS operator*", VECTORS, 15, bestSeconds(RUNS, [&]() {
+        for (size_t i = 0; i < VECTORS; ++i) {
+            out[i] = m * a[i];
+        }
+    }));
+    reportThroughput("transform", "AoS batch", VECTORS, 15, bestSeconds(RUNS, [&]() {
+        transform(m, a.data(), out.data(), VECTORS);
+    }));
+    for (MathKernel kernel : kernels) {
+        reportThroughput("transform", std::string("AoSoA ") + mathKernelName(kernel), VECTORS, 15,
+                         bestSeconds(RUNS, [&]() { transform(m, packedA, packedOut, kernel); }));
+    }
+
+    reportThroughput("dot", "AoS friend dot()", VECTORS, 5, bestSeconds(RUNS, [&]() {
+        for (size_t i = 0; i < VECTORS; ++i) {
+            dots[i] = dot(a[i], b[i]);
+        }
+    }));
+    for (MathKernel kernel : kernels) {
+        reportThroughput("dot", std::string("AoSoA ") + mathKernelName(kernel), VECTORS, 5,
+                         bestSeconds(RUNS, [&]() { dot(packedA, packedB, dots, kernel); }));
+    }
+
+    reportThroughput("cross", "AoS friend cross()", VECTORS, 9, bestSeconds(RUNS, [&]() {
+        for (size_t i = 0; i < VECTORS; ++i) {
+            out[i] = cross(a[i], b[i]);
+        }
+    }));
+    for (MathKernel kernel : kernels) {
+        reportThroughput("cross", std::string("AoSoA ") + mathKernelName(kernel), VECTORS, 9,
+                         bestSeconds(RUNS, [&]() { cross(packedA, packedB, packedOut, kernel); }));
+    }
+
+    reportThroughput("normalize", "AoS normalize()", VECTORS, 10, bestSeconds(RUNS, [&]() {
+        for (size_t i = 0; i < VECTORS; ++i) {
+            out[i] = a[i].normalize();
+        }
+    }));
+    for (MathKernel kernel : kernels) {
+        reportThroughput("normalize", std::string("AoSoA ") + mathKernelName(kernel), VECTORS, 10,
+                         bestSeconds(RUNS, [&]() { normalize(packedA, packedOut, kernel); }));
+    }
+
+    // NxM multiply: 2 * n^3 flops
+    constexpr size_t N = 512;
+    MatrixNxM x(N, N), y(N, N);
+    for (size_t r = 0; r < N; ++r) {
+        for (size_t c = 0; c < N; ++c) {
+            x(r, c) = coord(rng);
+            y(r, c) = coord(rng);
+        }
+    }
+    MatrixNxM naive(1, 1), blocked(1, 1);
+    double naiveSeconds = bestSeconds(1, [&]() { naive = MatrixNxM::multiplyNaive(x, y); });
+    double blockedSeconds = bestSeconds(1, [&]() { blocked = MatrixNxM::multiplyBlocked(x, y); });
+    double maxDiff = 0;
+    for (size_t r = 0; r < N; ++r) {
+        for (size_t c = 0; c < N; ++c) {
+            maxDiff = std::max(maxDiff, std::abs(naive(r, c) - blocked(r, c)));
+        }
+    }
+    const double flops = 2.0 * N * N * N;
+    std::cout << N << "x" << N << " multiply: naive " << std::setprecision(2) << flops / naiveSeconds / 1e9
+              << " GFLOP/s, blocked " << flops / blockedSeconds / 1e9 << " GFLOP/s (max diff "
+              << std::scientific << maxDiff << std::defaultfloat << ")\n";
+    std::cout << "---\n\n";
+}
+
+// The pre-expression-template behavior: every operator returns a new array
+static Vector3DArray eagerAdd(const Vector3DArray& l, const Vector3DArray& r) {
+    Vector3DArray out(l.size());
+    for (size_t i = 0; i < l.size(); ++i) {
+        out.set(i, l.get(i) + r.get(i));
+    }
+    return out;
+}
+
+static Vector3DArray eagerSub(const Vector3DArray& l, const Vector3DArray& r) {
+    Vector3DArray out(l.size());
+    for (size_t i = 0; i < l.size(); ++i) {
+        out.set(i, l.get(i) - r.get(i));
+    }
+    return out;
+}
+
+static Vector3DArray eagerScale(double s, const Vector3DArray& v) {
+    Vector3DArray out(v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        out.set(i, s * v.get(i));
+    }
+    return out;
+}
+
+template<typename Fn>
+static void reportExpression(const char* label, int repeats, Fn fn) {
+    double checksum = 0;
+    AllocationRun run = measureAllocations(repeats, [&] {
+        for (int r = 0; r < repeats; ++r) {
+            checksum += fn();
+        }
+    });
+    std::cout << std::left << std::setw(36) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << run.allocationsPerOp
+              << std::setw(10) << std::setprecision(2) << run.nsPerOp / 1e6 << "   (checksum " << checksum << ")\n"
+              << std::defaultfloat;
+}
+
+void benchmarkVectorExpressions() {
+    std::cout << "10. Vector3DArray Expression Template Benchmark:\n";
+    constexpr size_t N = 1000000;
+    constexpr int REPEATS = 10;
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> coord(-1.0, 1.0);
+    std::vector<Vector3DArray> v(8);
+    for (auto& arr : v) {
+        arr.resize(N);
+        for (size_t i = 0; i < N; ++i) {
+            arr.set(i, Vector3D(coord(rng), coord(rng), coord(rng)));
+        }
+    }
+    Vector3DArray out(N);
+
+    std::cout << N << " vectors, averaged over " << REPEATS << " runs\n";
+    std::cout << std::left << std::setw(36) << "Expression" << std::right << std::setw(10) << "allocs"
+              << std::setw(10) << "ms" << "\n";
+
+    reportExpression("4 terms, eager temporaries", REPEATS, [&]() {
+        out = eagerAdd(eagerSub(eagerAdd(v[0], eagerScale(2.0, v[1])), v[2]), v[3]);
+        return out.get(N / 2).getX();
+    });
+    reportExpression("4 terms, expression template", REPEATS, [&]() {
+        out = v[0] + 2.0 * v[1] - v[2] + v[3];
+        return out.get(N / 2).getX();
+    });
+    reportExpression("8 terms, eager temporaries", REPEATS, [&]() {
+        out = eagerAdd(eagerSub(eagerAdd(eagerSub(eagerAdd(eagerSub(eagerAdd(v[0], eagerScale(2.0, v[1])), v[2]),
+                                                           v[3]), v[4]), eagerScale(0.5, v[5])), v[6]), v[7]);
+        return out.get(N / 2).getX();
+    });
+    reportExpression("8 terms, expression template", REPEATS, [&]() {
+        out = v[0] + 2.0 * v[1] - v[2] + v[3] - v[4] + 0.5 * v[5] - v[6] + v[7];
+        return out.get(N / 2).getX();
+    });
+    std::cout << "---\n\n";
+}
+
 // TODO: Implement all class methods and friend functions
 
 // Point class implementation
@@ -749,3 +1151,470 @@ void BankManager::emergencyFreeze(BankAccount& account) {
 double BankManager::calculateInterest(const BankAccount& account, double rate) {
     return account.balance * rate;
 }
+
+// Batch vector math implementation
+using VectorBlock = Vector3DArray::Block;
+static constexpr size_t LANES = Vector3DArray::LANES;
+
+Vector3DArray::Vector3DArray(size_t n) {
+    resize(n);
+}
+
+Vector3DArray::Vector3DArray(const Vector3D* vectors, size_t n) {
+    resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        Block& block = blocks[i / LANES];
+        block.x[i % LANES] = vectors[i].x;
+        block.y[i % LANES] = vectors[i].y;
+        block.z[i % LANES] = vectors[i].z;
+    }
+}
+
+void Vector3DArray::resize(size_t n) {
+    blocks.resize((n + LANES - 1) / LANES, Block{});
+    count = n;
+}
+
+Vector3D Vector3DArray::get(size_t i) const {
+    const Block& block = blocks[i / LANES];
+    return Vector3D(block.x[i % LANES], block.y[i % LANES], block.z[i % LANES]);
+}
+
+void Vector3DArray::set(size_t i, const Vector3D& v) {
+    Block& block = blocks[i / LANES];
+    block.x[i % LANES] = v.x;
+    block.y[i % LANES] = v.y;
+    block.z[i % LANES] = v.z;
+}
+
+template<typename E>
+Vector3DArray::Vector3DArray(const Vec3Expr<E>& expr) {
+    *this = expr;
+}
+
+// Fused evaluation over whole blocks; the inner lane loop vectorizes
+template<typename E>
+Vector3DArray& Vector3DArray::operator=(const Vec3Expr<E>& expr) {
+    if (expr.size() != count) {
+        // Resizing could move storage the expression still reads from
+        Vector3DArray evaluated;
+        evaluated.resize(expr.size());
+        for (size_t b = 0; b < evaluated.blocks.size(); ++b) {
+            for (size_t l = 0; l < LANES; ++l) {
+                evaluated.blocks[b].x[l] = expr.x(b * LANES + l);
+                evaluated.blocks[b].y[l] = expr.y(b * LANES + l);
+                evaluated.blocks[b].z[l] = expr.z(b * LANES + l);
+            }
+        }
+        *this = std::move(evaluated);
+        return *this;
+    }
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        for (size_t l = 0; l < LANES; ++l) {
+            blocks[b].x[l] = expr.x(b * LANES + l);
+            blocks[b].y[l] = expr.y(b * LANES + l);
+            blocks[b].z[l] = expr.z(b * LANES + l);
+        }
+    }
+    return *this;
+}
+
+void Vector3DArray::toAoS(Vector3D* out) const {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = get(i);
+    }
+}
+
+// Kernels work on whole blocks; padding lanes are zero and stay harmless
+static void transformScalar(const double (*m)[3], const VectorBlock* in, VectorBlock* out, size_t blocks) {
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t l = 0; l < LANES; ++l) {
+            double x = in[b].x[l], y = in[b].y[l], z = in[b].z[l];
+            out[b].x[l] = m[0][0] * x + m[0][1] * y + m[0][2] * z;
+            out[b].y[l] = m[1][0] * x + m[1][1] * y + m[1][2] * z;
+            out[b].z[l] = m[2][0] * x + m[2][1] * y + m[2][2] * z;
+        }
+    }
+}
+
+static void dotScalar(const VectorBlock* a, const VectorBlock* b, double* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; ++l) {
+            out[i * LANES + l] = a[i].x[l] * b[i].x[l] + a[i].y[l] * b[i].y[l] + a[i].z[l] * b[i].z[l];
+        }
+    }
+}
+
+static void crossScalar(const VectorBlock* a, const VectorBlock* b, VectorBlock* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; ++l) {
+            double ax = a[i].x[l], ay = a[i].y[l], az = a[i].z[l];
+            double bx = b[i].x[l], by = b[i].y[l], bz = b[i].z[l];
+            out[i].x[l] = ay * bz - az * by;
+            out[i].y[l] = az * bx - ax * bz;
+            out[i].z[l] = ax * by - ay * bx;
+        }
+    }
+}
+
+static void normalizeScalar(const VectorBlock* in, VectorBlock* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; ++l) {
+            double x = in[i].x[l], y = in[i].y[l], z = in[i].z[l];
+            double mag = std::sqrt(x * x + y * y + z * z);
+            double inv = mag > 0 ? 1.0 / mag : 0.0;  // Zero vector stays zero, as in Vector3D::normalize
+            out[i].x[l] = x * inv;
+            out[i].y[l] = y * inv;
+            out[i].z[l] = z * inv;
+        }
+    }
+}
+
+#if defined(__SSE2__)
+// Two lanes per register, two registers per block
+static void transformSSE2(const double (*m)[3], const VectorBlock* in, VectorBlock* out, size_t blocks) {
+    __m128d m00 = _mm_set1_pd(m[0][0]), m01 = _mm_set1_pd(m[0][1]), m02 = _mm_set1_pd(m[0][2]);
+    __m128d m10 = _mm_set1_pd(m[1][0]), m11 = _mm_set1_pd(m[1][1]), m12 = _mm_set1_pd(m[1][2]);
+    __m128d m20 = _mm_set1_pd(m[2][0]), m21 = _mm_set1_pd(m[2][1]), m22 = _mm_set1_pd(m[2][2]);
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t l = 0; l < LANES; l += 2) {
+            __m128d x = _mm_load_pd(in[b].x + l), y = _mm_load_pd(in[b].y + l), z = _mm_load_pd(in[b].z + l);
+            _mm_store_pd(out[b].x + l, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m00, x), _mm_mul_pd(m01, y)), _mm_mul_pd(m02, z)));
+            _mm_store_pd(out[b].y + l, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m10, x), _mm_mul_pd(m11, y)), _mm_mul_pd(m12, z)));
+            _mm_store_pd(out[b].z + l, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m20, x), _mm_mul_pd(m21, y)), _mm_mul_pd(m22, z)));
+        }
+    }
+}
+
+static void dotSSE2(const VectorBlock* a, const VectorBlock* b, double* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; l += 2) {
+            __m128d r = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_load_pd(a[i].x + l), _mm_load_pd(b[i].x + l)),
+                                              _mm_mul_pd(_mm_load_pd(a[i].y + l), _mm_load_pd(b[i].y + l))),
+                                   _mm_mul_pd(_mm_load_pd(a[i].z + l), _mm_load_pd(b[i].z + l)));
+            _mm_storeu_pd(out + i * LANES + l, r);
+        }
+    }
+}
+
+static void crossSSE2(const VectorBlock* a, const VectorBlock* b, VectorBlock* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; l += 2) {
+            __m128d ax = _mm_load_pd(a[i].x + l), ay = _mm_load_pd(a[i].y + l), az = _mm_load_pd(a[i].z + l);
+            __m128d bx = _mm_load_pd(b[i].x + l), by = _mm_load_pd(b[i].y + l), bz = _mm_load_pd(b[i].z + l);
+            _mm_store_pd(out[i].x + l, _mm_sub_pd(_mm_mul_pd(ay, bz), _mm_mul_pd(az, by)));
+            _mm_store_pd(out[i].y + l, _mm_sub_pd(_mm_mul_pd(az, bx), _mm_mul_pd(ax, bz)));
+            _mm_store_pd(out[i].z + l, _mm_sub_pd(_mm_mul_pd(ax, by), _mm_mul_pd(ay, bx)));
+        }
+    }
+}
+
+static void normalizeSSE2(const VectorBlock* in, VectorBlock* out, size_t blocks) {
+    const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; l += 2) {
+            __m128d x = _mm_load_pd(in[i].x + l), y = _mm_load_pd(in[i].y + l), z = _mm_load_pd(in[i].z + l);
+            __m128d mag = _mm_sqrt_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)), _mm_mul_pd(z, z)));
+            __m128d inv = _mm_and_pd(_mm_div_pd(one, mag), _mm_cmpgt_pd(mag, zero));
+            _mm_store_pd(out[i].x + l, _mm_mul_pd(x, inv));
+            _mm_store_pd(out[i].y + l, _mm_mul_pd(y, inv));
+            _mm_store_pd(out[i].z + l, _mm_mul_pd(z, inv));
+        }
+    }
+}
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_MATH_HAVE_AVX_KERNEL 1
+// Compiled for AVX regardless of -march; only called when the CPU reports AVX.
+// One register holds one coordinate of a whole block.
+__attribute__((target("avx")))
+static void transformAVX(const double (*m)[3], const VectorBlock* in, VectorBlock* out, size_t blocks) {
+    __m256d m00 = _mm256_set1_pd(m[0][0]), m01 = _mm256_set1_pd(m[0][1]), m02 = _mm256_set1_pd(m[0][2]);
+    __m256d m10 = _mm256_set1_pd(m[1][0]), m11 = _mm256_set1_pd(m[1][1]), m12 = _mm256_set1_pd(m[1][2]);
+    __m256d m20 = _mm256_set1_pd(m[2][0]), m21 = _mm256_set1_pd(m[2][1]), m22 = _mm256_set1_pd(m[2][2]);
+    for (size_t b = 0; b < blocks; ++b) {
+        __m256d x = _mm256_load_pd(in[b].x), y = _mm256_load_pd(in[b].y), z = _mm256_load_pd(in[b].z);
+        _mm256_store_pd(out[b].x, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m00, x), _mm256_mul_pd(m01, y)),
+                                                _mm256_mul_pd(m02, z)));
+        _mm256_store_pd(out[b].y, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m10, x), _mm256_mul_pd(m11, y)),
+                                                _mm256_mul_pd(m12, z)));
+        _mm256_store_pd(out[b].z, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m20, x), _mm256_mul_pd(m21, y)),
+                                                _mm256_mul_pd(m22, z)));
+    }
+}
+
+__attribute__((target("avx")))
+static void dotAVX(const VectorBlock* a, const VectorBlock* b, double* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        __m256d r = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_load_pd(a[i].x), _mm256_load_pd(b[i].x)),
+                                                _mm256_mul_pd(_mm256_load_pd(a[i].y), _mm256_load_pd(b[i].y))),
+                                  _mm256_mul_pd(_mm256_load_pd(a[i].z), _mm256_load_pd(b[i].z)));
+        _mm256_storeu_pd(out + i * LANES, r);
+    }
+}
+
+__attribute__((target("avx")))
+static void crossAVX(const VectorBlock* a, const VectorBlock* b, VectorBlock* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        __m256d ax = _mm256_load_pd(a[i].x), ay = _mm256_load_pd(a[i].y), az = _mm256_load_pd(a[i].z);
+        __m256d bx = _mm256_load_pd(b[i].x), by = _mm256_load_pd(b[i].y), bz = _mm256_load_pd(b[i].z);
+        _mm256_store_pd(out[i].x, _mm256_sub_pd(_mm256_mul_pd(ay, bz), _mm256_mul_pd(az, by)));
+        _mm256_store_pd(out[i].y, _mm256_sub_pd(_mm256_mul_pd(az, bx), _mm256_mul_pd(ax, bz)));
+        _mm256_store_pd(out[i].z, _mm256_sub_pd(_mm256_mul_pd(ax, by), _mm256_mul_pd(ay, bx)));
+    }
+}
+
+__attribute__((target("avx")))
+static void normalizeAVX(const VectorBlock* in, VectorBlock* out, size_t blocks) {
+    const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    for (size_t i = 0; i < blocks; ++i) {
+        __m256d x = _mm256_load_pd(in[i].x), y = _mm256_load_pd(in[i].y), z = _mm256_load_pd(in[i].z);
+        __m256d mag = _mm256_sqrt_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)),
+                                                   _mm256_mul_pd(z, z)));
+        __m256d inv = _mm256_and_pd(_mm256_div_pd(one, mag), _mm256_cmp_pd(mag, zero, _CMP_GT_OQ));
+        _mm256_store_pd(out[i].x, _mm256_mul_pd(x, inv));
+        _mm256_store_pd(out[i].y, _mm256_mul_pd(y, inv));
+        _mm256_store_pd(out[i].z, _mm256_mul_pd(z, inv));
+    }
+}
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define BATCH_MATH_HAVE_NEON_KERNEL 1
+// AArch64 always has NEON; two lanes per register, fused multiply-add
+static void transformNEON(const double (*m)[3], const VectorBlock* in, VectorBlock* out, size_t blocks) {
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t l = 0; l < LANES; l += 2) {
+            float64x2_t x = vld1q_f64(in[b].x + l), y = vld1q_f64(in[b].y + l), z = vld1q_f64(in[b].z + l);
+            for (int row = 0; row < 3; ++row) {
+                float64x2_t r = vmulq_n_f64(x, m[row][0]);
+                r = vfmaq_n_f64(r, y, m[row][1]);
+                r = vfmaq_n_f64(r, z, m[row][2]);
+                double* target = row == 0 ? out[b].x : row == 1 ? out[b].y : out[b].z;
+                vst1q_f64(target + l, r);
+            }
+        }
+    }
+}
+
+static void dotNEON(const VectorBlock* a, const VectorBlock* b, double* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; l += 2) {
+            float64x2_t r = vmulq_f64(vld1q_f64(a[i].x + l), vld1q_f64(b[i].x + l));
+            r = vfmaq_f64(r, vld1q_f64(a[i].y + l), vld1q_f64(b[i].y + l));
+            r = vfmaq_f64(r, vld1q_f64(a[i].z + l), vld1q_f64(b[i].z + l));
+            vst1q_f64(out + i * LANES + l, r);
+        }
+    }
+}
+
+static void crossNEON(const VectorBlock* a, const VectorBlock* b, VectorBlock* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; l += 2) {
+            float64x2_t ax = vld1q_f64(a[i].x + l), ay = vld1q_f64(a[i].y + l), az = vld1q_f64(a[i].z + l);
+            float64x2_t bx = vld1q_f64(b[i].x + l), by = vld1q_f64(b[i].y + l), bz = vld1q_f64(b[i].z + l);
+            vst1q_f64(out[i].x + l, vsubq_f64(vmulq_f64(ay, bz), vmulq_f64(az, by)));
+            vst1q_f64(out[i].y + l, vsubq_f64(vmulq_f64(az, bx), vmulq_f64(ax, bz)));
+            vst1q_f64(out[i].z + l, vsubq_f64(vmulq_f64(ax, by), vmulq_f64(ay, bx)));
+        }
+    }
+}
+
+static void normalizeNEON(const VectorBlock* in, VectorBlock* out, size_t blocks) {
+    const float64x2_t zero = vdupq_n_f64(0.0), one = vdupq_n_f64(1.0);
+    for (size_t i = 0; i < blocks; ++i) {
+        for (size_t l = 0; l < LANES; l += 2) {
+            float64x2_t x = vld1q_f64(in[i].x + l), y = vld1q_f64(in[i].y + l), z = vld1q_f64(in[i].z + l);
+            float64x2_t sq = vfmaq_f64(vfmaq_f64(vmulq_f64(x, x), y, y), z, z);
+            float64x2_t mag = vsqrtq_f64(sq);
+            uint64x2_t positive = vcgtq_f64(mag, zero);
+            float64x2_t inv = vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(vdivq_f64(one, mag)), positive));
+            vst1q_f64(out[i].x + l, vmulq_f64(x, inv));
+            vst1q_f64(out[i].y + l, vmulq_f64(y, inv));
+            vst1q_f64(out[i].z + l, vmulq_f64(z, inv));
+        }
+    }
+}
+#endif
+
+MathKernel bestMathKernel() {
+#if defined(BATCH_MATH_HAVE_NEON_KERNEL)
+    return MathKernel::NEON;
+#else
+#if defined(BATCH_MATH_HAVE_AVX_KERNEL)
+    static const bool hasAVX = __builtin_cpu_supports("avx");
+    if (hasAVX) {
+        return MathKernel::AVX;
+    }
+#endif
+#if defined(__SSE2__)
+    return MathKernel::SSE2;
+#else
+    return MathKernel::Scalar;
+#endif
+#endif
+}
+
+const char* mathKernelName(MathKernel kernel) {
+    switch (kernel) {
+        case MathKernel::SSE2: return "SSE2";
+        case MathKernel::AVX: return "AVX";
+        case MathKernel::NEON: return "NEON";
+        default: return "scalar";
+    }
+}
+
+// Unavailable kernels fall through to the scalar version
+void transform(const Matrix& m, const Vector3D* in, Vector3D* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3D& v = in[i];
+        out[i] = Vector3D(m.data[0][0] * v.x + m.data[0][1] * v.y + m.data[0][2] * v.z,
+                          m.data[1][0] * v.x + m.data[1][1] * v.y + m.data[1][2] * v.z,
+                          m.data[2][0] * v.x + m.data[2][1] * v.y + m.data[2][2] * v.z);
+    }
+}
+
+void transform(const Matrix& m, const Vector3DArray& in, Vector3DArray& out, MathKernel kernel) {
+    out.resize(in.size());
+    switch (kernel) {
+#if defined(BATCH_MATH_HAVE_AVX_KERNEL)
+        case MathKernel::AVX: transformAVX(m.data, in.data(), out.data(), in.blockCount()); return;
+#endif
+#if defined(__SSE2__)
+        case MathKernel::SSE2: transformSSE2(m.data, in.data(), out.data(), in.blockCount()); return;
+#endif
+#if defined(BATCH_MATH_HAVE_NEON_KERNEL)
+        case MathKernel::NEON: transformNEON(m.data, in.data(), out.data(), in.blockCount()); return;
+#endif
+        default: transformScalar(m.data, in.data(), out.data(), in.blockCount()); return;
+    }
+}
+
+void dot(const Vector3DArray& a, const Vector3DArray& b, std::vector<double>& out, MathKernel kernel) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("dot: batch sizes differ");
+    }
+    out.resize(a.blockCount() * LANES);  // Kernels store whole blocks
+    switch (kernel) {
+#if defined(BATCH_MATH_HAVE_AVX_KERNEL)
+        case MathKernel::AVX: dotAVX(a.data(), b.data(), out.data(), a.blockCount()); break;
+#endif
+#if defined(__SSE2__)
+        case MathKernel::SSE2: dotSSE2(a.data(), b.data(), out.data(), a.blockCount()); break;
+#endif
+#if defined(BATCH_MATH_HAVE_NEON_KERNEL)
+        case MathKernel::NEON: dotNEON(a.data(), b.data(), out.data(), a.blockCount()); break;
+#endif
+        default: dotScalar(a.data(), b.data(), out.data(), a.blockCount()); break;
+    }
+    out.resize(a.size());
+}
+
+void cross(const Vector3DArray& a, const Vector3DArray& b, Vector3DArray& out, MathKernel kernel) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("cross: batch sizes differ");
+    }
+    out.resize(a.size());
+    switch (kernel) {
+#if defined(BATCH_MATH_HAVE_AVX_KERNEL)
+        case MathKernel::AVX: crossAVX(a.data(), b.data(), out.data(), a.blockCount()); return;
+#endif
+#if defined(__SSE2__)
+        case MathKernel::SSE2: crossSSE2(a.data(), b.data(), out.data(), a.blockCount()); return;
+#endif
+#if defined(BATCH_MATH_HAVE_NEON_KERNEL)
+        case MathKernel::NEON: crossNEON(a.data(), b.data(), out.data(), a.blockCount()); return;
+#endif
+        default: crossScalar(a.data(), b.data(), out.data(), a.blockCount()); return;
+    }
+}
+
+void normalize(const Vector3DArray& in, Vector3DArray& out, MathKernel kernel) {
+    out.resize(in.size());
+    switch (kernel) {
+#if defined(BATCH_MATH_HAVE_AVX_KERNEL)
+        case MathKernel::AVX: normalizeAVX(in.data(), out.data(), in.blockCount()); return;
+#endif
+#if defined(__SSE2__)
+        case MathKernel::SSE2: normalizeSSE2(in.data(), out.data(), in.blockCount()); return;
+#endif
+#if defined(BATCH_MATH_HAVE_NEON_KERNEL)
+        case MathKernel::NEON: normalizeNEON(in.data(), out.data(), in.blockCount()); return;
+#endif
+        default: normalizeScalar(in.data(), out.data(), in.blockCount()); return;
+    }
+}
+
+// MatrixNxM implementation
+MatrixNxM::MatrixNxM(size_t r, size_t c, double fill) : rows(r), cols(c), values(r * c, fill) {}
+
+MatrixNxM MatrixNxM::multiplyNaive(const MatrixNxM& a, const MatrixNxM& b) {
+    if (a.cols != b.rows) {
+        throw std::invalid_argument("MatrixNxM: inner dimensions differ");
+    }
+    MatrixNxM result(a.rows, b.cols);
+    for (size_t i = 0; i < a.rows; ++i) {
+        for (size_t j = 0; j < b.cols; ++j) {
+            double sum = 0;
+            for (size_t k = 0; k < a.cols; ++k) {
+                sum += a(i, k) * b(k, j);
+            }
+            result(i, j) = sum;
+        }
+    }
+    return result;
+}
+
+MatrixNxM MatrixNxM::multiplyBlocked(const MatrixNxM& a, const MatrixNxM& b, size_t blockSize) {
+    if (a.cols != b.rows) {
+        throw std::invalid_argument("MatrixNxM: inner dimensions differ");
+    }
+    MatrixNxM result(a.rows, b.cols);
+    const size_t n = a.rows, inner = a.cols, m = b.cols;
+    for (size_t ii = 0; ii < n; ii += blockSize) {
+        const size_t iEnd = std::min(ii + blockSize, n);
+        for (size_t kk = 0; kk < inner; kk += blockSize) {
+            const size_t kEnd = std::min(kk + blockSize, inner);
+            for (size_t jj = 0; jj < m; jj += blockSize) {
+                const size_t jEnd = std::min(jj + blockSize, m);
+                for (size_t i = ii; i < iEnd; ++i) {
+                    double* out = &result.values[i * m];
+                    for (size_t k = kk; k < kEnd; ++k) {
+                        const double aik = a.values[i * inner + k];
+                        const double* bRow = &b.values[k * m];
+                        for (size_t j = jj; j < jEnd; ++j) {
+                            out[j] += aik * bRow[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+MatrixNxM operator*(const MatrixNxM& a, const MatrixNxM& b) {
+    return MatrixNxM::multiplyBlocked(a, b);
+}
+
+// Vector3DArray expression operators
+template<typename L, typename R>
+Vec3Binary<L, R, Vec3AddOp> operator+(const Vec3Expr<L>& l, const Vec3Expr<R>& r) {
+    return Vec3Binary<L, R, Vec3AddOp>(static_cast<const L&>(l), static_cast<const R&>(r));
+}
+
+template<typename L, typename R>
+Vec3Binary<L, R, Vec3SubOp> operator-(const Vec3Expr<L>& l, const Vec3Expr<R>& r) {
+    return Vec3Binary<L, R, Vec3SubOp>(static_cast<const L&>(l), static_cast<const R&>(r));
+}
+
+template<typename E>
+Vec3Scaled<E> operator*(double scalar, const Vec3Expr<E>& e) {
+    return Vec3Scaled<E>(scalar, static_cast<const E&>(e));
+}
+
+template<typename E>
+Vec3Scaled<E> operator*(const Vec3Expr<E>& e, double scalar) {
+    return Vec3Scaled<E>(scalar, static_cast<const E&>(e));
+}
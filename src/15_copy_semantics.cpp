@@ -15,6 +15,15 @@
 #include <vector>
 #include <cstring>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <chrono>
+#include <iomanip>
 
 // TODO: Implement these classes demonstrating different copy semantics
 
@@ -48,39 +57,76 @@ public:
 };
 
 // 2. Resource-owning class requiring deep copy
-class DynamicArray {
+// Elements live in raw storage and are constructed in place. Growth is
+// geometric (growthFactor, default 2.0); reallocation uses memcpy for
+// trivially copyable T and std::move_if_noexcept otherwise, so a throwing
+// copy leaves the old buffer intact. Up to InlineCapacity elements are kept
+// in an inline buffer without touching the heap (like small_vector<T, N>).
+template<typename T = int, size_t InlineCapacity = 0>
+class BasicDynamicArray {
 private:
-    int* data;
+    T* data;
     size_t size;
     size_t capacity;
+    double growthFactor;
+    alignas(T) unsigned char inlineBuffer[InlineCapacity == 0 ? 1 : InlineCapacity * sizeof(T)];
     
 public:
-    DynamicArray(size_t cap = 10);
+    BasicDynamicArray(size_t cap = 10, double growth = 2.0);
     
     // Copy constructor (deep copy)
-    DynamicArray(const DynamicArray& other);
+    BasicDynamicArray(const BasicDynamicArray& other);
     
     // Copy assignment operator (deep copy)
-    DynamicArray& operator=(const DynamicArray& other);
+    BasicDynamicArray& operator=(const BasicDynamicArray& other);
     
-    // Destructor
-    ~DynamicArray();
+    // Move operations steal heap buffers; inline elements are moved one by one
+    BasicDynamicArray(BasicDynamicArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    BasicDynamicArray& operator=(BasicDynamicArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
     
-    void push_back(int value);
-    int& operator[](size_t index);
-    const int& operator[](size_t index) const;
+    // Destructor
+    ~BasicDynamicArray();
+    
+    void push_back(const T& value);
+    void push_back(T&& value);
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+    template<typename InputIt>
+    void append(InputIt first, InputIt last);
+    void pop_back();
+    void clear();
+    
+    void reserve(size_t newCapacity);
+    void shrink_to_fit();
+    
+    T& operator[](size_t index);
+    const T& operator[](size_t index) const;
+    T* begin() { return data; }
+    T* end() { return data + size; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
     
     size_t getSize() const;
     size_t getCapacity() const;
+    bool isInline() const;
     
     void print() const;
     
 private:
-    void resize();
+    T* inlineData();
+    T* allocate(size_t n);
+    void deallocate(T* ptr);
+    size_t grownCapacity(size_t required) const;
+    void reallocate(size_t newCapacity);
+    template<typename... Args>
+    T& emplaceSlow(Args&&... args);
+    static void relocate(T* from, size_t count, T* to);
     void cleanup();
-    void copyFrom(const DynamicArray& other);
+    void copyFrom(const BasicDynamicArray& other);
 };
 
+using DynamicArray = BasicDynamicArray<int>;
+
 // 3. Class demonstrating shallow vs deep copy issues
 class BadCopyClass {
 private:
@@ -151,19 +197,38 @@ public:
 };
 
 // 5. Smart copy class with reference counting (shared ownership)
+// Values live in fixed-size pages reached through a page table; both levels
+// are shared and reference counted with atomics. A write clones the page
+// table (pointers only) if it is shared, then only the page it touches.
+// Like std::shared_ptr, separate SharedData objects may be used from
+// different threads; one object must not be written concurrently.
 class SharedData {
+public:
+    static constexpr size_t DefaultPageSize = 256;
+    
 private:
-    struct DataBlock {
+    struct Page {
+        std::atomic<int> refCount;
         std::vector<int> values;
-        int refCount;
         
-        DataBlock(const std::vector<int>& vals) : values(vals), refCount(1) {}
+        Page(std::vector<int> vals) : refCount(1), values(std::move(vals)) {}
+    };
+    
+    struct DataBlock {
+        std::vector<Page*> pages;
+        size_t size;
+        size_t pageSize;
+        std::atomic<int> refCount;
+        
+        DataBlock(size_t n, size_t perPage) : size(n), pageSize(perPage), refCount(1) {}
     };
     
     DataBlock* dataPtr;
     
+    inline static std::atomic<size_t> bytesCopied{0};
+    
 public:
-    SharedData(const std::vector<int>& values);
+    SharedData(const std::vector<int>& values, size_t pageSize = DefaultPageSize);
     
     // Copy constructor (shares data)
     SharedData(const SharedData& other);
@@ -177,13 +242,20 @@ public:
     // Copy-on-write modification
     void modify(size_t index, int value);
     
-    const std::vector<int>& getData() const;
+    int get(size_t index) const;
+    size_t size() const;
+    std::vector<int> toVector() const;
     int getRefCount() const;
+    size_t getPageCount() const;
     void print() const;
     
+    // Bytes cloned by copy-on-write across all SharedData objects
+    static size_t getBytesCopied();
+    
 private:
     void release();
-    void detach(); // For copy-on-write
+    void detach(size_t index); // For copy-on-write
+    static void releasePage(Page* page);
 };
 
 // Function prototypes for demonstrations
@@ -196,11 +268,12 @@ void demonstrateCopySemantics();
 void demonstrateCopyOnlyClasses();
 void demonstrateSharedCopy();
 void compareCopyVsMove();
+void demonstrateGrowthAndSmallBuffer();
+void benchmarkPushBack();
+void benchmarkSharedDataCow();
 
 int main() {
-    std::cout << "=== Copy Semantics Examples ===
-
-";
+    std::cout << "=== Copy Semantics Examples ===\n\n";
     
     // TODO: Call these functions to demonstrate concepts
     demonstrateSimpleCopy();
@@ -212,14 +285,16 @@ int main() {
     demonstrateCopyOnlyClasses();
     demonstrateSharedCopy();
     compareCopyVsMove();
+    demonstrateGrowthAndSmallBuffer();
+    benchmarkPushBack();
+    benchmarkSharedDataCow();
     
     return 0;
 }
 
 // TODO: Implement these demonstration functions
 void demonstrateSimpleCopy() {
-    std::cout << "1. Simple Copy Semantics:
-";
+    std::cout << "1. Simple Copy Semantics:\n";
     
     // TODO: Show basic copy constructor and assignment
     SimpleClass obj1(42, "Original");
@@ -241,21 +316,17 @@ void demonstrateSimpleCopy() {
     obj1.setValue(100);
     obj1.setName("Modified");
     
-    std::cout << "After modifying original:
-";
+    std::cout << "After modifying original:\n";
     std::cout << "Original: ";
     obj1.print();
     std::cout << "Copy: ";
     obj2.print();
     
-    std::cout << "---
-
-";
+    std::cout << "---\n\n";
 }
 
 void demonstrateDeepCopy() {
-    std::cout << "2. Deep Copy with Dynamic Memory:
-";
+    std::cout << "2. Deep Copy with Dynamic Memory:\n";
     
     // TODO: Show deep copy necessity with dynamic memory
     DynamicArray arr1(5);
@@ -275,50 +346,39 @@ void demonstrateDeepCopy() {
     arr1.push_back(40);
     arr1[0] = 999;
     
-    std::cout << "After modifying original:
-";
+    std::cout << "After modifying original:\n";
     std::cout << "Original: ";
     arr1.print();
     std::cout << "Copy: ";
     arr2.print();
     
-    std::cout << "---
-
-";
+    std::cout << "---\n\n";
 }
 
 void demonstrateShallowCopyProblems() {
-    std::cout << "3. Shallow Copy Problems:
-";
+    std::cout << "3. Shallow Copy Problems:\n";
     
     // TODO: Show problems with shallow copy
-    std::cout << "Demonstrating why shallow copy is dangerous with raw pointers
-";
-    std::cout << "This would cause double deletion if we used default copy constructor
-";
+    std::cout << "Demonstrating why shallow copy is dangerous with raw pointers\n";
+    std::cout << "This would cause double deletion if we used default copy constructor\n";
     
     // Instead, show the proper implementation
     GoodCopyClass good1("Hello World");
     GoodCopyClass good2 = good1;
     
-    std::cout << "Good copy implementation:
-";
+    std::cout << "Good copy implementation:\n";
     std::cout << "Original: ";
     good1.print();
     std::cout << "Copy: ";
     good2.print();
     
-    std::cout << "Both objects can be safely destroyed
-";
+    std::cout << "Both objects can be safely destroyed\n";
     
-    std::cout << "---
-
-";
+    std::cout << "---\n\n";
 }
 
 void demonstrateCopyOptimization() {
-    std::cout << "4. Copy Optimization (RVO/NRVO):
-";
+    std::cout << "4. Copy Optimization (RVO/NRVO):\n";
     
     // TODO: Show Return Value Optimization
     auto createObject = []() -> SimpleClass {
@@ -330,30 +390,21 @@ void demonstrateCopyOptimization() {
     std::cout << "RVO object: ";
     obj.print();
     
-    std::cout << "Note: Modern compilers optimize away unnecessary copies
-";
+    std::cout << "Note: Modern compilers optimize away unnecessary copies\n";
     
-    std::cout << "---
-
-";
+    std::cout << "---\n\n";
 }
 
 void demonstrateRuleOfThree() {
-    std::cout << "5. Rule of Three:
-";
+    std::cout << "5. Rule of Three:\n";
     
     // TODO: Explain and demonstrate Rule of Three
-    std::cout << "Rule of Three: If you need one of these, you probably need all three:
-";
-    std::cout << "1. Destructor
-";
-    std::cout << "2. Copy constructor
-";
-    std::cout << "3. Copy assignment operator
-";
-    
-    std::cout << "DynamicArray class implements all three:
-";
+    std::cout << "Rule of Three: If you need one of these, you probably need all three:\n";
+    std::cout << "1. Destructor\n";
+    std::cout << "2. Copy constructor\n";
+    std::cout << "3. Copy assignment operator\n";
+    
+    std::cout << "DynamicArray class implements all three:\n";
     
     DynamicArray* arr = new DynamicArray(3);
     arr->push_back(1);
@@ -365,21 +416,16 @@ void demonstrateRuleOfThree() {
     
     delete arr;               // Destructor called
     
-    std::cout << "All operations completed safely
-";
+    std::cout << "All operations completed safely\n";
     
-    std::cout << "---
-
-";
+    std::cout << "---\n\n";
 }
 
 void demonstrateCopySemantics() {
-    std::cout << "6. Copy Semantics Behavior:
-";
+    std::cout << "6. Copy Semantics Behavior:\n";
     
     // TODO: Show different copy scenarios
-    std::cout << "Copy by value (expensive for large objects):
-";
+    std::cout << "Copy by value (expensive for large objects):\n";
     
     auto passByValue = [](DynamicArray arr) {
         std::cout << "Inside function: ";
@@ -396,22 +442,17 @@ void demonstrateCopySemantics() {
     original.push_back(2);
     original.push_back(3);
     
-    std::cout << "Passing by value (triggers copy):
-";
+    std::cout << "Passing by value (triggers copy):\n";
     passByValue(original);
     
-    std::cout << "Passing by reference (no copy):
-";
+    std::cout << "Passing by reference (no copy):\n";
     passByReference(original);
     
-    std::cout << "---
-
-";
+    std::cout << "---\n\n";
 }
 
 void demonstrateCopyOnlyClasses() {
-    std::cout << "7. Copy-Only Classes:
-";
+    std::cout << "7. Copy-Only Classes:\n";
     
     // TODO: Show classes that can only be copied, not moved
     CopyOnlyClass obj1(5);
@@ -429,17 +470,13 @@ void demonstrateCopyOnlyClasses() {
     // Cannot move (would cause compile error)
     // CopyOnlyClass obj3 = std::move(obj1); // Error!
     
-    std::cout << "This class explicitly disables move semantics
-";
+    std::cout << "This class explicitly disables move semantics\n";
     
-    std::cout << "---
-
-";
+    std::cout << "---\n\n";
 }
 
 void demonstrateSharedCopy() {
-    std::cout << "8. Shared Copy (Reference Counting):
-";
+    std::cout << "8. Shared Copy (Reference Counting):\n";
     
     // TODO: Show copy with shared ownership
     SharedData data1({1, 2, 3, 4, 5});
@@ -448,55 +485,692 @@ void demonstrateSharedCopy() {
     
     // Copy shares the data
     SharedData data2 = data1;
-    std::cout << "After copy - Ref count: " << data1.getRefCount() << "
-";
+    std::cout << "After copy - Ref count: " << data1.getRefCount() << "\n";
     
     // Copy-on-write: modifying one doesn't affect the other
     data2.modify(0, 999);
     
-    std::cout << "After modification:
-";
+    std::cout << "After modification:\n";
     std::cout << "Data1: ";
     data1.print();
     std::cout << "Data2: ";
     data2.print();
     
-    std::cout << "---
-
-";
+    // Only the touched page is cloned; the rest stays shared
+    std::vector<int> large(4096);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<int>(i);
+    }
+    SharedData big1(large, 256);
+    SharedData big2 = big1;
+    size_t before = SharedData::getBytesCopied();
+    big2.modify(1000, -1);
+    std::cout << "4096 ints in " << big1.getPageCount() << " pages: one write copied "
+              << SharedData::getBytesCopied() - before << " bytes (whole vector is "
+              << large.size() * sizeof(int) << "); big1[1000] = " << big1.get(1000)
+              << ", big2[1000] = " << big2.get(1000) << "\n";
+    
+    std::cout << "---\n\n";
 }
 
 void compareCopyVsMove() {
-    std::cout << "9. Copy vs Move Semantics:
-";
+    std::cout << "9. Copy vs Move Semantics:\n";
     
     // TODO: Compare copy and move operations
-    std::cout << "Copy semantics:
-";
-    std::cout << "- Creates independent copy of data
-";
-    std::cout << "- Original object remains valid
-";
-    std::cout << "- More expensive for large objects
-";
-    std::cout << "- Safe for all scenarios
-";
-    
-    std::cout << "
-Move semantics:
-";
-    std::cout << "- Transfers ownership of resources
-";
-    std::cout << "- Original object becomes invalid
-";
-    std::cout << "- More efficient for large objects
-";
-    std::cout << "- Requires careful design
-";
-    
-    std::cout << "---
-
-";
+    std::cout << "Copy semantics:\n";
+    std::cout << "- Creates independent copy of data\n";
+    std::cout << "- Original object remains valid\n";
+    std::cout << "- More expensive for large objects\n";
+    std::cout << "- Safe for all scenarios\n";
+    
+    std::cout << "\nMove semantics:\n";
+    std::cout << "- Transfers ownership of resources\n";
+    std::cout << "- Original object becomes invalid\n";
+    std::cout << "- More efficient for large objects\n";
+    std::cout << "- Requires careful design\n";
+    
+    std::cout << "---\n\n";
+}
+
+void demonstrateGrowthAndSmallBuffer() {
+    std::cout << "10. Growth Policy, reserve/shrink_to_fit and Small Buffer:\n";
+    
+    // Capacity sequence for different growth factors
+    for (double growth : {2.0, 1.5}) {
+        DynamicArray arr(1, growth);
+        size_t lastCapacity = arr.getCapacity();
+        std::cout << "growth " << growth << ", capacities: " << lastCapacity;
+        for (int i = 0; i < 100; ++i) {
+            arr.push_back(i);
+            if (arr.getCapacity() != lastCapacity) {
+                lastCapacity = arr.getCapacity();
+                std::cout << " " << lastCapacity;
+            }
+        }
+        std::cout << "\n";
+    }
+    
+    DynamicArray reserved(0);
+    reserved.reserve(64);
+    int values[] = {1, 2, 3, 4, 5};
+    reserved.append(std::begin(values), std::end(values));
+    std::cout << "after reserve(64) + append(5): size " << reserved.getSize()
+              << ", capacity " << reserved.getCapacity() << "\n";
+    reserved.shrink_to_fit();
+    std::cout << "after shrink_to_fit: capacity " << reserved.getCapacity() << ", contents ";
+    reserved.print();
+    
+    // Inline buffer: the first N elements never touch the heap
+    BasicDynamicArray<std::string, 4> names(0);
+    names.emplace_back("small");
+    names.emplace_back(3, 'x');
+    std::cout << "BasicDynamicArray<std::string, 4> with " << names.getSize() << " elements, inline: "
+              << std::boolalpha << names.isInline();
+    for (const char* extra : {"spills", "to", "heap"}) {
+        names.emplace_back(extra);
+    }
+    std::cout << "; with " << names.getSize() << " elements, inline: " << names.isInline();
+    names.pop_back();
+    names.pop_back();
+    names.shrink_to_fit();
+    std::cout << "; after pop_back x2 + shrink_to_fit, inline: " << names.isInline() << std::noboolalpha << "\n";
+    names.print();
+    
+    std::cout << "---\n\n";
+}
+
+// Non-trivial element with a noexcept move: relocation moves instead of copying
+struct BenchPayload {
+    std::string text;
+    BenchPayload(int i = 0) : text(std::to_string(i) + " padded past the SSO limit") {}
+};
+
+template<typename Container, typename Fill>
+static double timePushBackMs(int repeats, Fill fill) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        Container c(0);
+        fill(c);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+static void reportPushBack(const char* label, double dynamicMs, double vectorMs) {
+    std::cout << std::left << std::setw(42) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << dynamicMs << std::setw(12) << vectorMs << "\n" << std::defaultfloat;
+}
+
+void benchmarkPushBack() {
+    std::cout << "11. push_back Benchmark (BasicDynamicArray vs std::vector):\n";
+    constexpr int N = 1000000;
+    constexpr int REPEATS = 20;
+    
+    std::cout << std::left << std::setw(42) << "Workload" << std::right << std::setw(12) << "Dynamic ms"
+              << std::setw(12) << "vector ms" << "\n";
+    
+    auto pushInts = [](auto& c) {
+        for (int i = 0; i < N; ++i) {
+            c.push_back(i);
+        }
+    };
+    reportPushBack("1M int push_back",
+                   timePushBackMs<BasicDynamicArray<int>>(REPEATS, pushInts),
+                   timePushBackMs<std::vector<int>>(REPEATS, pushInts));
+    
+    auto reservedInts = [](auto& c) {
+        c.reserve(N);
+        for (int i = 0; i < N; ++i) {
+            c.push_back(i);
+        }
+    };
+    reportPushBack("1M int push_back after reserve",
+                   timePushBackMs<BasicDynamicArray<int>>(REPEATS, reservedInts),
+                   timePushBackMs<std::vector<int>>(REPEATS, reservedInts));
+    
+    auto emplaceStrings = [](auto& c) {
+        for (int i = 0; i < N / 10; ++i) {
+            c.emplace_back(i);
+        }
+    };
+    reportPushBack("100K std::string emplace_back",
+                   timePushBackMs<BasicDynamicArray<BenchPayload>>(REPEATS / 4, emplaceStrings),
+                   timePushBackMs<std::vector<BenchPayload>>(REPEATS / 4, emplaceStrings));
+    
+    // Many short-lived small arrays: the inline buffer avoids the heap entirely
+    constexpr int SMALL_ARRAYS = 100000;
+    auto smallArrays = [](auto& c) {
+        using Small = std::decay_t<decltype(c)>;
+        for (int a = 0; a < SMALL_ARRAYS; ++a) {
+            Small small(0);
+            for (int i = 0; i < 8; ++i) {
+                small.push_back(a + i);
+            }
+            c.push_back(small[7]);
+            c.pop_back();
+        }
+    };
+    reportPushBack("100K arrays of 8 ints (inline N = 8)",
+                   timePushBackMs<BasicDynamicArray<int, 8>>(REPEATS / 4, smallArrays),
+                   timePushBackMs<std::vector<int>>(REPEATS / 4, smallArrays));
+    
+    std::cout << "---\n\n";
+}
+
+// Readers repeatedly take a snapshot of the published data and read from it
+// without a lock; the writer modifies its own copy and republishes it
+void benchmarkSharedDataCow() {
+    std::cout << "12. Copy-on-Write SharedData: Multi-Reader / Single-Writer Benchmark:\n";
+    constexpr size_t ELEMENTS = 1 << 20;
+    constexpr int READERS = 3;
+    constexpr auto DURATION = std::chrono::milliseconds(300);
+    
+    std::vector<int> initial(ELEMENTS);
+    for (size_t i = 0; i < ELEMENTS; ++i) {
+        initial[i] = static_cast<int>(i);
+    }
+    
+    std::cout << ELEMENTS << " ints, " << READERS << " readers, 1 writer, "
+              << DURATION.count() << " ms per page size\n";
+    std::cout << std::left << std::setw(22) << "Page size" << std::right << std::setw(14) << "writes/s"
+              << std::setw(16) << "snapshots/s" << std::setw(20) << "bytes copied/write" << "\n";
+    
+    for (size_t pageSize : {ELEMENTS, size_t(16384), size_t(1024), size_t(256)}) {
+        SharedData published(initial, pageSize);
+        std::mutex publishMutex;
+        std::atomic<bool> running{true};
+        std::atomic<long long> snapshots{0};
+        std::atomic<long long> checksum{0};
+        
+        std::vector<std::thread> readers;
+        for (int r = 0; r < READERS; ++r) {
+            readers.emplace_back([&, r]() {
+                long long local = 0;
+                long long taken = 0;
+                size_t index = static_cast<size_t>(r) * 7919;
+                while (running.load(std::memory_order_relaxed)) {
+                    std::unique_lock<std::mutex> lock(publishMutex);
+                    SharedData snapshot = published;
+                    lock.unlock();
+                    for (int i = 0; i < 64; ++i) {
+                        index = (index + 4099) % ELEMENTS;
+                        local += snapshot.get(index);
+                    }
+                    ++taken;
+                }
+                snapshots.fetch_add(taken);
+                checksum.fetch_add(local);
+            });
+        }
+        
+        SharedData working = published;
+        size_t bytesBefore = SharedData::getBytesCopied();
+        long long writes = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < DURATION) {
+            working.modify(static_cast<size_t>(writes * 9973) % ELEMENTS, static_cast<int>(writes));
+            std::lock_guard<std::mutex> lock(publishMutex);
+            published = working;
+            ++writes;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t copied = SharedData::getBytesCopied() - bytesBefore;
+        running.store(false);
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        
+        std::string label = pageSize == ELEMENTS ? "whole vector" : std::to_string(pageSize) + " ints";
+        std::cout << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(14) << writes / seconds << std::setw(16) << snapshots.load() / seconds
+                  << std::setw(20) << static_cast<double>(copied) / (writes ? writes : 1) << "\n"
+                  << std::defaultfloat;
+    }
+    std::cout << "Smaller pages copy less data, but a write after publishing clones the page table\n"
+              << "and bumps every page's count, so per-write cost is O(pages) + O(page size)\n";
+    
+    std::cout << "---\n\n";
 }
 
 // TODO: Implement all class methods
+
+// BasicDynamicArray implementation
+template<typename T, size_t InlineCapacity>
+BasicDynamicArray<T, InlineCapacity>::BasicDynamicArray(size_t cap, double growth)
+    : data(inlineData()), size(0), capacity(InlineCapacity), growthFactor(growth > 1.0 ? growth : 2.0) {
+    if (cap > InlineCapacity) {
+        data = allocate(cap);
+        capacity = cap;
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+BasicDynamicArray<T, InlineCapacity>::BasicDynamicArray(const BasicDynamicArray& other)
+    : data(inlineData()), size(0), capacity(InlineCapacity), growthFactor(other.growthFactor) {
+    copyFrom(other);
+}
+
+template<typename T, size_t InlineCapacity>
+BasicDynamicArray<T, InlineCapacity>& BasicDynamicArray<T, InlineCapacity>::operator=(const BasicDynamicArray& other) {
+    if (this != &other) {
+        // Copy into a fresh array first so a throwing element copy leaves *this unchanged
+        BasicDynamicArray copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template<typename T, size_t InlineCapacity>
+BasicDynamicArray<T, InlineCapacity>::BasicDynamicArray(BasicDynamicArray&& other)
+    noexcept(std::is_nothrow_move_constructible_v<T>)
+    : data(inlineData()), size(0), capacity(InlineCapacity), growthFactor(other.growthFactor) {
+    if (other.isInline()) {
+        relocate(other.data, other.size, data);
+        size = other.size;
+    } else {
+        data = other.data;
+        size = other.size;
+        capacity = other.capacity;
+        other.data = other.inlineData();
+        other.capacity = InlineCapacity;
+    }
+    other.size = 0;
+}
+
+template<typename T, size_t InlineCapacity>
+BasicDynamicArray<T, InlineCapacity>& BasicDynamicArray<T, InlineCapacity>::operator=(BasicDynamicArray&& other)
+    noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+        cleanup();
+        growthFactor = other.growthFactor;
+        if (other.isInline()) {
+            relocate(other.data, other.size, data);
+            size = other.size;
+        } else {
+            data = other.data;
+            size = other.size;
+            capacity = other.capacity;
+            other.data = other.inlineData();
+            other.capacity = InlineCapacity;
+        }
+        other.size = 0;
+    }
+    return *this;
+}
+
+template<typename T, size_t InlineCapacity>
+BasicDynamicArray<T, InlineCapacity>::~BasicDynamicArray() {
+    cleanup();
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+template<typename T, size_t InlineCapacity>
+template<typename... Args>
+T& BasicDynamicArray<T, InlineCapacity>::emplace_back(Args&&... args) {
+    if (size == capacity) {
+        return emplaceSlow(std::forward<Args>(args)...);
+    }
+    T* slot = new (data + size) T(std::forward<Args>(args)...);
+    ++size;
+    return *slot;
+}
+
+// The new element is constructed before the old ones are relocated, so
+// arguments referring into the array (arr.push_back(arr[0])) stay valid
+template<typename T, size_t InlineCapacity>
+template<typename... Args>
+T& BasicDynamicArray<T, InlineCapacity>::emplaceSlow(Args&&... args) {
+    const size_t newCapacity = grownCapacity(size + 1);
+    T* newData = allocate(newCapacity);
+    T* slot;
+    try {
+        slot = new (newData + size) T(std::forward<Args>(args)...);
+    } catch (...) {
+        deallocate(newData);
+        throw;
+    }
+    try {
+        relocate(data, size, newData);
+    } catch (...) {
+        slot->~T();
+        deallocate(newData);
+        throw;
+    }
+    deallocate(data);
+    data = newData;
+    capacity = newCapacity;
+    ++size;
+    return *slot;
+}
+
+template<typename T, size_t InlineCapacity>
+template<typename InputIt>
+void BasicDynamicArray<T, InlineCapacity>::append(InputIt first, InputIt last) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+        // Length is known up front: at most one reallocation
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (size + count > capacity) {
+            reallocate(grownCapacity(size + count));
+        }
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<InputIt> &&
+                      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T>) {
+            if (count > 0) {
+                std::memcpy(data + size, first, count * sizeof(T));
+            }
+            size += count;
+        } else {
+            for (; first != last; ++first) {
+                new (data + size) T(*first);
+                ++size;
+            }
+        }
+    } else {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::pop_back() {
+    if (size > 0) {
+        --size;
+        data[size].~T();
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (size_t i = 0; i < size; ++i) {
+            data[i].~T();
+        }
+    }
+    size = 0;
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::reserve(size_t newCapacity) {
+    if (newCapacity > capacity) {
+        reallocate(newCapacity);
+    }
+}
+
+// Moves back into the inline buffer when everything fits there
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::shrink_to_fit() {
+    if (isInline() || size == capacity) {
+        return;
+    }
+    if (size <= InlineCapacity) {
+        relocate(data, size, inlineData());
+        deallocate(data);
+        data = inlineData();
+        capacity = InlineCapacity;
+    } else {
+        reallocate(size);
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+T& BasicDynamicArray<T, InlineCapacity>::operator[](size_t index) {
+    return data[index];
+}
+
+template<typename T, size_t InlineCapacity>
+const T& BasicDynamicArray<T, InlineCapacity>::operator[](size_t index) const {
+    return data[index];
+}
+
+template<typename T, size_t InlineCapacity>
+size_t BasicDynamicArray<T, InlineCapacity>::getSize() const {
+    return size;
+}
+
+template<typename T, size_t InlineCapacity>
+size_t BasicDynamicArray<T, InlineCapacity>::getCapacity() const {
+    return capacity;
+}
+
+template<typename T, size_t InlineCapacity>
+bool BasicDynamicArray<T, InlineCapacity>::isInline() const {
+    return data == reinterpret_cast<const T*>(inlineBuffer);
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::print() const {
+    std::cout << "[";
+    for (size_t i = 0; i < size; ++i) {
+        std::cout << (i ? ", " : "") << data[i];
+    }
+    std::cout << "] (size " << size << ", capacity " << capacity << ")\n";
+}
+
+template<typename T, size_t InlineCapacity>
+T* BasicDynamicArray<T, InlineCapacity>::inlineData() {
+    return reinterpret_cast<T*>(inlineBuffer);
+}
+
+template<typename T, size_t InlineCapacity>
+T* BasicDynamicArray<T, InlineCapacity>::allocate(size_t n) {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::deallocate(T* ptr) {
+    if (ptr == inlineData()) {
+        return;
+    }
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(ptr, std::align_val_t(alignof(T)));
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+size_t BasicDynamicArray<T, InlineCapacity>::grownCapacity(size_t required) const {
+    size_t grown = static_cast<size_t>(static_cast<double>(capacity) * growthFactor);
+    return std::max({grown, capacity + 1, required});
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::reallocate(size_t newCapacity) {
+    T* newData = allocate(newCapacity);
+    try {
+        relocate(data, size, newData);
+    } catch (...) {
+        deallocate(newData);
+        throw;
+    }
+    deallocate(data);
+    data = newData;
+    capacity = newCapacity;
+}
+
+// Moves count elements from `from` into uninitialized `to` and destroys the
+// originals. If a copy throws, everything built so far is destroyed and
+// `from` is left untouched (strong guarantee).
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::relocate(T* from, size_t count, T* to) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (count > 0) {
+            std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+        }
+    } else {
+        size_t built = 0;
+        try {
+            for (; built < count; ++built) {
+                new (to + built) T(std::move_if_noexcept(from[built]));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < built; ++i) {
+                to[i].~T();
+            }
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            from[i].~T();
+        }
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::cleanup() {
+    clear();
+    deallocate(data);
+    data = inlineData();
+    capacity = InlineCapacity;
+}
+
+// Deep copy into an empty array; sizes the buffer exactly once
+template<typename T, size_t InlineCapacity>
+void BasicDynamicArray<T, InlineCapacity>::copyFrom(const BasicDynamicArray& other) {
+    if (other.size > capacity) {
+        data = allocate(other.capacity);
+        capacity = other.capacity;
+    }
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (other.size > 0) {
+            std::memcpy(static_cast<void*>(data), other.data, other.size * sizeof(T));
+        }
+        size = other.size;
+    } else {
+        try {
+            for (; size < other.size; ++size) {
+                new (data + size) T(other.data[size]);
+            }
+        } catch (...) {
+            cleanup();
+            throw;
+        }
+    }
+}
+
+// SharedData implementation
+SharedData::SharedData(const std::vector<int>& values, size_t pageSize)
+    : dataPtr(new DataBlock(values.size(), pageSize == 0 ? DefaultPageSize : pageSize)) {
+    const size_t perPage = dataPtr->pageSize;
+    for (size_t start = 0; start < values.size(); start += perPage) {
+        size_t end = std::min(values.size(), start + perPage);
+        dataPtr->pages.push_back(new Page(std::vector<int>(values.begin() + start, values.begin() + end)));
+    }
+}
+
+// Taking another reference needs no ordering: the source keeps the block alive
+SharedData::SharedData(const SharedData& other) : dataPtr(other.dataPtr) {
+    dataPtr->refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+SharedData& SharedData::operator=(const SharedData& other) {
+    if (dataPtr != other.dataPtr) {
+        other.dataPtr->refCount.fetch_add(1, std::memory_order_relaxed);
+        release();
+        dataPtr = other.dataPtr;
+    }
+    return *this;
+}
+
+SharedData::~SharedData() {
+    release();
+}
+
+void SharedData::modify(size_t index, int value) {
+    if (index >= dataPtr->size) {
+        return;
+    }
+    detach(index);
+    dataPtr->pages[index / dataPtr->pageSize]->values[index % dataPtr->pageSize] = value;
+}
+
+int SharedData::get(size_t index) const {
+    return dataPtr->pages[index / dataPtr->pageSize]->values[index % dataPtr->pageSize];
+}
+
+size_t SharedData::size() const {
+    return dataPtr->size;
+}
+
+std::vector<int> SharedData::toVector() const {
+    std::vector<int> result;
+    result.reserve(dataPtr->size);
+    for (const Page* page : dataPtr->pages) {
+        result.insert(result.end(), page->values.begin(), page->values.end());
+    }
+    return result;
+}
+
+int SharedData::getRefCount() const {
+    return dataPtr->refCount.load(std::memory_order_relaxed);
+}
+
+size_t SharedData::getPageCount() const {
+    return dataPtr->pages.size();
+}
+
+void SharedData::print() const {
+    std::cout << "[";
+    for (size_t i = 0; i < dataPtr->size; ++i) {
+        std::cout << (i ? ", " : "") << get(i);
+    }
+    std::cout << "] (refs: " << getRefCount() << ")\n";
+}
+
+size_t SharedData::getBytesCopied() {
+    return bytesCopied.load(std::memory_order_relaxed);
+}
+
+// The release decrement publishes this owner's reads; the last owner's
+// acquire makes them happen-before the delete
+void SharedData::release() {
+    if (dataPtr->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        for (Page* page : dataPtr->pages) {
+            releasePage(page);
+        }
+        delete dataPtr;
+    }
+    dataPtr = nullptr;
+}
+
+void SharedData::releasePage(Page* page) {
+    if (page->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete page;
+    }
+}
+
+// A count of 1 means this object holds the only reference, and nobody else
+// can add one, so the check needs no lock. The acquire load pairs with the
+// other owners' release decrements: their reads finish before we write.
+void SharedData::detach(size_t index) {
+    if (dataPtr->refCount.load(std::memory_order_acquire) != 1) {
+        DataBlock* copy = new DataBlock(dataPtr->size, dataPtr->pageSize);
+        copy->pages = dataPtr->pages;
+        for (Page* page : copy->pages) {
+            page->refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        bytesCopied.fetch_add(copy->pages.size() * sizeof(Page*), std::memory_order_relaxed);
+        release();
+        dataPtr = copy;
+    }
+    
+    Page*& page = dataPtr->pages[index / dataPtr->pageSize];
+    if (page->refCount.load(std::memory_order_acquire) != 1) {
+        Page* copy = new Page(page->values);
+        bytesCopied.fetch_add(copy->values.size() * sizeof(int), std::memory_order_relaxed);
+        releasePage(page);
+        page = copy;
+    }
+}
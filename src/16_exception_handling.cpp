@@ -15,8 +15,22 @@
 #include <exception>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <vector>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <random>
+
+#include "benchmark_suite.h"
+#include "expected.h"
 
 // TODO: Implement these custom exception classes
 
@@ -49,6 +63,21 @@ public:
     int getInvalidValue() const noexcept;
 };
 
+// Converts an error code into the matching exception at an API boundary
+[[noreturn]] void throwAsException(const Error& error);
+
+template<typename T>
+T valueOrThrow(expected<T, Error> result) {
+    if (!result) {
+        throwAsException(result.error());
+    }
+    return std::move(*result);
+}
+
+// Decimal int parsing for hot loops: the error is returned, not thrown
+expected<int, Error> parseInt(std::string_view text) noexcept;
+int parseIntOrThrow(std::string_view text);
+
 // 2. Class demonstrating RAII with exceptions
 class RAIIResource {
 private:
@@ -83,11 +112,85 @@ public:
     
     // No-throw guarantee
     size_t size() const noexcept;
+    long long sum() const noexcept;
     void clear() noexcept;
     
     void display() const;
 };
 
+// Contiguous variant: elements live in one buffer, so there is no allocation
+// or pointer chase per element. Growth moves elements when T's move
+// constructor is noexcept and copies them otherwise, so a throw mid-growth
+// leaves the old buffer intact. add_range is all-or-nothing for the whole
+// batch: capacity is reserved first, elements are built in the spare slots
+// and size is committed only after the last one.
+//
+// checkpoint() starts journaling: pop_back and replace save the value they
+// destroy, appends need only the old size, and rollback() replays the
+// journal backwards. Undo costs one move per logged operation, never a copy
+// of the container. Checkpoints nest; commit or roll back the innermost
+// first.
+template<typename T>
+class ContiguousSafeContainer {
+public:
+    struct Checkpoint {
+        size_t size;
+        size_t journalSize;
+    };
+    
+private:
+    struct UndoEntry {
+        enum class Kind { Replace, PopBack } kind;
+        size_t index;  // Slot that was overwritten or popped
+        T previous;
+    };
+    
+    T* data = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    std::vector<UndoEntry> journal;
+    size_t openCheckpoints = 0;
+    
+    static T* allocate(size_t n);
+    static void deallocate(T* ptr) noexcept;
+    static void relocate(T* from, size_t count, T* to);
+    size_t grownCapacity(size_t required) const noexcept;
+    void truncate(size_t newSize) noexcept;
+    void reserveJournalSlot();
+    template<typename U>
+    void append(U&& value);
+    
+public:
+    ContiguousSafeContainer() = default;
+    ContiguousSafeContainer(const ContiguousSafeContainer& other);
+    ContiguousSafeContainer(ContiguousSafeContainer&& other) noexcept;
+    ContiguousSafeContainer& operator=(ContiguousSafeContainer other) noexcept;
+    ~ContiguousSafeContainer();
+    
+    // Strong guarantee
+    void add(const T& value);
+    void add(T&& value);
+    template<typename ForwardIt>
+    void add_range(ForwardIt first, ForwardIt last);  // The range must not alias *this
+    void reserve(size_t newCapacity);
+    void pop_back();
+    void replace(size_t index, T value);
+    
+    Checkpoint checkpoint() noexcept;
+    void commit(const Checkpoint& point) noexcept;
+    void rollback(const Checkpoint& point) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                                    std::is_nothrow_move_assignable<T>::value);
+    
+    // No-throw guarantee; clear() also discards open checkpoints
+    const T& operator[](size_t index) const noexcept { return data[index]; }
+    const T* begin() const noexcept { return data; }
+    const T* end() const noexcept { return data + size_; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    size_t journalSize() const noexcept { return journal.size(); }
+    void clear() noexcept;
+};
+
 // 4. Functions with different exception specifications
 class NoexceptDemo {
 public:
@@ -99,6 +202,9 @@ public:
     double divide(double a, double b);
     double safeDivide(double a, double b) noexcept(false);
     
+    // Reports division by zero as a value, so it can be inlined into loops
+    expected<double, Error> tryDivide(double a, double b) noexcept;
+    
     // Conditionally noexcept
     template<typename T>
     void swap(T& a, T& b) noexcept(std::is_nothrow_move_constructible_v<T>);
@@ -113,6 +219,8 @@ void demonstrateRAIIWithExceptions();
 void demonstrateExceptionSafety();
 void demonstrateNoexceptSpecifier();
 void demonstrateExceptionBestPractices();
+void benchmarkErrorPaths();
+void benchmarkContainerLayouts();
 
 int main() {
     std::cout << "=== Exception Handling Examples ===\n\n";
@@ -127,6 +235,8 @@ int main() {
         demonstrateExceptionSafety();
         demonstrateNoexceptSpecifier();
         demonstrateExceptionBestPractices();
+        benchmarkErrorPaths();
+        benchmarkContainerLayouts();
     } catch (const std::exception& e) {
         std::cout << "Caught exception in main: " << e.what() << "\n";
     } catch (...) {
@@ -238,6 +348,34 @@ void demonstrateRAIIWithExceptions() {
     std::cout << "---\n\n";
 }
 
+// Copies throw once copiesLeft runs out; counts copies and moves
+struct FlakyValue {
+    static inline int copiesLeft = 1000;
+    static inline int copies = 0;
+    static inline int moves = 0;
+    int value;
+    
+    FlakyValue(int v = 0) : value(v) {}
+    FlakyValue(const FlakyValue& other) : value(other.value) {
+        if (copiesLeft-- <= 0) {
+            throw std::runtime_error("FlakyValue copy failed");
+        }
+        ++copies;
+    }
+    FlakyValue(FlakyValue&& other) noexcept : value(other.value) { ++moves; }
+    FlakyValue& operator=(const FlakyValue&) = default;
+    FlakyValue& operator=(FlakyValue&&) noexcept = default;
+};
+
+// Same, but the move constructor may throw, so growth has to copy
+struct ThrowingMoveValue : FlakyValue {
+    using FlakyValue::FlakyValue;
+    ThrowingMoveValue(const ThrowingMoveValue&) = default;
+    ThrowingMoveValue(ThrowingMoveValue&& other) noexcept(false) : FlakyValue(std::move(other)) {}
+    ThrowingMoveValue& operator=(const ThrowingMoveValue&) = default;
+    ThrowingMoveValue& operator=(ThrowingMoveValue&&) = default;
+};
+
 void demonstrateExceptionSafety() {
     std::cout << "6. Exception Safety Guarantees:\n";
     
@@ -255,6 +393,56 @@ void demonstrateExceptionSafety() {
     } catch (const std::exception& e) {
         std::cout << "Exception in container operation: " << e.what() << "\n";
     }
+    container.display();
+    
+    // Batch strong guarantee: the third copy throws, nothing is added
+    ContiguousSafeContainer<FlakyValue> flat;
+    flat.add(1);
+    flat.add(2);
+    std::vector<FlakyValue> batch = {10, 20, 30, 40};
+    FlakyValue::copiesLeft = 2;
+    try {
+        flat.add_range(batch.begin(), batch.end());
+    } catch (const std::exception& e) {
+        std::cout << "add_range of 4 failed (" << e.what() << "), size still " << flat.size() << "\n";
+    }
+    FlakyValue::copiesLeft = 1000;
+    flat.add_range(batch.begin(), batch.end());
+    std::cout << "add_range of 4 retried: size " << flat.size() << "\n";
+    
+    // Growth moves when the move constructor is noexcept, copies otherwise
+    ContiguousSafeContainer<FlakyValue> moved;
+    ContiguousSafeContainer<ThrowingMoveValue> copied;
+    FlakyValue::copies = 0;
+    for (int i = 0; i < 100; ++i) {
+        moved.add(FlakyValue(i));
+    }
+    int noexceptCopies = FlakyValue::copies;
+    FlakyValue::copies = 0;
+    for (int i = 0; i < 100; ++i) {
+        copied.add(ThrowingMoveValue(i));
+    }
+    std::cout << "100 adds with growth: noexcept move -> " << noexceptCopies << " copies, throwing move -> "
+              << FlakyValue::copies << " copies\n";
+    
+    // Checkpoint/rollback: undo a batch, an overwrite and a pop in O(ops)
+    ContiguousSafeContainer<int> values;
+    int initial[] = {1, 2, 3};
+    values.add_range(std::begin(initial), std::end(initial));
+    auto point = values.checkpoint();
+    int more[] = {4, 5, 6};
+    values.add_range(std::begin(more), std::end(more));
+    values.replace(0, 100);
+    values.pop_back();
+    values.pop_back();
+    std::cout << "after add_range, replace, 2 pops: size " << values.size() << ", first " << values[0]
+              << ", journal " << values.journalSize() << " entries\n";
+    values.rollback(point);
+    std::cout << "rolled back:";
+    for (int v : values) {
+        std::cout << " " << v;
+    }
+    std::cout << "\n";
     
     std::cout << "---\n\n";
 }
@@ -277,6 +465,24 @@ void demonstrateNoexceptSpecifier() {
         std::cout << "Division exception: " << e.what() << "\n";
     }
     
+    // noexcept alternative: the error travels in the return value
+    std::cout << "tryDivide is noexcept: " << std::boolalpha << noexcept(demo.tryDivide(1, 0))
+              << std::noboolalpha << "\n";
+    auto halved = demo.tryDivide(10, 4).transform([](double q) { return q / 2; });
+    std::cout << "tryDivide(10, 4).transform(/2) = " << halved.value() << "\n";
+    auto chained = parseInt("12").and_then([&demo](int n) { return demo.tryDivide(n, n - 12); });
+    std::cout << "parseInt(\"12\").and_then(tryDivide(n, n - 12)): "
+              << (chained ? "ok" : errorMessage(chained.error().code)) << "\n";
+    std::cout << "parseInt(\"4x2\"): " << errorMessage(parseInt("4x2").error().code)
+              << ", value_or(-1) = " << parseInt("4x2").value_or(-1) << "\n";
+    
+    // Converted back to the exception hierarchy at the API boundary
+    try {
+        parseIntOrThrow("4x2");
+    } catch (const InvalidInputException& e) {
+        std::cout << "parseIntOrThrow(\"4x2\") threw InvalidInputException: " << e.what() << "\n";
+    }
+    
     std::cout << "---\n\n";
 }
 
@@ -294,6 +500,178 @@ void demonstrateExceptionBestPractices() {
     std::cout << "---\n\n";
 }
 
+static volatile double errorPathSink = 0;
+
+template<typename Fn>
+static double measureMops(size_t ops, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return ops / elapsed.count();
+}
+
+// Same inputs, same work per element; only the error channel differs
+void benchmarkErrorPaths() {
+    std::cout << "9. Exceptions vs expected<T, E> by Error Rate (Mops/s):\n";
+    
+    constexpr size_t N = 200000;
+    NoexceptDemo demo;
+    std::cout << std::setw(8) << "errors" << std::setw(14) << "divide throw" << std::setw(14) << "divide exp"
+              << std::setw(14) << "parse throw" << std::setw(14) << "parse exp" << "\n";
+    
+    for (double rate : {0.001, 0.01, 0.1}) {
+        std::mt19937 rng(42);
+        std::bernoulli_distribution isError(rate);
+        std::vector<double> divisors(N);
+        std::vector<std::string> fields(N);
+        for (size_t i = 0; i < N; ++i) {
+            bool bad = isError(rng);
+            divisors[i] = bad ? 0.0 : 1.0 + static_cast<double>(i % 7);
+            fields[i] = bad ? "12x4" : std::to_string(i % 100000);
+        }
+        
+        double divideThrow = measureMops(N, [&] {
+            double sum = 0;
+            for (double d : divisors) {
+                try {
+                    sum += demo.divide(1.0, d);
+                } catch (const MathException&) {
+                    sum -= 1;
+                }
+            }
+            errorPathSink = sum;
+        });
+        double divideExpected = measureMops(N, [&] {
+            double sum = 0;
+            for (double d : divisors) {
+                auto q = demo.tryDivide(1.0, d);
+                sum += q ? *q : -1;
+            }
+            errorPathSink = sum;
+        });
+        double parseThrow = measureMops(N, [&] {
+            long long sum = 0;
+            for (const std::string& field : fields) {
+                try {
+                    sum += parseIntOrThrow(field);
+                } catch (const InvalidInputException&) {
+                    sum -= 1;
+                }
+            }
+            errorPathSink = static_cast<double>(sum);
+        });
+        double parseExpected = measureMops(N, [&] {
+            long long sum = 0;
+            for (const std::string& field : fields) {
+                sum += parseInt(field).value_or(-1);
+            }
+            errorPathSink = static_cast<double>(sum);
+        });
+        
+        std::cout << std::fixed << std::setprecision(1) << std::setw(7) << rate * 100 << "%" << std::setw(14)
+                  << divideThrow << std::setw(14) << divideExpected << std::setw(14) << parseThrow
+                  << std::setw(14) << parseExpected << "\n" << std::defaultfloat;
+    }
+    
+    std::cout << "---\n\n";
+}
+
+// Same values into both layouts. The pointer-per-element container pays an
+// allocation per insert and a dependent load per element on traversal; the
+// contiguous one amortizes growth and streams through one buffer.
+void benchmarkContainerLayouts() {
+    std::cout << "10. ExceptionSafeContainer Layouts (inserts/sec, cache misses):\n";
+    
+    constexpr size_t N = 100000;
+    std::vector<int> source(N);
+    for (size_t i = 0; i < N; ++i) {
+        source[i] = static_cast<int>(i % 1000);
+    }
+    
+    BenchmarkSuite suite("exception-safety");
+    suite.add("insert", "pointer-per-element addItemStrong", [&](BenchmarkRun& run) {
+        ExceptionSafeContainer container;
+        run.measure(N, [&] {
+            for (int v : source) {
+                container.addItemStrong(v);
+            }
+        });
+        doNotOptimize(container.size());
+    });
+    suite.add("insert", "contiguous add", [&](BenchmarkRun& run) {
+        ContiguousSafeContainer<int> container;
+        run.measure(N, [&] {
+            for (int v : source) {
+                container.add(v);
+            }
+        });
+        doNotOptimize(container.size());
+    });
+    suite.add("insert", "contiguous add_range", [&](BenchmarkRun& run) {
+        ContiguousSafeContainer<int> container;
+        run.measure(N, [&] { container.add_range(source.data(), source.data() + N); });
+        doNotOptimize(container.size());
+    });
+    suite.add("traverse", "pointer-per-element sum", [&](BenchmarkRun& run) {
+        ExceptionSafeContainer container;
+        for (int v : source) {
+            container.addItemStrong(v);
+        }
+        run.measure(N, [&] { doNotOptimize(container.sum()); });
+    });
+    suite.add("traverse", "contiguous sum", [&](BenchmarkRun& run) {
+        ContiguousSafeContainer<int> container;
+        container.add_range(source.data(), source.data() + N);
+        run.measure(N, [&] {
+            long long total = 0;
+            for (int v : container) {
+                total += v;
+            }
+            doNotOptimize(total);
+        });
+    });
+    // Undo changes to 0.1% of the elements: replay the journal vs restore a full copy
+    constexpr size_t Changes = N / 1000;
+    suite.add("undo", "checkpoint + rollback", [&](BenchmarkRun& run) {
+        ContiguousSafeContainer<int> container;
+        container.add_range(source.data(), source.data() + N);
+        run.measure(Changes, [&] {
+            auto point = container.checkpoint();
+            for (size_t i = 0; i < Changes; ++i) {
+                container.replace(i * 1000, -1);
+            }
+            container.rollback(point);
+        });
+        doNotOptimize(container[0]);
+    });
+    suite.add("undo", "copy snapshot + restore", [&](BenchmarkRun& run) {
+        ContiguousSafeContainer<int> container;
+        container.add_range(source.data(), source.data() + N);
+        run.measure(Changes, [&] {
+            ContiguousSafeContainer<int> snapshot(container);
+            for (size_t i = 0; i < Changes; ++i) {
+                container.replace(i * 1000, -1);
+            }
+            container = std::move(snapshot);
+        });
+        doNotOptimize(container[0]);
+    });
+    
+    BenchmarkOptions options;
+    options.repetitions = 5;
+    suite.run(options);
+    std::cout << N << " elements, median of " << options.repetitions << " runs, ns per op (undo: per changed element)\n";
+    suite.writeTable(std::cout);
+    for (const auto& r : suite.getResults()) {
+        if (r.group == "insert" && r.median > 0) {
+            std::cout << std::setw(36) << std::left << r.name << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(8) << 1e3 / r.median << " M inserts/s\n" << std::defaultfloat;
+        }
+    }
+    
+    std::cout << "---\n\n";
+}
+
 // TODO: Implement all class methods
 CustomException::CustomException(const std::string& msg) : message(msg) {}
 
@@ -349,4 +727,359 @@ void RAIIResource::doWork() {
     // Simulate work that might throw
 }
 
-// TODO: Implement remaining class methods...
+// ExceptionSafeContainer implementation
+// No leak if push_back throws: the unique_ptr owns the int throughout
+void ExceptionSafeContainer::addItemBasic(int value) {
+    data.push_back(std::make_unique<int>(value));
+}
+
+// The element is allocated before the container is touched, and push_back
+// gives the strong guarantee because unique_ptr's move cannot throw
+void ExceptionSafeContainer::addItemStrong(int value) {
+    auto item = std::make_unique<int>(value);
+    data.push_back(std::move(item));
+}
+
+size_t ExceptionSafeContainer::size() const noexcept {
+    return data.size();
+}
+
+long long ExceptionSafeContainer::sum() const noexcept {
+    long long total = 0;
+    for (const auto& item : data) {
+        total += *item;
+    }
+    return total;
+}
+
+void ExceptionSafeContainer::clear() noexcept {
+    data.clear();
+}
+
+void ExceptionSafeContainer::display() const {
+    std::cout << "ExceptionSafeContainer:";
+    for (const auto& item : data) {
+        std::cout << " " << *item;
+    }
+    std::cout << "\n";
+}
+
+// ContiguousSafeContainer implementation
+template<typename T>
+T* ContiguousSafeContainer<T>::allocate(size_t n) {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+}
+
+template<typename T>
+void ContiguousSafeContainer<T>::deallocate(T* ptr) noexcept {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(ptr, std::align_val_t(alignof(T)));
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+// memcpy for trivially copyable T; otherwise move if noexcept, else copy.
+// The sources are destroyed only once every element has been built.
+template<typename T>
+void ContiguousSafeContainer<T>::relocate(T* from, size_t count, T* to) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (count > 0) {
+            std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+        }
+    } else {
+        size_t built = 0;
+        try {
+            for (; built < count; ++built) {
+                ::new (static_cast<void*>(to + built)) T(std::move_if_noexcept(from[built]));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < built; ++i) {
+                to[i].~T();
+            }
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            from[i].~T();
+        }
+    }
+}
+
+template<typename T>
+size_t ContiguousSafeContainer<T>::grownCapacity(size_t required) const noexcept {
+    return std::max(required, capacity_ < 8 ? size_t(8) : capacity_ * 2);
+}
+
+template<typename T>
+void ContiguousSafeContainer<T>::truncate(size_t newSize) noexcept {
+    while (size_ > newSize) {
+        data[--size_].~T();
+    }
+}
+
+template<typename T>
+ContiguousSafeContainer<T>::ContiguousSafeContainer(const ContiguousSafeContainer& other) {
+    reserve(other.size_);
+    add_range(other.begin(), other.end());
+}
+
+template<typename T>
+ContiguousSafeContainer<T>::ContiguousSafeContainer(ContiguousSafeContainer&& other) noexcept
+    : data(other.data), size_(other.size_), capacity_(other.capacity_), journal(std::move(other.journal)),
+      openCheckpoints(other.openCheckpoints) {
+    other.data = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+    other.openCheckpoints = 0;
+}
+
+template<typename T>
+ContiguousSafeContainer<T>& ContiguousSafeContainer<T>::operator=(ContiguousSafeContainer other) noexcept {
+    std::swap(data, other.data);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    journal.swap(other.journal);
+    std::swap(openCheckpoints, other.openCheckpoints);
+    return *this;
+}
+
+template<typename T>
+ContiguousSafeContainer<T>::~ContiguousSafeContainer() {
+    truncate(0);
+    deallocate(data);
+}
+
+template<typename T>
+void ContiguousSafeContainer<T>::reserve(size_t newCapacity) {
+    if (newCapacity <= capacity_) {
+        return;
+    }
+    T* fresh = allocate(newCapacity);
+    try {
+        relocate(data, size_, fresh);
+    } catch (...) {
+        deallocate(fresh);
+        throw;
+    }
+    deallocate(data);
+    data = fresh;
+    capacity_ = newCapacity;
+}
+
+// On growth the new element is built first, so add((*this)[0]) stays valid
+template<typename T>
+template<typename U>
+void ContiguousSafeContainer<T>::append(U&& value) {
+    if (size_ < capacity_) {
+        ::new (static_cast<void*>(data + size_)) T(std::forward<U>(value));
+        ++size_;
+        return;
+    }
+    size_t newCapacity = grownCapacity(size_ + 1);
+    T* fresh = allocate(newCapacity);
+    try {
+        ::new (static_cast<void*>(fresh + size_)) T(std::forward<U>(value));
+    } catch (...) {
+        deallocate(fresh);
+        throw;
+    }
+    try {
+        relocate(data, size_, fresh);
+    } catch (...) {
+        fresh[size_].~T();
+        deallocate(fresh);
+        throw;
+    }
+    deallocate(data);
+    data = fresh;
+    capacity_ = newCapacity;
+    ++size_;
+}
+
+template<typename T>
+void ContiguousSafeContainer<T>::add(const T& value) {
+    append(value);
+}
+
+template<typename T>
+void ContiguousSafeContainer<T>::add(T&& value) {
+    append(std::move(value));
+}
+
+// Reserve, build in the spare slots, then commit the new size. A throw
+// destroys what was built; the elements are untouched and only the
+// capacity may have grown.
+template<typename T>
+template<typename ForwardIt>
+void ContiguousSafeContainer<T>::add_range(ForwardIt first, ForwardIt last) {
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+    if (count == 0) {
+        return;
+    }
+    if (size_ + count > capacity_) {
+        reserve(grownCapacity(size_ + count));
+    }
+    T* spare = data + size_;
+    if constexpr (std::is_trivially_copyable<T>::value && std::is_pointer<ForwardIt>::value &&
+                  std::is_same<std::remove_cv_t<std::remove_pointer_t<ForwardIt>>, T>::value) {
+        std::memcpy(static_cast<void*>(spare), first, count * sizeof(T));
+    } else {
+        size_t built = 0;
+        try {
+            for (; first != last; ++first, ++built) {
+                ::new (static_cast<void*>(spare + built)) T(*first);
+            }
+        } catch (...) {
+            while (built > 0) {
+                spare[--built].~T();
+            }
+            throw;
+        }
+    }
+    size_ += count;
+}
+
+// vector::reserve allocates exactly what it is asked for, so grow by doubling
+template<typename T>
+void ContiguousSafeContainer<T>::reserveJournalSlot() {
+    if (journal.size() == journal.capacity()) {
+        journal.reserve(std::max(size_t(16), journal.capacity() * 2));
+    }
+}
+
+// The journal slot is reserved before the element is touched, so a failed
+// journal allocation leaves the container as it was
+template<typename T>
+void ContiguousSafeContainer<T>::pop_back() {
+    if (size_ == 0) {
+        return;
+    }
+    if (openCheckpoints > 0) {
+        reserveJournalSlot();
+        journal.push_back({UndoEntry::Kind::PopBack, size_ - 1, std::move(data[size_ - 1])});
+    }
+    data[--size_].~T();
+}
+
+template<typename T>
+void ContiguousSafeContainer<T>::replace(size_t index, T value) {
+    if (openCheckpoints > 0) {
+        reserveJournalSlot();
+        journal.push_back({UndoEntry::Kind::Replace, index, std::move(data[index])});
+    }
+    data[index] = std::move(value);
+}
+
+template<typename T>
+typename ContiguousSafeContainer<T>::Checkpoint ContiguousSafeContainer<T>::checkpoint() noexcept {
+    ++openCheckpoints;
+    return {size_, journal.size()};
+}
+
+// An outer checkpoint may still need the entries, so they are dropped only
+// when the outermost one commits
+template<typename T>
+void ContiguousSafeContainer<T>::commit(const Checkpoint&) noexcept {
+    if (openCheckpoints > 0 && --openCheckpoints == 0) {
+        journal.clear();
+    }
+}
+
+// Newest first: cut back to the size at the time of each logged operation,
+// then restore the slot it overwrote or popped. Slots freed by a pop are
+// still within capacity, so restoring never allocates.
+template<typename T>
+void ContiguousSafeContainer<T>::rollback(const Checkpoint& point) noexcept(
+    std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value) {
+    while (journal.size() > point.journalSize) {
+        UndoEntry& entry = journal.back();
+        if (entry.kind == UndoEntry::Kind::PopBack) {
+            truncate(entry.index);
+            ::new (static_cast<void*>(data + size_)) T(std::move(entry.previous));
+            ++size_;
+        } else {
+            data[entry.index] = std::move(entry.previous);
+        }
+        journal.pop_back();
+    }
+    truncate(point.size);
+    if (openCheckpoints > 0 && --openCheckpoints == 0) {
+        journal.clear();
+    }
+}
+
+template<typename T>
+void ContiguousSafeContainer<T>::clear() noexcept {
+    truncate(0);
+    journal.clear();
+    openCheckpoints = 0;
+}
+
+[[noreturn]] void throwAsException(const Error& error) {
+    switch (error.code) {
+        case ErrorCode::DivideByZero:
+            throw DivideByZeroException();
+        case ErrorCode::InvalidInput:
+            throw InvalidInputException(errorMessage(error.code), error.detail);
+        case ErrorCode::OutOfRange:
+            throw MathException(errorMessage(error.code));
+        default:
+            throw CustomException(errorMessage(error.code));
+    }
+}
+
+// detail is the offset of the first bad character
+expected<int, Error> parseInt(std::string_view text) noexcept {
+    int value = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec == std::errc::result_out_of_range) {
+        return unexpected(Error{ErrorCode::OutOfRange});
+    }
+    if (ec != std::errc() || ptr != end) {
+        return unexpected(Error{ErrorCode::InvalidInput, static_cast<int32_t>(ptr - text.data())});
+    }
+    return value;
+}
+
+int parseIntOrThrow(std::string_view text) {
+    return valueOrThrow(parseInt(text));
+}
+
+// NoexceptDemo implementation
+int NoexceptDemo::add(int a, int b) noexcept {
+    return a + b;
+}
+
+int NoexceptDemo::multiply(int a, int b) noexcept(true) {
+    return a * b;
+}
+
+double NoexceptDemo::divide(double a, double b) {
+    if (b == 0.0) {
+        throw DivideByZeroException();
+    }
+    return a / b;
+}
+
+double NoexceptDemo::safeDivide(double a, double b) noexcept(false) {
+    return valueOrThrow(tryDivide(a, b));
+}
+
+expected<double, Error> NoexceptDemo::tryDivide(double a, double b) noexcept {
+    if (b == 0.0) {
+        return unexpected(Error{ErrorCode::DivideByZero});
+    }
+    return a / b;
+}
+
+template<typename T>
+void NoexceptDemo::swap(T& a, T& b) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    T tmp = std::move(a);
+    a = std::move(b);
+    b = std::move(tmp);
+}
@@ -16,6 +16,19 @@
 #include <mutex>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <stdexcept>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+
+#include "instrumentation.h"
+#include "read_mostly.h"
 
 // TODO: Implement these RAII wrapper classes
 
@@ -71,6 +84,8 @@ public:
 };
 
 // 3. Lock RAII wrapper
+// Reader/writer variants over a shared_mutex, a seqlock and an RCU cell for
+// read-mostly data live in read_mostly.h
 class LockRAII {
 private:
     std::mutex& mtx;
@@ -114,23 +129,83 @@ public:
 };
 
 // 5. Resource pool RAII
+// Resources live in fixed slots and handles carry a slot index, so nothing is
+// copied or searched on acquire/release. Free slots form a lock-free stack
+// (index + ABA tag packed in one 64-bit head). Pools with at least 64 slots
+// also give each thread a small magazine of cached indices, so a thread that
+// repeatedly acquires and releases never touches shared state. Up to
+// magazineSize slots per thread can sit in idle magazines; blocked acquirers
+// ask active threads to flush theirs. Only the blocking path of acquire() is
+// instrumented, so the fast path pays nothing for the metrics.
 class ResourcePool {
+public:
+    static constexpr uint32_t NoSlot = UINT32_MAX;
+    static constexpr size_t MaxMagazineSize = 16;
+    
 private:
-    std::vector<std::string> availableResources;
-    std::vector<std::string> usedResources;
-    std::mutex poolMutex;
+    struct Slot {
+        std::string resource;
+        std::atomic<uint32_t> next{NoSlot};
+    };
+    
+    struct Magazine;
+    
+    // Shared by the pool and every thread's magazine; a magazine can outlive
+    // the pool object until its thread next uses a pool or exits
+    struct Shared {
+        std::unique_ptr<Slot[]> slots;
+        size_t capacity = 0;
+        std::atomic<uint64_t> freeHead{NoSlot};  // (tag << 32) | slot index
+        std::atomic<size_t> freeCount{0};
+        std::atomic<int> waiters{0};
+        std::atomic<uint64_t> flushEpoch{0};
+        std::atomic<bool> retired{false};
+        std::mutex waitMutex;
+        std::condition_variable slotFreed;
+        std::mutex registryMutex;
+        std::vector<Magazine*> magazines;
+        
+        void push(uint32_t index);
+        uint32_t pop();
+        void pushAndNotify(uint32_t index);
+    };
+    
+    struct Magazine {
+        std::shared_ptr<Shared> shared;
+        uint32_t items[MaxMagazineSize];
+        std::atomic<size_t> count{0};  // Written by the owner thread only
+        uint64_t seenEpoch = 0;
+        
+        explicit Magazine(std::shared_ptr<Shared> owner);
+        ~Magazine();
+        void flush();
+    };
+    
+    std::shared_ptr<Shared> shared;
+    const size_t magazineSize;
+    instrumentation::Histogram& acquireWait;
+    instrumentation::Counter& acquireTimeouts;
+    
+    Magazine& localMagazine();
+    uint32_t popFree();
     
 public:
     ResourcePool(const std::vector<std::string>& resources);
     
+    // Every handle must be released before the pool is destroyed
+    ~ResourcePool();
+    
+    ResourcePool(const ResourcePool&) = delete;
+    ResourcePool& operator=(const ResourcePool&) = delete;
+    
     class ResourceHandle {
     private:
-        ResourcePool& pool;
-        std::string resource;
-        bool valid;
+        ResourcePool* pool;
+        uint32_t slot;
         
     public:
-        ResourceHandle(ResourcePool& p, const std::string& res);
+        ResourceHandle();
+        ResourceHandle(ResourcePool& p, uint32_t slotIndex);
         ~ResourceHandle();
         
         // Non-copyable but movable
@@ -140,12 +215,20 @@ public:
         ResourceHandle& operator=(ResourceHandle&& other) noexcept;
         
         const std::string& getResource() const;
+        uint32_t getSlot() const;
         bool isValid() const;
+        void reset();
     };
     
+    // Throws std::runtime_error when the pool is exhausted
     ResourceHandle acquireResource();
-    void releaseResource(const std::string& resource);
+    // Returns an invalid handle instead of throwing or waiting
+    ResourceHandle tryAcquire();
+    // Waits up to timeout for a slot; returns an invalid handle on timeout
+    ResourceHandle acquire(std::chrono::milliseconds timeout);
+    void releaseResource(uint32_t slot);
     size_t availableCount() const;
+    size_t capacity() const;
 };
 
 // Function prototypes for demonstrations
@@ -157,6 +240,8 @@ void demonstrateResourceLifecycle();
 void demonstrateRAIIBenefits();
 void demonstrateRAIIPatterns();
 void demonstrateRAIIWithStandardLibrary();
+void benchmarkResourcePool();
+void benchmarkReadMostlyLocks();
 
 int main() {
     std::cout << "=== RAII Examples ===\n\n";
@@ -170,6 +255,8 @@ int main() {
     demonstrateRAIIBenefits();
     demonstrateRAIIPatterns();
     demonstrateRAIIWithStandardLibrary();
+    benchmarkResourcePool();
+    benchmarkReadMostlyLocks();
     
     return 0;
 }
@@ -286,10 +373,30 @@ void demonstrateResourceLifecycle() {
             std::cout << "Acquiring resource...\n";
             auto handle = pool.acquireResource();
             std::cout << "Using resource: " << handle.getResource() << "\n";
+            std::cout << "Available while held: " << pool.availableCount() << "\n";
             
             // Resource automatically returned when handle goes out of scope
         }
-        std::cout << "Resource returned to pool\n";
+        std::cout << "Resource returned to pool, available: " << pool.availableCount() << "\n";
+        
+        // Exhaust the pool, then wait for a slot with a timeout
+        auto first = pool.acquireResource();
+        auto second = pool.acquireResource();
+        auto third = pool.acquireResource();
+        std::cout << "All " << pool.capacity() << " held; tryAcquire valid: " << std::boolalpha
+                  << pool.tryAcquire().isValid() << ", acquire(20ms) valid: "
+                  << pool.acquire(std::chrono::milliseconds(20)).isValid() << "\n";
+        
+        std::thread releaser([&second]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            second.reset();
+        });
+        auto waited = pool.acquire(std::chrono::milliseconds(1000));
+        releaser.join();
+        std::cout << "acquire(1s) after another thread released: " << waited.getResource()
+                  << std::noboolalpha << "\n";
+        instrumentation::writeSummary(std::cout, "resource_pool_acquire_wait",
+                                      instrumentation::histogram("resource_pool_acquire_wait", ""));
         
         // Pool cleaned up when it goes out of scope
     }
@@ -349,4 +456,545 @@ void demonstrateRAIIWithStandardLibrary() {
     std::cout << "---\n\n";
 }
 
+// The previous design: strings moved between two vectors under one mutex,
+// with a linear search on release
+class MutexResourcePool {
+private:
+    std::vector<std::string> availableResources;
+    std::vector<std::string> usedResources;
+    std::mutex poolMutex;
+    
+public:
+    MutexResourcePool(const std::vector<std::string>& resources) : availableResources(resources) {}
+    
+    bool acquire(std::string& out) {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (availableResources.empty()) {
+            return false;
+        }
+        out = availableResources.back();
+        availableResources.pop_back();
+        usedResources.push_back(out);
+        return true;
+    }
+    
+    void release(const std::string& resource) {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        auto it = std::find(usedResources.begin(), usedResources.end(), resource);
+        if (it != usedResources.end()) {
+            usedResources.erase(it);
+            availableResources.push_back(resource);
+        }
+    }
+};
+
+struct PoolRunStats {
+    double opsPerSecond;
+    double p50Ns;
+    double p99Ns;
+    double p999Ns;
+};
+
+// Every thread loops acquire/release for the duration; acquire latency is
+// sampled on every 8th operation
+template<typename AcquireRelease>
+static PoolRunStats runPoolThreads(int threads, std::chrono::milliseconds duration, AcquireRelease op) {
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::vector<long long> ops(threads, 0);
+    std::vector<std::vector<uint32_t>> samples(threads);
+    std::vector<std::thread> workers;
+    
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            samples[t].reserve(1 << 16);
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            long long count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if ((count & 7) == 0) {
+                    auto begin = std::chrono::steady_clock::now();
+                    op();
+                    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - begin).count();
+                    samples[t].push_back(static_cast<uint32_t>(std::min<long long>(ns, UINT32_MAX)));
+                } else {
+                    op();
+                }
+                ++count;
+            }
+            ops[t] = count;
+        });
+    }
+    
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    stop.store(true);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    
+    std::vector<uint32_t> all;
+    long long totalOps = 0;
+    for (int t = 0; t < threads; ++t) {
+        totalOps += ops[t];
+        all.insert(all.end(), samples[t].begin(), samples[t].end());
+    }
+    auto percentile = [&all](double q) -> double {
+        if (all.empty()) {
+            return 0;
+        }
+        size_t k = std::min(all.size() - 1, static_cast<size_t>(q * all.size()));
+        std::nth_element(all.begin(), all.begin() + k, all.end());
+        return all[k];
+    };
+    return {totalOps / seconds, percentile(0.50), percentile(0.99), percentile(0.999)};
+}
+
+void benchmarkResourcePool() {
+    std::cout << "9. ResourcePool Benchmark (mutex + strings vs lock-free slots):\n";
+    constexpr size_t POOL_SIZE = 256;
+    constexpr auto DURATION = std::chrono::milliseconds(200);
+    
+    std::vector<std::string> connections;
+    for (size_t i = 0; i < POOL_SIZE; ++i) {
+        connections.push_back("postgres://db-replica-" + std::to_string(i) + ".internal:5432/app");
+    }
+    
+    std::cout << POOL_SIZE << " resources, acquire + release per op, " << DURATION.count()
+              << " ms per run; latency percentiles of one acquire + release\n";
+    std::cout << std::setw(8) << "Threads" << "  " << std::left << std::setw(10) << "Pool" << std::right
+              << std::setw(12) << "Mops/s" << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns"
+              << std::setw(11) << "p99.9 ns" << "\n";
+    
+    auto report = [](int threads, const char* name, const PoolRunStats& stats) {
+        std::cout << std::setw(8) << threads << "  " << std::left << std::setw(10) << name << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(12) << stats.opsPerSecond / 1e6
+                  << std::setprecision(0) << std::setw(10) << stats.p50Ns << std::setw(10) << stats.p99Ns
+                  << std::setw(11) << stats.p999Ns << "\n" << std::defaultfloat;
+    };
+    
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        MutexResourcePool mutexPool(connections);
+        report(threads, "mutex", runPoolThreads(threads, DURATION, [&mutexPool]() {
+            std::string resource;
+            if (mutexPool.acquire(resource)) {
+                mutexPool.release(resource);
+            }
+        }));
+        
+        ResourcePool pool(connections);
+        report(threads, "lock-free", runPoolThreads(threads, DURATION, [&pool]() {
+            ResourcePool::ResourceHandle handle = pool.acquire(std::chrono::milliseconds(100));
+        }));
+    }
+    
+    std::cout << "---\n\n";
+}
+
+// Small read-mostly record; the fields move together, so a torn read shows
+// up as burst != 2 * requestsPerSecond
+struct RateLimits {
+    int64_t requestsPerSecond = 1000;
+    int64_t burst = 2000;
+    int64_t windowMs = 1000;
+    int64_t generation = 0;
+};
+
+static void bumpLimits(RateLimits& limits) {
+    ++limits.generation;
+    limits.requestsPerSecond = 1000 + limits.generation % 100;
+    limits.burst = 2 * limits.requestsPerSecond;
+}
+
+struct ReadWriteMixStats {
+    double readsPerSecond;
+    double writeP50Ns;
+    double writeP99Ns;
+    long long tornReads;
+};
+
+// Every thread loops for the duration doing one write per writeEvery
+// operations (offset per thread, so writers do not line up) and reads
+// otherwise. Every write is timed, lock wait included.
+template<typename Read, typename Write>
+static ReadWriteMixStats runReadWriteMix(int threads, std::chrono::milliseconds duration, int writeEvery,
+                                         Read read, Write write) {
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::vector<long long> reads(threads, 0);
+    std::vector<long long> torn(threads, 0);
+    std::vector<std::vector<uint32_t>> samples(threads);
+    std::vector<std::thread> workers;
+    
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            samples[t].reserve(1 << 16);
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            long long readCount = 0;
+            long long tornCount = 0;
+            for (long long op = t; !stop.load(std::memory_order_relaxed); ++op) {
+                if (op % writeEvery == 0) {
+                    auto begin = std::chrono::steady_clock::now();
+                    write();
+                    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - begin).count();
+                    samples[t].push_back(static_cast<uint32_t>(std::min<long long>(ns, UINT32_MAX)));
+                } else {
+                    RateLimits limits = read();
+                    tornCount += limits.burst != 2 * limits.requestsPerSecond;
+                    ++readCount;
+                }
+            }
+            reads[t] = readCount;
+            torn[t] = tornCount;
+        });
+    }
+    
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    stop.store(true);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    
+    std::vector<uint32_t> all;
+    long long totalReads = 0;
+    long long totalTorn = 0;
+    for (int t = 0; t < threads; ++t) {
+        totalReads += reads[t];
+        totalTorn += torn[t];
+        all.insert(all.end(), samples[t].begin(), samples[t].end());
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&all](double q) -> double {
+        return all.empty() ? 0.0 : all[static_cast<size_t>(q * (all.size() - 1))];
+    };
+    return {totalReads / seconds, percentile(0.50), percentile(0.99), totalTorn};
+}
+
+void benchmarkReadMostlyLocks() {
+    std::cout << "10. Read-Mostly Locking (mutex vs shared_mutex vs seqlock vs RCU):\n";
+    constexpr int THREADS = 4;
+    constexpr auto DURATION = std::chrono::milliseconds(100);
+    
+    std::cout << THREADS << " threads, " << DURATION.count() << " ms per run, one " << sizeof(RateLimits)
+              << "-byte record; write latency includes waiting for readers\n";
+    std::cout << std::left << std::setw(8) << "Reads" << std::setw(22) << "Primitive" << std::right
+              << std::setw(12) << "Mreads/s" << std::setw(15) << "write p50 ns" << std::setw(15) << "write p99 ns"
+              << "\n";
+    
+    auto report = [](const char* ratio, const char* name, const ReadWriteMixStats& stats) {
+        std::cout << std::left << std::setw(8) << ratio << std::setw(22) << name << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(12) << stats.readsPerSecond / 1e6
+                  << std::setprecision(0) << std::setw(15) << stats.writeP50Ns << std::setw(15) << stats.writeP99Ns
+                  << std::defaultfloat;
+        if (stats.tornReads != 0) {
+            std::cout << "  (" << stats.tornReads << " torn reads!)";
+        }
+        std::cout << "\n";
+    };
+    
+    const std::pair<const char*, int> ratios[] = {{"99/1", 100}, {"90/10", 10}, {"50/50", 2}};
+    for (const auto& [ratio, writeEvery] : ratios) {
+        {
+            std::mutex mtx;
+            RateLimits limits;
+            report(ratio, "mutex (LockRAII)", runReadWriteMix(THREADS, DURATION, writeEvery,
+                [&]() { LockRAII lock(mtx); return limits; },
+                [&]() { LockRAII lock(mtx); bumpLimits(limits); }));
+        }
+        {
+            std::shared_mutex mtx;
+            RateLimits limits;
+            report(ratio, "shared_mutex", runReadWriteMix(THREADS, DURATION, writeEvery,
+                [&]() { ReadLockRAII lock(mtx); return limits; },
+                [&]() { WriteLockRAII lock(mtx); bumpLimits(limits); }));
+        }
+        {
+            SeqLock<RateLimits> limits;
+            report(ratio, "seqlock", runReadWriteMix(THREADS, DURATION, writeEvery,
+                [&]() { return limits.load(); },
+                [&]() { limits.update(bumpLimits); }));
+        }
+        {
+            RcuPtr<RateLimits> limits(std::make_shared<const RateLimits>());
+            report(ratio, "RCU shared_ptr", runReadWriteMix(THREADS, DURATION, writeEvery,
+                [&]() { return *limits.read(); },
+                [&]() { limits.update(bumpLimits); }));
+        }
+    }
+    
+    std::cout << "---\n\n";
+}
+
 // TODO: Implement all class methods
+
+// LockRAII implementation
+LockRAII::LockRAII(std::mutex& m) : mtx(m), locked(false) {
+    lock();
+}
+
+LockRAII::~LockRAII() {
+    unlock();
+}
+
+void LockRAII::unlock() {
+    if (locked) {
+        mtx.unlock();
+        locked = false;
+    }
+}
+
+void LockRAII::lock() {
+    if (!locked) {
+        mtx.lock();
+        locked = true;
+    }
+}
+
+bool LockRAII::isLocked() const {
+    return locked;
+}
+
+// ResourcePool implementation
+void ResourcePool::Shared::push(uint32_t index) {
+    uint64_t head = freeHead.load();
+    uint64_t next;
+    do {
+        slots[index].next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        next = ((head >> 32) + 1) << 32 | index;
+    } while (!freeHead.compare_exchange_weak(head, next));
+    freeCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// The tag in the upper half changes on every successful update, so a head
+// that was popped and pushed back in between fails the CAS (no ABA)
+uint32_t ResourcePool::Shared::pop() {
+    uint64_t head = freeHead.load();
+    for (;;) {
+        uint32_t index = static_cast<uint32_t>(head);
+        if (index == NoSlot) {
+            return NoSlot;
+        }
+        uint64_t next = ((head >> 32) + 1) << 32 | slots[index].next.load(std::memory_order_relaxed);
+        if (freeHead.compare_exchange_weak(head, next)) {
+            freeCount.fetch_sub(1, std::memory_order_relaxed);
+            return index;
+        }
+    }
+}
+
+// Both sides are seq_cst: either a waiter's pop sees this push, or this
+// load sees the waiter and wakes it under the mutex
+void ResourcePool::Shared::pushAndNotify(uint32_t index) {
+    push(index);
+    if (waiters.load() > 0) {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        slotFreed.notify_one();
+    }
+}
+
+ResourcePool::Magazine::Magazine(std::shared_ptr<Shared> owner) : shared(std::move(owner)) {
+    seenEpoch = shared->flushEpoch.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(shared->registryMutex);
+    shared->magazines.push_back(this);
+}
+
+ResourcePool::Magazine::~Magazine() {
+    flush();
+    std::lock_guard<std::mutex> lock(shared->registryMutex);
+    shared->magazines.erase(std::find(shared->magazines.begin(), shared->magazines.end(), this));
+}
+
+void ResourcePool::Magazine::flush() {
+    size_t n = count.load(std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    while (n > 0) {
+        shared->pushAndNotify(items[--n]);
+    }
+}
+
+ResourcePool::ResourcePool(const std::vector<std::string>& resources)
+    : shared(std::make_shared<Shared>()),
+      magazineSize(std::min(MaxMagazineSize, resources.size() / 64)),
+      acquireWait(instrumentation::histogram("resource_pool_acquire_wait", "Time acquire() blocked waiting for a slot")),
+      acquireTimeouts(instrumentation::counter("resource_pool_acquire_timeouts", "acquire() calls that timed out")) {
+    if (resources.size() >= NoSlot) {
+        throw std::length_error("ResourcePool: too many resources");
+    }
+    shared->capacity = resources.size();
+    shared->slots = std::make_unique<Slot[]>(resources.size());
+    for (size_t i = resources.size(); i-- > 0;) {
+        shared->slots[i].resource = resources[i];
+        shared->push(static_cast<uint32_t>(i));
+    }
+}
+
+ResourcePool::~ResourcePool() {
+    shared->retired.store(true, std::memory_order_relaxed);
+}
+
+// One magazine per (thread, pool); magazines of destroyed pools are dropped
+// the next time the thread looks up a magazine
+ResourcePool::Magazine& ResourcePool::localMagazine() {
+    struct MagazineList {
+        std::vector<std::unique_ptr<Magazine>> magazines;
+        Magazine* last = nullptr;
+    };
+    thread_local MagazineList list;
+    if (list.last && list.last->shared == shared) {
+        return *list.last;
+    }
+    auto& magazines = list.magazines;
+    for (size_t i = 0; i < magazines.size(); ++i) {
+        if (magazines[i]->shared == shared) {
+            list.last = magazines[i].get();
+            return *list.last;
+        }
+        if (magazines[i]->shared->retired.load(std::memory_order_relaxed)) {
+            magazines.erase(magazines.begin() + i);
+            --i;
+        }
+    }
+    magazines.push_back(std::make_unique<Magazine>(shared));
+    list.last = magazines.back().get();
+    return *list.last;
+}
+
+uint32_t ResourcePool::popFree() {
+    if (magazineSize > 0) {
+        Magazine& magazine = localMagazine();
+        uint64_t epoch = shared->flushEpoch.load(std::memory_order_relaxed);
+        if (epoch != magazine.seenEpoch) {
+            magazine.seenEpoch = epoch;
+            magazine.flush();
+        }
+        size_t n = magazine.count.load(std::memory_order_relaxed);
+        if (n > 0) {
+            magazine.count.store(n - 1, std::memory_order_relaxed);
+            return magazine.items[n - 1];
+        }
+    }
+    return shared->pop();
+}
+
+ResourcePool::ResourceHandle ResourcePool::acquireResource() {
+    uint32_t slot = popFree();
+    if (slot == NoSlot) {
+        throw std::runtime_error("ResourcePool: no resources available");
+    }
+    return ResourceHandle(*this, slot);
+}
+
+ResourcePool::ResourceHandle ResourcePool::tryAcquire() {
+    uint32_t slot = popFree();
+    return slot == NoSlot ? ResourceHandle() : ResourceHandle(*this, slot);
+}
+
+ResourcePool::ResourceHandle ResourcePool::acquire(std::chrono::milliseconds timeout) {
+    uint32_t slot = popFree();
+    if (slot != NoSlot) {
+        return ResourceHandle(*this, slot);
+    }
+    
+    auto waitStart = instrumentation::Timestamp::now();
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    shared->waiters.fetch_add(1);
+    shared->flushEpoch.fetch_add(1, std::memory_order_relaxed);  // Ask threads to drain magazines
+    {
+        std::unique_lock<std::mutex> lock(shared->waitMutex);
+        while ((slot = shared->pop()) == NoSlot) {
+            if (shared->slotFreed.wait_until(lock, deadline) == std::cv_status::timeout) {
+                slot = shared->pop();
+                break;
+            }
+        }
+    }
+    shared->waiters.fetch_sub(1);
+    acquireWait.record(waitStart.elapsedNanos());
+    if (slot == NoSlot) {
+        acquireTimeouts.add();
+        return ResourceHandle();
+    }
+    return ResourceHandle(*this, slot);
+}
+
+// Waiters take priority over the local magazine so they are not starved
+void ResourcePool::releaseResource(uint32_t slot) {
+    if (magazineSize > 0 && shared->waiters.load() == 0) {
+        Magazine& magazine = localMagazine();
+        size_t n = magazine.count.load(std::memory_order_relaxed);
+        if (n < magazineSize) {
+            magazine.items[n] = slot;
+            magazine.count.store(n + 1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    shared->pushAndNotify(slot);
+}
+
+size_t ResourcePool::availableCount() const {
+    size_t count = shared->freeCount.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(shared->registryMutex);
+    for (const Magazine* magazine : shared->magazines) {
+        count += magazine->count.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+size_t ResourcePool::capacity() const {
+    return shared->capacity;
+}
+
+ResourcePool::ResourceHandle::ResourceHandle() : pool(nullptr), slot(NoSlot) {}
+
+ResourcePool::ResourceHandle::ResourceHandle(ResourcePool& p, uint32_t slotIndex) : pool(&p), slot(slotIndex) {}
+
+ResourcePool::ResourceHandle::~ResourceHandle() {
+    reset();
+}
+
+ResourcePool::ResourceHandle::ResourceHandle(ResourceHandle&& other) noexcept
+    : pool(other.pool), slot(other.slot) {
+    other.pool = nullptr;
+    other.slot = NoSlot;
+}
+
+ResourcePool::ResourceHandle& ResourcePool::ResourceHandle::operator=(ResourceHandle&& other) noexcept {
+    if (this != &other) {
+        reset();
+        pool = other.pool;
+        slot = other.slot;
+        other.pool = nullptr;
+        other.slot = NoSlot;
+    }
+    return *this;
+}
+
+const std::string& ResourcePool::ResourceHandle::getResource() const {
+    return pool->shared->slots[slot].resource;
+}
+
+uint32_t ResourcePool::ResourceHandle::getSlot() const {
+    return slot;
+}
+
+bool ResourcePool::ResourceHandle::isValid() const {
+    return pool != nullptr;
+}
+
+void ResourcePool::ResourceHandle::reset() {
+    if (pool) {
+        pool->releaseResource(slot);
+        pool = nullptr;
+        slot = NoSlot;
+    }
+}
@@ -14,17 +14,35 @@
 #include <utility>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "allocation_counter.h"
+#include "static_format.h"
 
 // TODO: Implement these classes
 
 // 1. Basic Move Semantics Demo
+// Strings up to SSO_CAPACITY chars are stored inline (data points at
+// inlineBuffer), so moving them copies a few bytes instead of stealing a
+// heap pointer. Only heap strings have a buffer worth stealing.
 class MyString {
 private:
+    static constexpr size_t SSO_CAPACITY = 15;
+
     char* data;
     size_t size;
+    size_t capacity;  // Usable chars, excluding the terminator
+    char inlineBuffer[SSO_CAPACITY + 1];
+
+    bool isInline() const { return data == inlineBuffer; }
+    void resetToInline();
     
 public:
-    // TODO: Implement all constructors and operators
     MyString();                                    // Default constructor
     MyString(const char* str);                     // Constructor from C-string
     MyString(const MyString& other);               // Copy constructor
@@ -32,11 +50,17 @@ public:
     MyString& operator=(const MyString& other);    // Copy assignment
     MyString& operator=(MyString&& other) noexcept; // Move assignment
     ~MyString();                                   // Destructor
+
+    // Concatenation: the && overload appends into the expiring left operand
+    MyString& operator+=(const MyString& other);   // Geometric growth
+    MyString operator+(const MyString& other) const&;
+    MyString operator+(const MyString& other) &&;
     
     // Utility functions
     void print() const;
     size_t length() const;
     const char* c_str() const;
+    bool isSmall() const { return isInline(); }
 };
 
 // 2. Move-Only Type (like unique_ptr)
@@ -64,6 +88,8 @@ public:
 };
 
 // 3. Perfect Forwarding Demo
+// Messages are formatted into a thread-local buffer (static_format.h) and
+// written with one fwrite, so concurrent log lines never interleave
 class Logger {
 public:
     template<typename T>
@@ -71,6 +97,10 @@ public:
     
     template<typename... Args>
     void logMultiple(Args&&... args);  // TODO: Variadic perfect forwarding
+    
+    // Format string checked at compile time: logFormat(FORMAT_STRING("{} of {}"), i, n)
+    template<typename Str, typename... Args>
+    void logFormat(Str format, const Args&... args);
 };
 
 // 4. RVO/NRVO Demonstration
@@ -107,6 +137,8 @@ void demonstratePerfectForwarding();
 void demonstrateRVO();
 void demonstrateMoveOnlyTypes();
 void demonstrateUniversalReferences();
+void demonstrateSmallStringMoves();
+void benchmarkLogFormatting();
 
 int main() {
     std::cout << "=== Move Semantics Examples ===\n\n";
@@ -120,6 +152,8 @@ int main() {
     demonstrateRVO();
     demonstrateMoveOnlyTypes();
     demonstrateUniversalReferences();
+    demonstrateSmallStringMoves();
+    benchmarkLogFormatting();
     
     return 0;
 }
@@ -157,6 +191,12 @@ void demonstratePerfectForwarding() {
     std::cout << "5. Perfect Forwarding:\n";
     // Use Logger class to show forwarding
     // Preserve value categories
+    Logger logger;
+    std::string user = "alice";
+    logger.log(user);
+    logger.log(std::string("temporary message"));
+    logger.logMultiple("user=", user, " id=", 42, " latency=", 1.25, " ok=", true);
+    logger.logFormat(FORMAT_STRING("{} requests in {} ms ({{escaped braces}})"), 1000u, 12.5);
     std::cout << "---\n\n";
 }
 
@@ -180,3 +220,246 @@ void demonstrateUniversalReferences() {
     // Demonstrate reference collapsing
     std::cout << "---\n\n";
 }
+
+void demonstrateSmallStringMoves() {
+    std::cout << "9. Small-String Optimization and Moves:\n";
+
+    MyString small("tiny");
+    const char* smallBuffer = small.c_str();
+    MyString movedSmall(std::move(small));
+    std::cout << "Inline string moved by copying bytes, buffer changed: "
+              << (movedSmall.c_str() != smallBuffer ? "yes" : "no") << "\n";
+
+    MyString large("this one is long enough to live on the heap");
+    const char* largeBuffer = large.c_str();
+    MyString movedLarge(std::move(large));
+    std::cout << "Heap string moved by stealing the pointer, buffer kept: "
+              << (movedLarge.c_str() == largeBuffer ? "yes" : "no")
+              << ", source now \"" << large.c_str() << "\"\n";
+
+    // (a + b) is a temporary, so the next + appends into its buffer
+    MyString path = MyString("usr") + "/" + "local" + "/" + "include/c++/12";
+    std::cout << "Chained rvalue +: ";
+    path.print();
+    std::cout << " (" << path.length() << " chars, inline: " << (path.isSmall() ? "yes" : "no") << ")\n";
+    std::cout << "---\n\n";
+}
+
+struct LogRecord {
+    std::string user;
+    int id;
+    double latency;
+    bool ok;
+};
+
+template<typename Fn>
+static AllocationRun timeMessages(const std::vector<LogRecord>& records, Fn emit) {
+    return measureAllocations(records.size(), [&] {
+        for (const LogRecord& r : records) {
+            emit(r);
+        }
+    });
+}
+
+void benchmarkLogFormatting() {
+    std::cout << "10. Log Formatting Benchmark:\n";
+    const size_t messages = 200000;
+    std::vector<LogRecord> records;
+    for (size_t i = 0; i < messages; ++i) {
+        records.push_back({i % 2 ? "alice" : "bob", static_cast<int>(i), 0.5 + static_cast<double>(i % 1000) / 8,
+                           i % 3 != 0});
+    }
+    
+    // Every variant writes the same fields to /dev/null
+    std::ofstream stream("/dev/null");
+    std::FILE* sink = std::fopen("/dev/null", "w");
+    if (!stream || !sink) {
+        std::cout << "Cannot open /dev/null, skipping\n---\n\n";
+        return;
+    }
+    
+    struct Row {
+        const char* name;
+        AllocationRun run;
+    };
+    Row rows[] = {
+        {"std::ostream <<", timeMessages(records, [&](const LogRecord& r) {
+             stream << "user=" << r.user << " id=" << r.id << " latency=" << r.latency << " ok=" << std::boolalpha
+                    << r.ok << '\n';
+         })},
+        {"std::ostringstream + write", timeMessages(records, [&](const LogRecord& r) {
+             std::ostringstream line;
+             line << "user=" << r.user << " id=" << r.id << " latency=" << r.latency << " ok=" << std::boolalpha
+                  << r.ok << '\n';
+             std::string text = line.str();
+             std::fwrite(text.data(), 1, text.size(), sink);
+         })},
+        {"snprintf + fwrite", timeMessages(records, [&](const LogRecord& r) {
+             char line[256];
+             int length = std::snprintf(line, sizeof(line), "user=%s id=%d latency=%g ok=%s\n", r.user.c_str(), r.id,
+                                        r.latency, r.ok ? "true" : "false");
+             std::fwrite(line, 1, static_cast<size_t>(length), sink);
+         })},
+        {"writeFormatted (static_format.h)", timeMessages(records, [&](const LogRecord& r) {
+             writeFormatted(sink, FORMAT_STRING("user={} id={} latency={} ok={}\n"), r.user, r.id, r.latency, r.ok);
+         })},
+    };
+    stream.flush();
+    std::fclose(sink);
+    
+    std::cout << messages << " messages\n";
+    std::cout << std::left << std::setw(36) << "Formatter" << std::right << std::setw(12) << "ns/message"
+              << std::setw(16) << "allocs/message" << "\n";
+    for (const Row& row : rows) {
+        std::cout << std::left << std::setw(36) << row.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << row.run.nsPerOp << std::setprecision(2) << std::setw(16)
+                  << row.run.allocationsPerOp << "\n";
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6) << "---\n\n";
+}
+
+// MyString implementation
+MyString::MyString() : data(inlineBuffer), size(0), capacity(SSO_CAPACITY) {
+    inlineBuffer[0] = '\0';
+}
+
+MyString::MyString(const char* str) : MyString() {
+    size_t length = str ? std::strlen(str) : 0;
+    if (length > capacity) {
+        data = new char[length + 1];
+        capacity = length;
+    }
+    if (length > 0) {
+        std::memcpy(data, str, length);
+    }
+    size = length;
+    data[size] = '\0';
+}
+
+MyString::MyString(const MyString& other) : MyString() {
+    *this = other;
+}
+
+MyString::MyString(MyString&& other) noexcept : data(inlineBuffer), size(other.size), capacity(SSO_CAPACITY) {
+    if (other.isInline()) {
+        std::memcpy(inlineBuffer, other.inlineBuffer, size + 1);
+    } else {
+        data = other.data;
+        capacity = other.capacity;
+    }
+    other.resetToInline();
+}
+
+MyString& MyString::operator=(const MyString& other) {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.size > capacity) {
+        char* buffer = new char[other.size + 1];
+        if (!isInline()) {
+            delete[] data;
+        }
+        data = buffer;
+        capacity = other.size;
+    }
+    std::memcpy(data, other.data, other.size + 1);
+    size = other.size;
+    return *this;
+}
+
+MyString& MyString::operator=(MyString&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.isInline()) {
+        std::memcpy(data, other.inlineBuffer, other.size + 1);
+        size = other.size;
+    } else {
+        if (!isInline()) {
+            delete[] data;
+        }
+        data = other.data;
+        size = other.size;
+        capacity = other.capacity;
+    }
+    other.resetToInline();
+    return *this;
+}
+
+MyString::~MyString() {
+    if (!isInline()) {
+        delete[] data;
+    }
+}
+
+void MyString::resetToInline() {
+    data = inlineBuffer;
+    size = 0;
+    capacity = SSO_CAPACITY;
+    inlineBuffer[0] = '\0';
+}
+
+MyString& MyString::operator+=(const MyString& other) {
+    const size_t otherSize = other.size;  // other may be *this
+    if (size + otherSize > capacity) {
+        size_t newCapacity = std::max(size + otherSize, capacity * 2);
+        char* buffer = new char[newCapacity + 1];
+        std::memcpy(buffer, data, size);
+        std::memcpy(buffer + size, other.data, otherSize);
+        if (!isInline()) {
+            delete[] data;
+        }
+        data = buffer;
+        capacity = newCapacity;
+    } else {
+        std::memmove(data + size, other.data, otherSize);
+    }
+    size += otherSize;
+    data[size] = '\0';
+    return *this;
+}
+
+MyString MyString::operator+(const MyString& other) const& {
+    MyString result(*this);
+    result += other;
+    return result;
+}
+
+MyString MyString::operator+(const MyString& other) && {
+    *this += other;
+    return std::move(*this);
+}
+
+void MyString::print() const {
+    std::cout << data;
+}
+
+size_t MyString::length() const {
+    return size;
+}
+
+const char* MyString::c_str() const {
+    return data;
+}
+
+// Logger implementation
+template<typename T>
+void Logger::log(T&& message) {
+    printFormatted(FORMAT_STRING("[LOG] {}\n"), std::forward<T>(message));
+}
+
+template<typename... Args>
+void Logger::logMultiple(Args&&... args) {
+    printJoined("", "[LOG] ", std::forward<Args>(args)...);
+}
+
+template<typename Str, typename... Args>
+void Logger::logFormat(Str format, const Args&... args) {
+    FormatBuffer& out = threadFormatBuffer();
+    out.setSink(stdout);
+    out.append("[LOG] ", 6);
+    formatTo(out, format, args...);
+    out.append('\n');
+    out.flush();
+}
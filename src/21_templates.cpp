@@ -15,6 +15,18 @@
 #include <string>
 #include <vector>
 #include <type_traits>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <new>
+#include <stack>
+#include <utility>
+
+#include "static_format.h"
 
 // TODO: Implement these template functions
 
@@ -42,58 +54,213 @@ template<>
 void print<std::string>(const std::string& value);
 
 // 3. Class Templates
+namespace stack_detail {
+
+// Compile-time evaluation cannot call memcpy. __builtin_is_constant_evaluated
+// (GCC 9+, Clang 9+) is C++20's std::is_constant_evaluated, usable in C++17;
+// elsewhere the element loop is always taken.
+constexpr bool isConstantEvaluated() {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+}
+
+// Trivial T: a plain array, so the stack is a literal type and every
+// operation works in constant expressions
+template<typename T, size_t Size, bool Trivial = std::is_trivial<T>::value>
+class StackStorage {
+protected:
+    T slots[Size == 0 ? 1 : Size]{};
+    size_t top = 0;
+    
+    constexpr T* base() { return slots; }
+    constexpr T& slot(size_t i) { return slots[i]; }
+    constexpr const T& slot(size_t i) const { return slots[i]; }
+    template<typename... Args>
+    constexpr void construct(size_t i, Args&&... args) { slots[i] = T(std::forward<Args>(args)...); }
+    constexpr void destroy(size_t) {}
+    constexpr void clear() { top = 0; }
+};
+
+// Any other T: raw bytes, so an element is constructed on push and
+// destroyed on pop, and an empty stack constructs nothing
+template<typename T, size_t Size>
+class StackStorage<T, Size, false> {
+protected:
+    alignas(T) unsigned char bytes[(Size == 0 ? 1 : Size) * sizeof(T)];
+    size_t top = 0;
+    
+    T* base() { return reinterpret_cast<T*>(bytes); }
+    T& slot(size_t i) { return *std::launder(reinterpret_cast<T*>(bytes) + i); }
+    const T& slot(size_t i) const { return *std::launder(reinterpret_cast<const T*>(bytes) + i); }
+    template<typename... Args>
+    void construct(size_t i, Args&&... args) { ::new (static_cast<void*>(bytes + i * sizeof(T))) T(std::forward<Args>(args)...); }
+    void destroy(size_t i) { slot(i).~T(); }
+    void clear() {
+        while (top > 0) {
+            destroy(--top);
+        }
+    }
+    
+    template<typename Source>
+    void constructFrom(Source& other) {
+        try {
+            for (; top < other.top; ++top) {
+                construct(top, std::move_if_noexcept(other.slot(top)));
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    
+    StackStorage() = default;
+    StackStorage(const StackStorage& other) { constructFrom(other); }
+    StackStorage(StackStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        constructFrom(other);
+        other.clear();
+    }
+    StackStorage& operator=(const StackStorage& other) {
+        if (this != &other) {
+            clear();
+            constructFrom(other);
+        }
+        return *this;
+    }
+    StackStorage& operator=(StackStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+            constructFrom(other);
+            other.clear();
+        }
+        return *this;
+    }
+    ~StackStorage() { clear(); }
+};
+
+} // namespace stack_detail
+
+// Fixed-capacity stack; storage is picked at compile time (see StackStorage).
+// push_n/pop_n copy whole blocks with memcpy for trivially copyable T, and
+// push_unsafe skips the capacity check for callers that already proved room.
 template<typename T, size_t Size = 10>
-class Stack {
+class Stack : private stack_detail::StackStorage<T, Size> {
 private:
-    T data[Size];
-    size_t top;
+    using Storage = stack_detail::StackStorage<T, Size>;
+    using Storage::top;
+    using Storage::base;
+    using Storage::slot;
+    using Storage::construct;
+    using Storage::destroy;
+    
+    void pushEach(const T* items, size_t count);
     
 public:
-    Stack();
+    Stack() = default;
     
-    bool push(const T& item);
-    bool pop(T& item);
-    bool peek(T& item) const;
-    bool isEmpty() const;
-    bool isFull() const;
-    size_t size() const;
-    size_t capacity() const;
+    constexpr bool push(const T& item);
+    constexpr bool push(T&& item);
+    template<typename... Args>
+    constexpr bool emplace(Args&&... args);
+    // Precondition: !isFull() (asserted in debug builds)
+    constexpr void push_unsafe(const T& item);
+    constexpr void push_unsafe(T&& item);
+    constexpr bool pop(T& item);
+    constexpr bool peek(T& item) const;
+    
+    // All or nothing: false, and no change, if count elements do not fit or
+    // are not there. items[count - 1] ends on top; pop_n writes the old top
+    // to out[count - 1], so push_n followed by pop_n round-trips.
+    constexpr bool push_n(const T* items, size_t count);
+    constexpr bool pop_n(T* out, size_t count);
+    constexpr void clear() { Storage::clear(); }
+    
+    constexpr bool isEmpty() const;
+    constexpr bool isFull() const;
+    constexpr size_t size() const;
+    constexpr size_t capacity() const;
 };
 
 // 4. Class Template Specialization
-template<typename T>
+// Growable array over raw storage: geometric growth by growthFactor,
+// memcpy relocation for trivially copyable T and std::move_if_noexcept
+// otherwise, and an inline buffer for the first InlineCapacity elements
+template<typename T, size_t InlineCapacity = 0>
 class Container {
 private:
     T* data;
     size_t size_;
     size_t capacity_;
+    double growthFactor;
+    alignas(T) unsigned char inlineBuffer[InlineCapacity == 0 ? 1 : InlineCapacity * sizeof(T)];
+    
+    T* inlineData() { return reinterpret_cast<T*>(inlineBuffer); }
+    bool isInline() const { return data == reinterpret_cast<const T*>(inlineBuffer); }
+    static T* allocate(size_t n);
+    void deallocate(T* ptr);
+    size_t grownCapacity(size_t required) const;
+    void reallocate(size_t newCapacity);
+    static void relocate(T* from, size_t count, T* to);
+    void stealFrom(Container& other);
     
 public:
-    Container(size_t initial_capacity = 10);
+    Container(size_t initial_capacity = 10, double growth = 2.0);
+    Container(const Container& other);
+    Container(Container&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+    Container& operator=(Container other) noexcept(std::is_nothrow_move_constructible<T>::value);
     ~Container();
     
     void add(const T& item);
+    void add(T&& item);
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+    template<typename InputIt>
+    void append(InputIt first, InputIt last);
+    void clear();
+    
+    void reserve(size_t new_capacity);
+    void shrink_to_fit();
+    
     T& get(size_t index);
     size_t size() const;
+    size_t capacity() const;
+    T* begin() { return data; }
+    T* end() { return data + size_; }
     void print() const;
 };
 
-// Specialization for bool
+// Specialization for bool: a packed bitset, 64 flags per word, so count()
+// and find_first() test a whole word per step. Bits past size() are kept
+// zero.
 template<>
 class Container<bool> {
 private:
-    std::vector<bool> data;
+    std::vector<uint64_t> words;
+    size_t bits;
     
 public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
     Container(size_t initial_capacity = 10);
     
     void add(bool item);
-    bool get(size_t index) const;
+    // Precondition: index < size() (asserted in debug builds); a set past
+    // the end would break the zero-tail that count() relies on
+    void set(size_t index, bool value);
+    bool get(size_t index) const;             // Precondition: index < size()
     size_t size() const;
+    size_t count() const;                     // Number of true flags
+    size_t find_first() const;                // First true flag, or npos
+    size_t find_next(size_t index) const;     // First true flag after index, or npos
     void print() const;
 };
 
 // 5. Variadic Templates
+// Prints the values separated by spaces as one line. Formatting is
+// dispatched per type at compile time into a thread-local buffer
+// (static_format.h) and written with a single fwrite.
 template<typename T>
 void printAll(const T& value);
 
@@ -164,6 +331,9 @@ void demonstrateVariadicTemplates();
 void demonstrateSFINAE();
 void demonstrateTemplateMetaprogramming();
 void demonstrateTemplateInstantiation();
+void benchmarkContainerGrowth();
+void benchmarkStackAndBitset();
+constexpr int sumViaStack();
 
 int main() {
     std::cout << "=== Templates Examples ===\n\n";
@@ -176,6 +346,8 @@ int main() {
     demonstrateSFINAE();
     demonstrateTemplateMetaprogramming();
     demonstrateTemplateInstantiation();
+    benchmarkContainerGrowth();
+    benchmarkStackAndBitset();
     
     return 0;
 }
@@ -193,6 +365,30 @@ void demonstrateClassTemplates() {
     std::cout << "2. Class Templates:\n";
     // Create Stack instances with different types
     // Show template parameter usage
+    Stack<int, 4> ints;
+    int next = 10;
+    while (ints.push(next)) {
+        next += 10;
+    }
+    int top = 0;
+    ints.peek(top);
+    std::cout << "Stack<int, 4>: pushed until full, size " << ints.size() << "/" << ints.capacity()
+              << ", top " << top << "\n";
+    
+    int block[3] = {0, 0, 0};
+    bool popped = ints.pop_n(block, 3);
+    std::cout << "pop_n(3): " << (popped ? "ok" : "failed") << " -> " << block[0] << " " << block[1] << " "
+              << block[2] << ", " << ints.size() << " left; push_n(5) fits: " << std::boolalpha
+              << ints.push_n(block, 5) << std::noboolalpha << "\n";
+    
+    Stack<std::string> names;  // Raw storage: only pushed strings are constructed
+    names.emplace(3, 'a');
+    names.push("template");
+    std::string name;
+    while (names.pop(name)) {
+        std::cout << "popped \"" << name << "\"\n";
+    }
+    std::cout << "sumViaStack(): " << sumViaStack() << " (also checked at compile time by a static_assert)\n";
     
     std::cout << "---\n\n";
 }
@@ -201,6 +397,14 @@ void demonstrateTemplateSpecialization() {
     std::cout << "3. Template Specialization:\n";
     // Show function and class template specialization
     // Compare generic vs specialized behavior
+    Container<bool> flags;
+    for (int i = 0; i < 70; ++i) {
+        flags.add(i % 3 == 0);
+    }
+    flags.set(0, false);
+    std::cout << "Container<bool>: " << flags.size() << " flags in " << sizeof(uint64_t) * ((flags.size() + 63) / 64)
+              << " bytes, " << flags.count() << " set, first at " << flags.find_first() << ", next after 63 at "
+              << flags.find_next(63) << "\n";
     
     std::cout << "---\n\n";
 }
@@ -209,6 +413,8 @@ void demonstrateVariadicTemplates() {
     std::cout << "4. Variadic Templates:\n";
     // Use printAll with different numbers of arguments
     // Create Tuple instances
+    printAll("single");
+    printAll("mixed:", 42, -7L, 3.5, 'c', true, std::string("string"));
     
     std::cout << "---\n\n";
 }
@@ -237,4 +443,743 @@ void demonstrateTemplateInstantiation() {
     std::cout << "---\n\n";
 }
 
+static volatile int containerSink = 0;
+
+// Counts how the element type is carried across reallocations
+struct TrackedValue {
+    static inline size_t copies = 0;
+    static inline size_t moves = 0;
+    int value;
+    
+    TrackedValue(int v = 0) : value(v) {}
+    TrackedValue(const TrackedValue& other) : value(other.value) { ++copies; }
+    TrackedValue(TrackedValue&& other) noexcept : value(other.value) { ++moves; }
+};
+
+template<typename Fn>
+static double timeMs(int repeats, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        fn();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+void benchmarkContainerGrowth() {
+    std::cout << "8. Container<T, N> Growth and push_back Benchmark:\n";
+    
+    // Reallocations for different growth factors
+    for (double growth : {2.0, 1.5}) {
+        Container<int> c(1, growth);
+        size_t reallocations = 0;
+        for (int i = 0; i < 1000; ++i) {
+            size_t before = c.capacity();
+            c.add(i);
+            reallocations += c.capacity() != before;
+        }
+        std::cout << "growth " << growth << ": 1000 adds, " << reallocations
+                  << " reallocations, final capacity " << c.capacity() << "\n";
+    }
+    
+    // Non-trivial T with a noexcept move is moved, never copied, on growth
+    Container<TrackedValue> tracked(1);
+    for (int i = 0; i < 1000; ++i) {
+        tracked.emplace_back(i);
+    }
+    std::cout << "1000 emplace_back of TrackedValue: " << TrackedValue::copies << " copies, "
+              << TrackedValue::moves << " moves during growth\n";
+    
+    Container<int, 8> small(0);
+    int values[] = {1, 2, 3, 4, 5, 6};
+    small.append(std::begin(values), std::end(values));
+    std::cout << "Container<int, 8> after append(6): capacity " << small.capacity() << " (inline)\n";
+    
+    constexpr int N = 1000000;
+    constexpr int REPEATS = 20;
+    constexpr int SMALL_CONTAINERS = 100000;
+    std::cout << std::left << std::setw(40) << "Workload" << std::right << std::setw(14) << "Container ms"
+              << std::setw(12) << "vector ms" << "\n";
+    auto report = [](const char* label, double containerMs, double vectorMs) {
+        std::cout << std::left << std::setw(40) << label << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(14) << containerMs << std::setw(12) << vectorMs << "\n" << std::defaultfloat;
+    };
+    
+    report("1M int push_back",
+           timeMs(REPEATS, [] { Container<int> c(0); for (int i = 0; i < N; ++i) c.add(i); }),
+           timeMs(REPEATS, [] { std::vector<int> v; for (int i = 0; i < N; ++i) v.push_back(i); }));
+    report("1M int push_back after reserve",
+           timeMs(REPEATS, [] { Container<int> c(0); c.reserve(N); for (int i = 0; i < N; ++i) c.add(i); }),
+           timeMs(REPEATS, [] { std::vector<int> v; v.reserve(N); for (int i = 0; i < N; ++i) v.push_back(i); }));
+    report("100K std::string emplace_back",
+           timeMs(REPEATS / 4, [] { Container<std::string> c(0); for (int i = 0; i < N / 10; ++i) c.emplace_back(40, 'x'); }),
+           timeMs(REPEATS / 4, [] { std::vector<std::string> v; for (int i = 0; i < N / 10; ++i) v.emplace_back(40, 'x'); }));
+    report("100K containers of 8 ints (N = 8)",
+           timeMs(REPEATS / 4, [] {
+               for (int a = 0; a < SMALL_CONTAINERS; ++a) {
+                   Container<int, 8> c(0);
+                   for (int i = 0; i < 8; ++i) c.add(a + i);
+                   containerSink = c.get(7);
+               }
+           }),
+           timeMs(REPEATS / 4, [] {
+               for (int a = 0; a < SMALL_CONTAINERS; ++a) {
+                   std::vector<int> v;
+                   for (int i = 0; i < 8; ++i) v.push_back(a + i);
+                   containerSink = v[7];
+               }
+           }));
+    
+    std::cout << "---\n\n";
+}
+
+void benchmarkStackAndBitset() {
+    std::cout << "9. Stack<T, N> and Container<bool> Benchmark:\n";
+    
+    constexpr size_t N = 4096;
+    constexpr int ROUNDS = 1000;
+    constexpr int REPEATS = 10;
+    static int block[N];
+    for (size_t i = 0; i < N; ++i) {
+        block[i] = static_cast<int>(i);
+    }
+    std::cout << std::left << std::setw(40) << "Workload (4096 x 1000)" << std::right << std::setw(14) << "Stack ms"
+              << std::setw(12) << "std ms" << "\n";
+    auto report = [](const char* label, double stackMs, double stdMs) {
+        std::cout << std::left << std::setw(40) << label << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(14) << stackMs << std::setw(12) << stdMs << "\n" << std::defaultfloat;
+    };
+    
+    // std::stack over a reserved vector, so neither side allocates while timed
+    auto makeStdStack = [] {
+        std::vector<int> storage;
+        storage.reserve(N);
+        return std::stack<int, std::vector<int>>(std::move(storage));
+    };
+    
+    static Stack<int, N> ints;
+    auto stdInts = makeStdStack();
+    report("int push + pop, checked", timeMs(REPEATS, [] {
+               for (int r = 0; r < ROUNDS; ++r) {
+                   for (size_t i = 0; i < N; ++i) ints.push(block[i]);
+                   int value = 0;
+                   while (ints.pop(value)) containerSink = value;
+               }
+           }),
+           timeMs(REPEATS, [&stdInts] {
+               for (int r = 0; r < ROUNDS; ++r) {
+                   for (size_t i = 0; i < N; ++i) stdInts.push(block[i]);
+                   while (!stdInts.empty()) {
+                       containerSink = stdInts.top();
+                       stdInts.pop();
+                   }
+               }
+           }));
+    double uncheckedMs = timeMs(REPEATS, [] {
+        for (int r = 0; r < ROUNDS; ++r) {
+            for (size_t i = 0; i < N; ++i) ints.push_unsafe(block[i]);
+            int value = 0;
+            while (ints.pop(value)) containerSink = value;
+        }
+    });
+    static int out[N];
+    report("int push_n + pop_n (bulk memcpy)", timeMs(REPEATS, [] {
+               for (int r = 0; r < ROUNDS; ++r) {
+                   ints.push_n(block, N);
+                   ints.pop_n(out, N);
+                   containerSink = out[r % N];
+               }
+           }),
+           timeMs(REPEATS, [] {
+               // std::stack has no bulk operations; a reserved vector's range insert is the nearest
+               std::vector<int> v;
+               v.reserve(N);
+               for (int r = 0; r < ROUNDS; ++r) {
+                   v.insert(v.end(), block, block + N);
+                   std::copy(v.end() - N, v.end(), out);
+                   v.resize(v.size() - N);
+                   containerSink = out[r % N];
+               }
+           }));
+    static Stack<std::string, 256> strings;
+    report("256 std::string push + pop", timeMs(REPEATS, [] {
+               std::string value;
+               for (int r = 0; r < ROUNDS; ++r) {
+                   for (int i = 0; i < 256; ++i) strings.emplace(40, 'x');
+                   while (strings.pop(value)) containerSink = static_cast<int>(value.size());
+               }
+           }),
+           timeMs(REPEATS, [] {
+               std::vector<std::string> storage;
+               storage.reserve(256);
+               std::stack<std::string, std::vector<std::string>> stack(std::move(storage));
+               std::string value;
+               for (int r = 0; r < ROUNDS; ++r) {
+                   for (int i = 0; i < 256; ++i) stack.emplace(40, 'x');
+                   while (!stack.empty()) {
+                       value = std::move(stack.top());
+                       stack.pop();
+                       containerSink = static_cast<int>(value.size());
+                   }
+               }
+           }));
+    
+    std::cout << "push_unsafe + pop: " << std::fixed << std::setprecision(3) << uncheckedMs
+              << " ms (no capacity branch)\n" << std::defaultfloat;
+    
+    // Every 97th flag set: count and scan a word at a time vs a bit at a time
+    constexpr size_t BITS = 1 << 20;
+    Container<bool> flags(BITS);
+    std::vector<bool> reference;
+    reference.reserve(BITS);
+    for (size_t i = 0; i < BITS; ++i) {
+        flags.add(i % 97 == 0);
+        reference.push_back(i % 97 == 0);
+    }
+    std::cout << std::left << std::setw(40) << "Workload (1M flags)" << std::right << std::setw(14)
+              << "Container ms" << std::setw(12) << "vector ms" << "\n";
+    report("count()", timeMs(REPEATS, [&flags] { containerSink = static_cast<int>(flags.count()); }),
+           timeMs(REPEATS, [&reference] {
+               containerSink = static_cast<int>(std::count(reference.begin(), reference.end(), true));
+           }));
+    report("visit every set flag", timeMs(REPEATS, [&flags] {
+               int visited = 0;
+               for (size_t i = flags.find_first(); i != Container<bool>::npos; i = flags.find_next(i)) ++visited;
+               containerSink = visited;
+           }),
+           timeMs(REPEATS, [&reference] {
+               int visited = 0;
+               for (auto it = std::find(reference.begin(), reference.end(), true); it != reference.end();
+                    it = std::find(it + 1, reference.end(), true)) {
+                   ++visited;
+               }
+               containerSink = visited;
+           }));
+    
+    std::cout << "---\n\n";
+}
+
 // TODO: Implement all template functions and methods
+
+// Stack implementation
+template<typename T, size_t Size>
+constexpr bool Stack<T, Size>::push(const T& item) {
+    if (isFull()) {
+        return false;
+    }
+    construct(top, item);
+    ++top;
+    return true;
+}
+
+template<typename T, size_t Size>
+constexpr bool Stack<T, Size>::push(T&& item) {
+    if (isFull()) {
+        return false;
+    }
+    construct(top, std::move(item));
+    ++top;
+    return true;
+}
+
+template<typename T, size_t Size>
+template<typename... Args>
+constexpr bool Stack<T, Size>::emplace(Args&&... args) {
+    if (isFull()) {
+        return false;
+    }
+    construct(top, std::forward<Args>(args)...);
+    ++top;
+    return true;
+}
+
+template<typename T, size_t Size>
+constexpr void Stack<T, Size>::push_unsafe(const T& item) {
+    assert(!isFull());
+    construct(top, item);
+    ++top;
+}
+
+template<typename T, size_t Size>
+constexpr void Stack<T, Size>::push_unsafe(T&& item) {
+    assert(!isFull());
+    construct(top, std::move(item));
+    ++top;
+}
+
+// The element is removed only after it was handed over, so a throwing
+// assignment leaves the stack unchanged
+template<typename T, size_t Size>
+constexpr bool Stack<T, Size>::pop(T& item) {
+    if (isEmpty()) {
+        return false;
+    }
+    item = std::move(slot(top - 1));
+    destroy(top - 1);
+    --top;
+    return true;
+}
+
+template<typename T, size_t Size>
+constexpr bool Stack<T, Size>::peek(T& item) const {
+    if (isEmpty()) {
+        return false;
+    }
+    item = slot(top - 1);
+    return true;
+}
+
+// Copy-constructs the block; on a throw the copies made so far are destroyed
+template<typename T, size_t Size>
+void Stack<T, Size>::pushEach(const T* items, size_t count) {
+    size_t built = 0;
+    try {
+        for (; built < count; ++built) {
+            construct(top + built, items[built]);
+        }
+    } catch (...) {
+        while (built > 0) {
+            destroy(top + --built);
+        }
+        throw;
+    }
+    top += count;
+}
+
+template<typename T, size_t Size>
+constexpr bool Stack<T, Size>::push_n(const T* items, size_t count) {
+    if (count > Size - top) {
+        return false;
+    }
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (!stack_detail::isConstantEvaluated()) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(base() + top), items, count * sizeof(T));
+            }
+            top += count;
+            return true;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            construct(top + i, items[i]);
+        }
+        top += count;
+    } else {
+        pushEach(items, count);
+    }
+    return true;
+}
+
+// Elements are copied out (moved if that cannot throw) before any is
+// destroyed, so a throwing copy leaves the stack unchanged
+template<typename T, size_t Size>
+constexpr bool Stack<T, Size>::pop_n(T* out, size_t count) {
+    if (count > top) {
+        return false;
+    }
+    size_t first = top - count;
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (!stack_detail::isConstantEvaluated()) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(out), base() + first, count * sizeof(T));
+            }
+            top = first;
+            return true;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::move_if_noexcept(slot(first + i));
+    }
+    while (top > first) {
+        destroy(--top);
+    }
+    return true;
+}
+
+template<typename T, size_t Size>
+constexpr bool Stack<T, Size>::isEmpty() const {
+    return top == 0;
+}
+
+template<typename T, size_t Size>
+constexpr bool Stack<T, Size>::isFull() const {
+    return top == Size;
+}
+
+template<typename T, size_t Size>
+constexpr size_t Stack<T, Size>::size() const {
+    return top;
+}
+
+template<typename T, size_t Size>
+constexpr size_t Stack<T, Size>::capacity() const {
+    return Size;
+}
+
+// A Stack of a trivial type is a literal type, so it runs at compile time
+constexpr int sumViaStack() {
+    Stack<int, 8> stack;
+    int values[] = {1, 2, 3, 4, 5};
+    stack.push_n(values, 5);
+    int sum = 0;
+    int value = 0;
+    while (stack.pop(value)) {
+        sum += value;
+    }
+    return sum;
+}
+
+static_assert(sumViaStack() == 15, "Stack<int> must be usable in constant expressions");
+
+// Container implementation
+template<typename T, size_t InlineCapacity>
+Container<T, InlineCapacity>::Container(size_t initial_capacity, double growth)
+    : data(inlineData()), size_(0), capacity_(InlineCapacity), growthFactor(growth > 1.0 ? growth : 2.0) {
+    if (initial_capacity > InlineCapacity) {
+        data = allocate(initial_capacity);
+        capacity_ = initial_capacity;
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+Container<T, InlineCapacity>::Container(const Container& other)
+    : Container(other.size_, other.growthFactor) {
+    append(other.data, other.data + other.size_);
+}
+
+template<typename T, size_t InlineCapacity>
+Container<T, InlineCapacity>::Container(Container&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    : data(inlineData()), size_(0), capacity_(InlineCapacity), growthFactor(other.growthFactor) {
+    stealFrom(other);
+}
+
+// Copy-and-swap style: the argument is already a copy (or a moved-from source)
+template<typename T, size_t InlineCapacity>
+Container<T, InlineCapacity>& Container<T, InlineCapacity>::operator=(Container other)
+    noexcept(std::is_nothrow_move_constructible<T>::value) {
+    clear();
+    deallocate(data);
+    data = inlineData();
+    capacity_ = InlineCapacity;
+    growthFactor = other.growthFactor;
+    stealFrom(other);
+    return *this;
+}
+
+template<typename T, size_t InlineCapacity>
+Container<T, InlineCapacity>::~Container() {
+    clear();
+    deallocate(data);
+}
+
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::add(const T& item) {
+    emplace_back(item);
+}
+
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::add(T&& item) {
+    emplace_back(std::move(item));
+}
+
+// On growth the new element is built first, so add(get(0)) stays valid
+template<typename T, size_t InlineCapacity>
+template<typename... Args>
+T& Container<T, InlineCapacity>::emplace_back(Args&&... args) {
+    if (size_ < capacity_) {
+        T* slot = new (data + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+    const size_t new_capacity = grownCapacity(size_ + 1);
+    T* new_data = allocate(new_capacity);
+    T* slot = nullptr;
+    try {
+        slot = new (new_data + size_) T(std::forward<Args>(args)...);
+        relocate(data, size_, new_data);
+    } catch (...) {
+        if (slot) {
+            slot->~T();
+        }
+        deallocate(new_data);
+        throw;
+    }
+    deallocate(data);
+    data = new_data;
+    capacity_ = new_capacity;
+    ++size_;
+    return *slot;
+}
+
+template<typename T, size_t InlineCapacity>
+template<typename InputIt>
+void Container<T, InlineCapacity>::append(InputIt first, InputIt last) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (size_ + count > capacity_) {
+            reallocate(grownCapacity(size_ + count));
+        }
+        if constexpr (std::is_trivially_copyable<T>::value && std::is_pointer<InputIt>::value &&
+                      std::is_same<typename std::remove_cv<typename std::remove_pointer<InputIt>::type>::type, T>::value) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(data + size_), first, count * sizeof(T));
+            }
+            size_ += count;
+        } else {
+            for (; first != last; ++first) {
+                new (data + size_) T(*first);
+                ++size_;
+            }
+        }
+    } else {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::clear() {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        for (size_t i = 0; i < size_; ++i) {
+            data[i].~T();
+        }
+    }
+    size_ = 0;
+}
+
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::reserve(size_t new_capacity) {
+    if (new_capacity > capacity_) {
+        reallocate(new_capacity);
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::shrink_to_fit() {
+    if (isInline() || size_ == capacity_) {
+        return;
+    }
+    if (size_ <= InlineCapacity) {
+        relocate(data, size_, inlineData());
+        deallocate(data);
+        data = inlineData();
+        capacity_ = InlineCapacity;
+    } else {
+        reallocate(size_);
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+T& Container<T, InlineCapacity>::get(size_t index) {
+    return data[index];
+}
+
+template<typename T, size_t InlineCapacity>
+size_t Container<T, InlineCapacity>::size() const {
+    return size_;
+}
+
+template<typename T, size_t InlineCapacity>
+size_t Container<T, InlineCapacity>::capacity() const {
+    return capacity_;
+}
+
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::print() const {
+    std::cout << "[";
+    for (size_t i = 0; i < size_; ++i) {
+        std::cout << (i ? ", " : "") << data[i];
+    }
+    std::cout << "]\n";
+}
+
+template<typename T, size_t InlineCapacity>
+T* Container<T, InlineCapacity>::allocate(size_t n) {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::deallocate(T* ptr) {
+    if (ptr == inlineData()) {
+        return;
+    }
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(ptr, std::align_val_t(alignof(T)));
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+template<typename T, size_t InlineCapacity>
+size_t Container<T, InlineCapacity>::grownCapacity(size_t required) const {
+    size_t grown = static_cast<size_t>(static_cast<double>(capacity_) * growthFactor);
+    return std::max({grown, capacity_ + 1, required});
+}
+
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::reallocate(size_t new_capacity) {
+    T* new_data = allocate(new_capacity);
+    try {
+        relocate(data, size_, new_data);
+    } catch (...) {
+        deallocate(new_data);
+        throw;
+    }
+    deallocate(data);
+    data = new_data;
+    capacity_ = new_capacity;
+}
+
+// memcpy for trivially copyable T; otherwise move if noexcept, else copy,
+// so a throwing copy leaves the source intact
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::relocate(T* from, size_t count, T* to) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (count > 0) {
+            std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+        }
+    } else {
+        size_t built = 0;
+        try {
+            for (; built < count; ++built) {
+                new (to + built) T(std::move_if_noexcept(from[built]));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < built; ++i) {
+                to[i].~T();
+            }
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            from[i].~T();
+        }
+    }
+}
+
+// Takes other's heap buffer, or moves its inline elements; *this must be empty
+template<typename T, size_t InlineCapacity>
+void Container<T, InlineCapacity>::stealFrom(Container& other) {
+    if (other.isInline()) {
+        relocate(other.data, other.size_, data);
+    } else {
+        data = other.data;
+        capacity_ = other.capacity_;
+        other.data = other.inlineData();
+        other.capacity_ = InlineCapacity;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+}
+
+// Container<bool> implementation
+static int popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Index of the lowest set bit; word must be non-zero
+static int ctz64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    for (; (word & 1) == 0; word >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+Container<bool>::Container(size_t initial_capacity) : bits(0) {
+    words.reserve((initial_capacity + 63) / 64);
+}
+
+void Container<bool>::add(bool item) {
+    if (bits % 64 == 0) {
+        words.push_back(0);
+    }
+    words.back() |= static_cast<uint64_t>(item) << (bits % 64);
+    ++bits;
+}
+
+void Container<bool>::set(size_t index, bool value) {
+    assert(index < bits);
+    uint64_t mask = uint64_t(1) << (index % 64);
+    if (value) {
+        words[index / 64] |= mask;
+    } else {
+        words[index / 64] &= ~mask;
+    }
+}
+
+bool Container<bool>::get(size_t index) const {
+    assert(index < bits);
+    return (words[index / 64] >> (index % 64)) & 1;
+}
+
+size_t Container<bool>::size() const {
+    return bits;
+}
+
+size_t Container<bool>::count() const {
+    size_t total = 0;
+    for (uint64_t word : words) {
+        total += popcount64(word);
+    }
+    return total;
+}
+
+size_t Container<bool>::find_first() const {
+    for (size_t w = 0; w < words.size(); ++w) {
+        if (words[w] != 0) {
+            return w * 64 + ctz64(words[w]);
+        }
+    }
+    return npos;
+}
+
+size_t Container<bool>::find_next(size_t index) const {
+    size_t start = index + 1;
+    if (start >= bits) {
+        return npos;
+    }
+    size_t w = start / 64;
+    uint64_t word = words[w] & (~uint64_t(0) << (start % 64));  // Drop bits up to index
+    while (word == 0) {
+        if (++w == words.size()) {
+            return npos;
+        }
+        word = words[w];
+    }
+    return w * 64 + ctz64(word);
+}
+
+void Container<bool>::print() const {
+    std::cout << "[";
+    for (size_t i = 0; i < bits; ++i) {
+        std::cout << (i ? ", " : "") << (get(i) ? "true" : "false");
+    }
+    std::cout << "]\n";
+}
+
+// printAll implementation
+template<typename T>
+void printAll(const T& value) {
+    printJoined(" ", value);
+}
+
+template<typename T, typename... Args>
+void printAll(const T& first, const Args&... args) {
+    printJoined(" ", first, args...);
+}
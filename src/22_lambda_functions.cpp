@@ -15,6 +15,13 @@
 #include <vector>
 #include <functional>
 #include <string>
+#include <array>
+#include <iomanip>
+#include <memory>
+
+#include "allocation_counter.h"
+#include "inplace_function.h"
+#include "parallel_algorithms.h"
 
 // TODO: Implement these helper functions and classes
 
@@ -22,8 +29,14 @@
 template<typename Func>
 void processNumbers(const std::vector<int>& numbers, Func processor);
 
+// Parallel counterpart: processor(element) runs on the work-stealing pool
+// (parallel_algorithms.h), so it must be safe to call concurrently
+template<typename Func>
+void processNumbersParallel(WorkStealingThreadPool& pool, std::vector<int>& numbers, Func processor);
+
 // Function that returns a lambda
-std::function<int(int)> createMultiplier(int factor);
+// The one-int capture is stored inline; inplace_function can never allocate
+inplace_function<int(int), 16> createMultiplier(int factor);
 
 // Class to demonstrate lambda with member variables
 class Calculator {
@@ -47,6 +60,7 @@ void demonstrateGenericLambda();
 void demonstrateLambdaWithSTL();
 void demonstrateLambdaAsParameter();
 void demonstrateClosureTypes();
+void benchmarkCallableWrappers();
 
 int main() {
     std::cout << "=== Lambda Functions Examples ===\n\n";
@@ -60,6 +74,7 @@ int main() {
     demonstrateLambdaWithSTL();
     demonstrateLambdaAsParameter();
     demonstrateClosureTypes();
+    benchmarkCallableWrappers();
     
     return 0;
 }
@@ -206,6 +221,16 @@ void demonstrateLambdaAsParameter() {
     // Double each number
     auto doubleLambda = [](int x) { std::cout << x * 2 << " "; };
     
+    // A lambda that transforms in place works unchanged with the parallel version
+    WorkStealingThreadPool pool(2);
+    std::vector<int> squares = data;
+    processNumbersParallel(pool, squares, [](int& x) { x *= x; });
+    std::cout << "Squared in parallel:";
+    for (int x : squares) {
+        std::cout << " " << x;
+    }
+    std::cout << "\n";
+    
     std::cout << "---\n\n";
 }
 
@@ -229,6 +254,93 @@ void demonstrateClosureTypes() {
     
     // TODO: Store multiple lambdas and execute them
     
+    // inplace_function: same interface, the closure lives in the object
+    auto triple = createMultiplier(3);
+    std::cout << "createMultiplier(3)(14) = " << triple(14) << ", sizeof = " << sizeof(triple) << "\n";
+    
+    // unique_function accepts move-only closures that std::function rejects
+    unique_function<int()> owner = [resource = std::make_unique<int>(7)]() { return *resource; };
+    std::cout << "unique_function owning a unique_ptr: " << owner() << " (inline: " << std::boolalpha
+              << owner.isInline() << ")\n";
+    std::array<int, 32> big{};
+    unique_function<int()> large = [big]() { return big[0]; };
+    std::cout << "128-byte capture in unique_function<int(), 32>, inline: " << large.isInline() << "\n";
+    
+    std::cout << "---\n\n";
+}
+
+static int addOne(int x) {
+    return x + 1;
+}
+
+struct CallableRun {
+    double createNs;
+    double allocsPerCreate;
+    double callNs;
+};
+
+static volatile long long callableSink = 0;
+
+// Builds a wrapper from make(i) n times, then calls one wrapper n times
+template<typename Make>
+static CallableRun timeCallable(int n, Make make) {
+    long long sum = 0;
+    AllocationRun create = measureAllocations(n, [&] {
+        for (int i = 0; i < n; ++i) {
+            auto wrapper = make(i);
+            sum += wrapper(i);
+        }
+    });
+    auto wrapper = make(1);
+    AllocationRun call = measureAllocations(n, [&] {
+        for (int i = 0; i < n; ++i) {
+            sum += wrapper(i);
+        }
+    });
+    callableSink = sum;
+    return {create.nsPerOp, create.allocationsPerOp, call.nsPerOp};
+}
+
+void benchmarkCallableWrappers() {
+    std::cout << "9. Callable Wrapper Benchmark:\n";
+    const int n = 2000000;
+    // 8-byte capture fits std::function's 16-byte local buffer; 40 bytes does not
+    struct Wide {
+        long long a, b, c, d, e;
+    };
+    
+    struct Row {
+        const char* name;
+        CallableRun run;
+    };
+    Row rows[] = {
+        {"function pointer", timeCallable(n, [](int) { return &addOne; })},
+        {"std::function, 8-byte capture", timeCallable(n, [](int i) {
+             long long k = i;
+             return std::function<int(int)>([k](int x) { return static_cast<int>(x + k); });
+         })},
+        {"std::function, 40-byte capture", timeCallable(n, [](int i) {
+             Wide w{i, 1, 2, 3, 4};
+             return std::function<int(int)>([w](int x) { return static_cast<int>(x + w.a + w.e); });
+         })},
+        {"inplace_function<.., 48>, 40-byte", timeCallable(n, [](int i) {
+             Wide w{i, 1, 2, 3, 4};
+             return inplace_function<int(int), 48>([w](int x) { return static_cast<int>(x + w.a + w.e); });
+         })},
+        {"unique_function<.., 48>, 40-byte", timeCallable(n, [](int i) {
+             Wide w{i, 1, 2, 3, 4};
+             return unique_function<int(int), 48>([w](int x) { return static_cast<int>(x + w.a + w.e); });
+         })},
+    };
+    std::cout << n << " wrappers created and " << n << " calls per row\n";
+    std::cout << std::left << std::setw(36) << "Wrapper" << std::right << std::setw(12) << "create ns"
+              << std::setw(14) << "allocs/create" << std::setw(10) << "call ns" << "\n";
+    for (const Row& row : rows) {
+        std::cout << std::left << std::setw(36) << row.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << row.run.createNs << std::setprecision(2) << std::setw(14)
+                  << row.run.allocsPerCreate << std::setprecision(1) << std::setw(10) << row.run.callNs << "\n";
+    }
+    std::cout.unsetf(std::ios::fixed);
     std::cout << "---\n\n";
 }
 
@@ -242,7 +354,12 @@ void processNumbers(const std::vector<int>& numbers, Func processor) {
     std::cout << "\n";
 }
 
-std::function<int(int)> createMultiplier(int factor) {
+template<typename Func>
+void processNumbersParallel(WorkStealingThreadPool& pool, std::vector<int>& numbers, Func processor) {
+    parallel_for(pool, 0, numbers.size(), [&](size_t i) { processor(numbers[i]); });
+}
+
+inplace_function<int(int), 16> createMultiplier(int factor) {
     return [factor](int value) {
         return value * factor;
     };
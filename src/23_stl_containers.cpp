@@ -22,9 +22,71 @@
 #include <queue>
 #include <algorithm>
 #include <iterator>
+#include <chrono>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+// std::execution::par needs libstdc++'s TBB backend; CMake defines this when TBB is found
+#if defined(HAVE_PARALLEL_STL)
+#include <execution>
+#endif
+
+#include "container_benchmarks.h"
+#include "memory_arena.h"
+#include "parallel_algorithms.h"
 
 // TODO: Implement these helper functions and classes
 
+// Hash mixing: 64x64 -> 128-bit multiply folded back to 64 bits (the wyhash
+// "mum" step). Both inputs spread into every output bit, unlike XOR, which
+// is symmetric (h(a) ^ h(b) == h(b) ^ h(a)) and cancels equal inputs.
+static uint64_t mumMix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+    uint64_t aLo = a & 0xffffffffu, aHi = a >> 32;
+    uint64_t bLo = b & 0xffffffffu, bHi = b >> 32;
+    uint64_t lolo = aLo * bLo, lohi = aLo * bHi, hilo = aHi * bLo, hihi = aHi * bHi;
+    uint64_t mid = (lolo >> 32) + (lohi & 0xffffffffu) + (hilo & 0xffffffffu);
+    uint64_t lo = (lolo & 0xffffffffu) | (mid << 32);
+    uint64_t hi = hihi + (lohi >> 32) + (hilo >> 32) + (mid >> 32);
+    return lo ^ hi;
+#endif
+}
+
+static uint64_t hashMix(uint64_t h) {
+    return mumMix(h ^ 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL);
+}
+
+// Order-dependent: hashCombine(hashCombine(s, a), b) != hashCombine(hashCombine(s, b), a)
+static uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    return mumMix(seed ^ 0xa0761d6478bd642fULL, value ^ 0xe7037ed1a0b428dbULL);
+}
+
+// Transparent string hash: std::string, std::string_view and const char*
+// hash identically, so lookups by string_view need no temporary std::string
+struct StringHash {
+    using is_transparent = void;
+    
+    std::size_t operator()(std::string_view s) const {
+        return hashMix(std::hash<std::string_view>()(s));
+    }
+};
+
 // Custom comparator for demonstrating set/map with custom ordering
 struct Person {
     std::string name;
@@ -44,10 +106,119 @@ struct Person {
 // Custom hash function for unordered containers
 struct PersonHash {
     std::size_t operator()(const Person& p) const {
-        return std::hash<std::string>()(p.name) ^ std::hash<int>()(p.age);
+        return hashCombine(std::hash<std::string>()(p.name), static_cast<uint64_t>(p.age));
     }
 };
 
+// Open-addressing hash map with SwissTable-style control bytes.
+// Slots are stored inline in one array; a parallel control array holds
+// Empty or the low 7 bits of the element's hash (H2). Lookups start at the
+// element's home slot (from the high hash bits, H1) and compare 16 control
+// bytes per step with SSE2, checking keys only on H2 matches. Probing is
+// linear by slot, so erase shifts the following run back (no tombstones).
+// The control array mirrors its first 16 bytes after the end, so a group
+// load never wraps. The hash is re-mixed internally, so weak hashers such
+// as std::hash<int> (the identity) still spread well.
+class FlatHashGroup {
+public:
+    static constexpr size_t Width = 16;
+    static constexpr int8_t Empty = -128;
+
+private:
+#if defined(__SSE2__)
+    __m128i bytes;
+#else
+    const int8_t* bytes;
+#endif
+
+public:
+    explicit FlatHashGroup(const int8_t* ctrl);
+    uint32_t match(int8_t h2) const;
+    uint32_t matchEmpty() const;
+};
+
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class FlatHashMap {
+public:
+    struct Slot {
+        K key;
+        V value;
+        
+        template<typename KArg, typename... Args>
+        Slot(KArg&& k, Args&&... args) : key(std::forward<KArg>(k)), value(std::forward<Args>(args)...) {}
+    };
+    
+private:
+    static constexpr size_t Width = FlatHashGroup::Width;
+    static constexpr int8_t Empty = FlatHashGroup::Empty;
+    static constexpr size_t MinCapacity = Width;
+    
+    int8_t* ctrl = nullptr;   // capacity_ + Width bytes
+    Slot* slots = nullptr;
+    size_t capacity_ = 0;     // 0 or a power of two >= MinCapacity
+    size_t size_ = 0;
+    Hash hasher;
+    KeyEqual equal;
+    
+    template<typename Q>
+    uint64_t hashOf(const Q& key) const { return hashMix(static_cast<uint64_t>(hasher(key))); }
+    static size_t homeOf(uint64_t hash, size_t mask) { return static_cast<size_t>(hash >> 7) & mask; }
+    static int8_t h2Of(uint64_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+    
+    template<typename Q>
+    size_t findIndex(const Q& key, uint64_t hash) const;  // capacity_ when absent
+    size_t findEmpty(uint64_t hash) const;
+    void setCtrl(size_t index, int8_t value);
+    void eraseAt(size_t index);
+    void rehash(size_t newCapacity);
+    static Slot* allocateSlots(size_t n);
+    static void deallocateSlots(Slot* p);
+    void destroyAll();
+    
+public:
+    FlatHashMap() = default;
+    explicit FlatHashMap(size_t expected);
+    ~FlatHashMap();
+    
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+    FlatHashMap(FlatHashMap&& other) noexcept;
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+    
+    // Returns the mapped value and whether it was inserted
+    template<typename... Args>
+    std::pair<V*, bool> try_emplace(K key, Args&&... args);
+    V& operator[](K key);
+    
+    V* find(const K& key);
+    const V* find(const K& key) const;
+    bool contains(const K& key) const;
+    bool erase(const K& key);
+    
+    // Heterogeneous overloads, enabled when both Hash and KeyEqual are
+    // transparent (e.g. StringHash with std::equal_to<>)
+    template<typename Q, typename H = Hash, typename E = KeyEqual,
+             typename = typename H::is_transparent, typename = typename E::is_transparent>
+    V* find(const Q& key);
+    template<typename Q, typename H = Hash, typename E = KeyEqual,
+             typename = typename H::is_transparent, typename = typename E::is_transparent>
+    bool contains(const Q& key) const;
+    template<typename Q, typename H = Hash, typename E = KeyEqual,
+             typename = typename H::is_transparent, typename = typename E::is_transparent>
+    bool erase(const Q& key);
+    
+    void reserve(size_t expected);
+    void clear();
+    
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    size_t memoryBytes() const;
+    
+    template<typename F>
+    void forEach(F fn) const;
+};
+
 // Function prototypes for demonstrations
 void demonstrateSequenceContainers();
 void demonstrateAssociativeContainers();
@@ -57,6 +228,10 @@ void demonstrateIterators();
 void demonstrateAlgorithms();
 void demonstratePerformanceComparison();
 void demonstrateContainerChoice();
+void demonstrateCustomMemoryResources();
+void demonstrateFlatHashMap();
+void benchmarkHashMaps();
+void benchmarkParallelAlgorithms();
 
 int main() {
     std::cout << "=== STL Containers Examples ===\n\n";
@@ -70,6 +245,10 @@ int main() {
     demonstrateAlgorithms();
     demonstratePerformanceComparison();
     demonstrateContainerChoice();
+    demonstrateCustomMemoryResources();
+    demonstrateFlatHashMap();
+    benchmarkHashMaps();
+    benchmarkParallelAlgorithms();
     
     return 0;
 }
@@ -222,21 +401,48 @@ void demonstrateAlgorithms() {
     // - std::for_each
     // - std::accumulate
     
+    // The same lambdas plug into the parallel versions (parallel_algorithms.h)
+    WorkStealingThreadPool pool(4);
+    std::vector<int> values(100000);
+    parallel_for(pool, 0, values.size(), [&values](size_t i) { values[i] = static_cast<int>((i * 7919) % 100000); });
+    parallel_sort(pool, values.begin(), values.end());
+    std::cout << "parallel_sort sorted: " << std::boolalpha << std::is_sorted(values.begin(), values.end()) << "\n";
+    long long sum = parallel_reduce(pool, values.begin(), values.end(), 0LL);
+    long long squares = parallel_transform_reduce(pool, values.begin(), values.end(), 0LL, std::plus<>(),
+                                                  [](int x) { return 1LL * x * x; });
+    std::cout << "parallel_reduce: " << sum << " (std::accumulate: "
+              << std::accumulate(values.begin(), values.end(), 0LL) << "), sum of squares: " << squares << "\n";
+    std::vector<long long> prefix(numbers.begin(), numbers.end());
+    parallel_inclusive_scan(pool, prefix.begin(), prefix.end(), prefix.begin());
+    std::cout << "parallel_inclusive_scan of {5, 2, 8, 1, 9, 3}:";
+    for (long long p : prefix) {
+        std::cout << " " << p;
+    }
+    std::cout << "\n";
+    
     std::cout << "---\n\n";
 }
 
 void demonstratePerformanceComparison() {
     std::cout << "7. Performance Characteristics:\n";
     
-    // TODO: Show time complexity comparisons
     // Vector: O(1) random access, O(n) insertion/deletion in middle
     // List: O(1) insertion/deletion anywhere, O(n) access
     // Set/Map: O(log n) operations
     // Unordered Set/Map: O(1) average case operations
-    
-    // TODO: Demonstrate when to use each container
-    // Memory usage patterns
-    // Cache friendliness
+    // Constants differ by orders of magnitude: contiguous storage is cache
+    // friendly, node-based containers pay a cache miss per hop.
+    // The benchmark_suite target runs the same cases with JSON/CSV output.
+    BenchmarkSuite suite("stl-containers");
+    addContainerBenchmarks(suite, 100000);
+    BenchmarkOptions options;
+    options.repetitions = 5;
+    suite.run(options);
+    std::cout << "100000 uint64 elements, median of " << options.repetitions << " runs, ns per element/op\n";
+    suite.writeTable(std::cout);
+#if !defined(__OPTIMIZE__)
+    std::cout << "(unoptimized build: relative costs are distorted; the benchmark_suite target is built with -O2)\n";
+#endif
     
     std::cout << "---\n\n";
 }
@@ -253,3 +459,595 @@ void demonstrateContainerChoice() {
     
     std::cout << "---\n\n";
 }
+
+void demonstrateCustomMemoryResources() {
+    std::cout << "9. Custom Memory Resources (std::pmr):\n";
+
+    // Node-based containers allocate once per element; size classes recycle nodes
+    SizeClassMemoryResource pool;
+    std::pmr::list<int> pooledList(&pool);
+    std::pmr::unordered_map<int, int> pooledMap(&pool);
+    for (int i = 0; i < 1000; ++i) {
+        pooledList.push_back(i);
+        pooledMap[i] = i * i;
+    }
+    std::cout << "pmr::list size " << pooledList.size() << ", pmr::unordered_map size "
+              << pooledMap.size() << ", arena reserved " << pool.getBytesReserved() << " bytes\n";
+
+    // Monotonic arena: build once, drop everything at once; the resource
+    // propagates to the pmr::string keys so they share the arena as well
+    MonotonicArenaResource arena(1024);
+    {
+        std::pmr::map<std::pmr::string, int> wordLengths(&arena);
+        for (const char* word : {"vector", "list", "deque", "set", "map", "unordered_map_with_a_long_key"}) {
+            wordLengths.emplace(word, static_cast<int>(std::char_traits<char>::length(word)));
+        }
+        std::cout << "pmr::map with " << wordLengths.size() << " entries used "
+                  << arena.getArena().getBytesUsed() << " bytes in "
+                  << arena.getArena().getBlockCount() << " arena blocks\n";
+    }
+    arena.release();
+
+    // List churn: default allocator vs size-class resource
+    constexpr int ROUNDS = 200;
+    constexpr int ELEMENTS = 5000;
+    auto timeChurn = [&](std::pmr::memory_resource* resource) {
+        auto start = std::chrono::steady_clock::now();
+        std::pmr::list<int> churnList(resource);
+        for (int round = 0; round < ROUNDS; ++round) {
+            for (int i = 0; i < ELEMENTS; ++i) {
+                churnList.push_back(i);
+            }
+            churnList.clear();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    std::cout << "list push/clear churn (" << ROUNDS << " x " << ELEMENTS << "): new_delete_resource "
+              << timeChurn(std::pmr::new_delete_resource()) << " ms, SizeClassMemoryResource "
+              << timeChurn(&pool) << " ms\n";
+
+    std::cout << "---\n\n";
+}
+
+void demonstrateFlatHashMap() {
+    std::cout << "10. FlatHashMap and Hash Combining:\n";
+    
+    // XOR combining is symmetric and cancels equal fields
+    auto xorCombine = [](const std::string& a, const std::string& b) {
+        return std::hash<std::string>()(a) ^ std::hash<std::string>()(b);
+    };
+    auto mixCombine = [](const std::string& a, const std::string& b) {
+        return hashCombine(std::hash<std::string>()(a), std::hash<std::string>()(b));
+    };
+    std::cout << std::boolalpha
+              << "XOR:     h(Ann, Bob) == h(Bob, Ann): " << (xorCombine("Ann", "Bob") == xorCombine("Bob", "Ann"))
+              << ", h(Ann, Ann) == h(Bob, Bob): " << (xorCombine("Ann", "Ann") == xorCombine("Bob", "Bob")) << "\n"
+              << "combine: h(Ann, Bob) == h(Bob, Ann): " << (mixCombine("Ann", "Bob") == mixCombine("Bob", "Ann"))
+              << ", h(Ann, Ann) == h(Bob, Bob): " << (mixCombine("Ann", "Ann") == mixCombine("Bob", "Bob")) << "\n";
+    
+    FlatHashMap<Person, std::string, PersonHash> roles;
+    roles[Person("John", 25)] = "engineer";
+    roles[Person("Jane", 30)] = "manager";
+    roles.try_emplace(Person("John", 25), "ignored: key exists");
+    std::cout << "FlatHashMap<Person, string>: " << roles.size() << " entries, John/25 -> "
+              << *roles.find(Person("John", 25)) << "\n";
+    
+    // Heterogeneous lookup: string_view and literals without building a std::string
+    FlatHashMap<std::string, int, StringHash, std::equal_to<>> counts;
+    for (std::string_view word : {"apple", "banana", "apple", "cherry", "banana", "apple"}) {
+        auto [value, inserted] = counts.try_emplace(std::string(word), 0);
+        (void)inserted;
+        ++*value;
+    }
+    std::string_view query = "apple pie";
+    std::cout << "count(\"" << query.substr(0, 5) << "\") via string_view = " << *counts.find(query.substr(0, 5))
+              << ", contains(\"durian\") = " << counts.contains("durian") << "\n";
+    counts.erase(std::string_view("banana"));
+    std::cout << "after erase(\"banana\"): ";
+    counts.forEach([](const std::string& key, int value) { std::cout << key << "=" << value << " "; });
+    std::cout << std::noboolalpha << "(capacity " << counts.capacity() << ", " << counts.memoryBytes() << " bytes)\n";
+    
+    std::cout << "---\n\n";
+}
+
+struct HashBenchResult {
+    double insertNs;
+    double findHitNs;
+    double findMissNs;
+    double eraseNs;
+    double bytesPerEntry;
+};
+
+static volatile uint64_t hashBenchSink = 0;
+
+template<typename Fn>
+static double nsPerOp(size_t ops, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+}
+
+// Map adapts all three containers to insert / find / erase / bytes
+template<typename Map>
+static HashBenchResult runHashBench(const std::vector<uint64_t>& keys, const std::vector<uint64_t>& misses,
+                                    const std::vector<uint64_t>& lookupOrder) {
+    HashBenchResult result{};
+    size_t bytesBefore = trackedAllocatorBytes();
+    Map map;
+    result.insertNs = nsPerOp(keys.size(), [&]() {
+        for (uint64_t key : keys) {
+            map.insert(key, key);
+        }
+    });
+    result.bytesPerEntry = static_cast<double>(map.bytes(trackedAllocatorBytes() - bytesBefore)) / keys.size();
+    result.findHitNs = nsPerOp(lookupOrder.size(), [&]() {
+        uint64_t sum = 0;
+        for (uint64_t key : lookupOrder) {
+            sum += map.find(key);
+        }
+        hashBenchSink = sum;
+    });
+    result.findMissNs = nsPerOp(misses.size(), [&]() {
+        uint64_t sum = 0;
+        for (uint64_t key : misses) {
+            sum += map.find(key);
+        }
+        hashBenchSink = sum;
+    });
+    result.eraseNs = nsPerOp(lookupOrder.size(), [&]() {
+        for (uint64_t key : lookupOrder) {
+            map.erase(key);
+        }
+    });
+    return result;
+}
+
+struct FlatBench {
+    FlatHashMap<uint64_t, uint64_t> map;
+    void insert(uint64_t k, uint64_t v) { map.try_emplace(k, v); }
+    uint64_t find(uint64_t k) { const uint64_t* v = map.find(k); return v ? *v : 0; }
+    void erase(uint64_t k) { map.erase(k); }
+    size_t bytes(size_t) const { return map.memoryBytes(); }
+};
+
+struct UnorderedBench {
+    std::unordered_map<uint64_t, uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                       TrackingAllocator<std::pair<const uint64_t, uint64_t>>> map;
+    void insert(uint64_t k, uint64_t v) { map.emplace(k, v); }
+    uint64_t find(uint64_t k) { auto it = map.find(k); return it != map.end() ? it->second : 0; }
+    void erase(uint64_t k) { map.erase(k); }
+    size_t bytes(size_t tracked) const { return tracked + sizeof(map); }
+};
+
+struct OrderedBench {
+    std::map<uint64_t, uint64_t, std::less<uint64_t>, TrackingAllocator<std::pair<const uint64_t, uint64_t>>> map;
+    void insert(uint64_t k, uint64_t v) { map.emplace(k, v); }
+    uint64_t find(uint64_t k) { auto it = map.find(k); return it != map.end() ? it->second : 0; }
+    void erase(uint64_t k) { map.erase(k); }
+    size_t bytes(size_t tracked) const { return tracked + sizeof(map); }
+};
+
+void benchmarkHashMaps() {
+    std::cout << "11. Hash Map Benchmark (FlatHashMap vs unordered_map vs map):\n";
+    std::cout << "Random uint64 keys; ns per operation; bytes per entry excludes malloc headers\n";
+    std::cout << std::setw(10) << "Entries" << "  " << std::left << std::setw(15) << "Container" << std::right
+              << std::setw(10) << "insert" << std::setw(10) << "find hit" << std::setw(11) << "find miss"
+              << std::setw(10) << "erase" << std::setw(12) << "bytes/entry" << "\n";
+    
+    std::mt19937_64 rng(2024);
+    for (size_t n : {size_t(1000), size_t(10000), size_t(100000), size_t(1000000), size_t(10000000)}) {
+        std::vector<uint64_t> keys(n);
+        std::vector<uint64_t> misses(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = rng();
+            misses[i] = rng();
+        }
+        std::vector<uint64_t> lookupOrder = keys;
+        std::shuffle(lookupOrder.begin(), lookupOrder.end(), rng);
+        
+        auto report = [n](const char* name, const HashBenchResult& r) {
+            std::cout << std::setw(10) << n << "  " << std::left << std::setw(15) << name << std::right
+                      << std::fixed << std::setprecision(1) << std::setw(10) << r.insertNs
+                      << std::setw(10) << r.findHitNs << std::setw(11) << r.findMissNs << std::setw(10) << r.eraseNs
+                      << std::setw(12) << r.bytesPerEntry << "\n" << std::defaultfloat;
+        };
+        report("FlatHashMap", runHashBench<FlatBench>(keys, misses, lookupOrder));
+        report("unordered_map", runHashBench<UnorderedBench>(keys, misses, lookupOrder));
+        // A 10M-node red-black tree would take minutes at several us per op
+        if (n <= 1000000) {
+            report("map", runHashBench<OrderedBench>(keys, misses, lookupOrder));
+        }
+    }
+    std::cout << "(std::map skipped at 10M entries: already over 1 us/op at 1M)\n";
+    
+    std::cout << "---\n\n";
+}
+
+// Best of three runs, in milliseconds; setup() restores the input first
+template<typename Setup, typename Fn>
+static double bestMs(Setup setup, Fn fn) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+void benchmarkParallelAlgorithms() {
+    std::cout << "12. Parallel Algorithms Scaling:\n";
+    // 10^7 keeps the unoptimized build under a minute; the algorithms scale to 10^8
+    const size_t n = 10000000;
+    std::vector<int> input(n);
+    std::mt19937 rng(7);
+    for (int& x : input) {
+        x = static_cast<int>(rng() % 1000000);
+    }
+    std::vector<int> work;
+    std::vector<long long> scanOut(n);
+    auto restore = [&]() { work = input; };
+    auto nothing = []() {};
+    
+    const double sortSeq = bestMs(restore, [&]() { std::sort(work.begin(), work.end()); });
+    const double reduceSeq = bestMs(nothing, [&]() { hashBenchSink = std::accumulate(input.begin(), input.end(), 0LL); });
+    // Both scans accumulate in long long; the parallel one is checked against this result
+    const double scanSeq = bestMs(nothing, [&]() {
+        long long running = 0;
+        for (size_t i = 0; i < n; ++i) {
+            running += input[i];
+            scanOut[i] = running;
+        }
+    });
+    const long long scanTotal = scanOut.back();
+    std::cout << n << " ints, best of 3, ms (speedup over the sequential std algorithm)\n";
+    std::cout << "sequential: std::sort " << std::fixed << std::setprecision(1) << sortSeq << ", std::accumulate "
+              << reduceSeq << ", scan loop " << scanSeq << "\n";
+    
+    // Same thread counts as the thread pool benchmark in 26: powers of two up to the core count
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> threadCounts;
+    for (size_t t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+    
+    std::cout << std::setw(8) << "threads" << std::setw(18) << "parallel_sort" << std::setw(18) << "reduce"
+              << std::setw(20) << "reduce (determ.)" << std::setw(18) << "inclusive_scan" << "\n";
+    auto cell = [](double ms, double baseline) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1) << ms << " (" << baseline / ms << "x)";
+        return text.str();
+    };
+    for (size_t threads : threadCounts) {
+        WorkStealingThreadPool pool(threads);
+        double sortMs = bestMs(restore, [&]() { parallel_sort(pool, work.begin(), work.end()); });
+        double reduceMs = bestMs(nothing, [&]() { hashBenchSink = parallel_reduce(pool, input.begin(), input.end(), 0LL); });
+        double deterministicMs = bestMs(nothing, [&]() {
+            hashBenchSink = parallel_reduce(pool, input.begin(), input.end(), 0LL, std::plus<>(),
+                                            ParallelOptions{Schedule::Static, 0, true});
+        });
+        double scanMs = bestMs(nothing, [&]() {
+            parallel_inclusive_scan(pool, input.begin(), input.end(), scanOut.begin(), std::plus<long long>());
+        });
+        std::cout << std::setw(8) << threads << std::setw(18) << cell(sortMs, sortSeq) << std::setw(18)
+                  << cell(reduceMs, reduceSeq) << std::setw(20) << cell(deterministicMs, reduceSeq) << std::setw(18)
+                  << cell(scanMs, scanSeq) << (scanOut.back() == scanTotal ? "" : "  (scan mismatch)") << "\n";
+    }
+    
+#if defined(HAVE_PARALLEL_STL)
+    double parSort = bestMs(restore, [&]() { std::sort(std::execution::par, work.begin(), work.end()); });
+    double parReduce = bestMs(nothing, [&]() {
+        hashBenchSink = std::reduce(std::execution::par, input.begin(), input.end(), 0LL);
+    });
+    std::cout << "std::execution::par (TBB, all cores): sort " << cell(parSort, sortSeq) << ", reduce "
+              << cell(parReduce, reduceSeq) << "\n";
+#else
+    std::cout << "std::execution::par: not available (built without TBB)\n";
+#endif
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << "---\n\n";
+}
+
+// FlatHashGroup implementation
+#if defined(__SSE2__)
+FlatHashGroup::FlatHashGroup(const int8_t* ctrl)
+    : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+uint32_t FlatHashGroup::match(int8_t h2) const {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h2))));
+}
+
+// Empty is the only control value with the sign bit set
+uint32_t FlatHashGroup::matchEmpty() const {
+    return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+}
+#else
+FlatHashGroup::FlatHashGroup(const int8_t* ctrl) : bytes(ctrl) {}
+
+uint32_t FlatHashGroup::match(int8_t h2) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < Width; ++i) {
+        mask |= static_cast<uint32_t>(bytes[i] == h2) << i;
+    }
+    return mask;
+}
+
+uint32_t FlatHashGroup::matchEmpty() const {
+    return match(Empty);
+}
+#endif
+
+// FlatHashMap implementation
+template<typename K, typename V, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Hash, KeyEqual>::FlatHashMap(size_t expected) {
+    reserve(expected);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Hash, KeyEqual>::~FlatHashMap() {
+    destroyAll();
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Hash, KeyEqual>::FlatHashMap(FlatHashMap&& other) noexcept
+    : ctrl(other.ctrl), slots(other.slots), capacity_(other.capacity_), size_(other.size_),
+      hasher(std::move(other.hasher)), equal(std::move(other.equal)) {
+    other.ctrl = nullptr;
+    other.slots = nullptr;
+    other.capacity_ = other.size_ = 0;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Hash, KeyEqual>& FlatHashMap<K, V, Hash, KeyEqual>::operator=(FlatHashMap&& other) noexcept {
+    if (this != &other) {
+        destroyAll();
+        ctrl = other.ctrl;
+        slots = other.slots;
+        capacity_ = other.capacity_;
+        size_ = other.size_;
+        hasher = std::move(other.hasher);
+        equal = std::move(other.equal);
+        other.ctrl = nullptr;
+        other.slots = nullptr;
+        other.capacity_ = other.size_ = 0;
+    }
+    return *this;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+template<typename... Args>
+std::pair<V*, bool> FlatHashMap<K, V, Hash, KeyEqual>::try_emplace(K key, Args&&... args) {
+    const uint64_t hash = hashOf(key);
+    size_t index = findIndex(key, hash);
+    if (index != capacity_) {
+        return {&slots[index].value, false};
+    }
+    // Grow at 7/8 load so every probe sequence reaches an empty slot
+    if ((size_ + 1) * 8 > capacity_ * 7) {
+        rehash(capacity_ == 0 ? MinCapacity : capacity_ * 2);
+    }
+    index = findEmpty(hash);
+    new (&slots[index]) Slot(std::move(key), std::forward<Args>(args)...);
+    setCtrl(index, h2Of(hash));
+    ++size_;
+    return {&slots[index].value, true};
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+V& FlatHashMap<K, V, Hash, KeyEqual>::operator[](K key) {
+    return *try_emplace(std::move(key)).first;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+V* FlatHashMap<K, V, Hash, KeyEqual>::find(const K& key) {
+    size_t index = findIndex(key, hashOf(key));
+    return index == capacity_ ? nullptr : &slots[index].value;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+const V* FlatHashMap<K, V, Hash, KeyEqual>::find(const K& key) const {
+    size_t index = findIndex(key, hashOf(key));
+    return index == capacity_ ? nullptr : &slots[index].value;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool FlatHashMap<K, V, Hash, KeyEqual>::contains(const K& key) const {
+    return findIndex(key, hashOf(key)) != capacity_;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool FlatHashMap<K, V, Hash, KeyEqual>::erase(const K& key) {
+    size_t index = findIndex(key, hashOf(key));
+    if (index == capacity_) {
+        return false;
+    }
+    eraseAt(index);
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+template<typename Q, typename, typename, typename, typename>
+V* FlatHashMap<K, V, Hash, KeyEqual>::find(const Q& key) {
+    size_t index = findIndex(key, hashOf(key));
+    return index == capacity_ ? nullptr : &slots[index].value;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+template<typename Q, typename, typename, typename, typename>
+bool FlatHashMap<K, V, Hash, KeyEqual>::contains(const Q& key) const {
+    return findIndex(key, hashOf(key)) != capacity_;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+template<typename Q, typename, typename, typename, typename>
+bool FlatHashMap<K, V, Hash, KeyEqual>::erase(const Q& key) {
+    size_t index = findIndex(key, hashOf(key));
+    if (index == capacity_) {
+        return false;
+    }
+    eraseAt(index);
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::reserve(size_t expected) {
+    size_t needed = MinCapacity;
+    while (needed * 7 < expected * 8) {
+        needed *= 2;
+    }
+    if (needed > capacity_) {
+        rehash(needed);
+    }
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::clear() {
+    for (size_t i = 0; i < capacity_; ++i) {
+        if (ctrl[i] != Empty) {
+            slots[i].~Slot();
+            ctrl[i] = Empty;
+        }
+    }
+    for (size_t i = 0; i < Width && capacity_ > 0; ++i) {
+        ctrl[capacity_ + i] = Empty;
+    }
+    size_ = 0;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+size_t FlatHashMap<K, V, Hash, KeyEqual>::memoryBytes() const {
+    size_t table = capacity_ == 0 ? 0 : capacity_ * sizeof(Slot) + capacity_ + Width;
+    return sizeof(*this) + table;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+template<typename F>
+void FlatHashMap<K, V, Hash, KeyEqual>::forEach(F fn) const {
+    for (size_t i = 0; i < capacity_; ++i) {
+        if (ctrl[i] != Empty) {
+            fn(static_cast<const K&>(slots[i].key), slots[i].value);
+        }
+    }
+}
+
+// Scans 16 control bytes per step from the home slot; keys are compared only
+// where H2 matches. An empty byte in the group ends the search, because
+// linear probing never leaves a gap between an element and its home.
+template<typename K, typename V, typename Hash, typename KeyEqual>
+template<typename Q>
+size_t FlatHashMap<K, V, Hash, KeyEqual>::findIndex(const Q& key, uint64_t hash) const {
+    if (capacity_ == 0) {
+        return capacity_;
+    }
+    const size_t mask = capacity_ - 1;
+    const int8_t h2 = h2Of(hash);
+    size_t pos = homeOf(hash, mask);
+    for (;;) {
+        FlatHashGroup group(ctrl + pos);
+        for (uint32_t matches = group.match(h2); matches != 0; matches &= matches - 1) {
+            size_t index = (pos + static_cast<size_t>(__builtin_ctz(matches))) & mask;
+            if (equal(slots[index].key, key)) {
+                return index;
+            }
+        }
+        if (group.matchEmpty() != 0) {
+            return capacity_;
+        }
+        pos = (pos + Width) & mask;
+    }
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+size_t FlatHashMap<K, V, Hash, KeyEqual>::findEmpty(uint64_t hash) const {
+    const size_t mask = capacity_ - 1;
+    size_t pos = homeOf(hash, mask);
+    for (;;) {
+        uint32_t empties = FlatHashGroup(ctrl + pos).matchEmpty();
+        if (empties != 0) {
+            return (pos + static_cast<size_t>(__builtin_ctz(empties))) & mask;
+        }
+        pos = (pos + Width) & mask;
+    }
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::setCtrl(size_t index, int8_t value) {
+    ctrl[index] = value;
+    if (index < Width) {
+        ctrl[capacity_ + index] = value;
+    }
+}
+
+// Backward-shift deletion: walk the run after the hole and pull back every
+// element whose home slot is not between the hole and its current slot
+template<typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::eraseAt(size_t index) {
+    const size_t mask = capacity_ - 1;
+    size_t hole = index;
+    slots[hole].~Slot();
+    for (size_t next = (hole + 1) & mask; ctrl[next] != Empty; next = (next + 1) & mask) {
+        size_t home = homeOf(hashOf(slots[next].key), mask);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            new (&slots[hole]) Slot(std::move(slots[next]));
+            slots[next].~Slot();
+            setCtrl(hole, ctrl[next]);
+            hole = next;
+        }
+    }
+    setCtrl(hole, Empty);
+    --size_;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::rehash(size_t newCapacity) {
+    int8_t* oldCtrl = ctrl;
+    Slot* oldSlots = slots;
+    const size_t oldCapacity = capacity_;
+    
+    slots = allocateSlots(newCapacity);
+    ctrl = new int8_t[newCapacity + Width];
+    std::fill(ctrl, ctrl + newCapacity + Width, Empty);
+    capacity_ = newCapacity;
+    
+    for (size_t i = 0; i < oldCapacity; ++i) {
+        if (oldCtrl[i] != Empty) {
+            const uint64_t hash = hashOf(oldSlots[i].key);
+            size_t index = findEmpty(hash);
+            new (&slots[index]) Slot(std::move(oldSlots[i]));
+            oldSlots[i].~Slot();
+            setCtrl(index, h2Of(hash));
+        }
+    }
+    delete[] oldCtrl;
+    deallocateSlots(oldSlots);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Hash, KeyEqual>::Slot* FlatHashMap<K, V, Hash, KeyEqual>::allocateSlots(size_t n) {
+    if constexpr (alignof(Slot) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return static_cast<Slot*>(::operator new(n * sizeof(Slot), std::align_val_t(alignof(Slot))));
+    } else {
+        return static_cast<Slot*>(::operator new(n * sizeof(Slot)));
+    }
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::deallocateSlots(Slot* p) {
+    if constexpr (alignof(Slot) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(p, std::align_val_t(alignof(Slot)));
+    } else {
+        ::operator delete(p);
+    }
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::destroyAll() {
+    clear();
+    delete[] ctrl;
+    deallocateSlots(slots);
+    ctrl = nullptr;
+    slots = nullptr;
+    capacity_ = 0;
+}
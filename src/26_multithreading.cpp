@@ -20,6 +20,18 @@
 #include <queue>
 #include <future>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <cstdint>
+#include <iomanip>
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+
+#include "instrumentation.h"
+#include "simple_thread_pool.h"
+#include "work_stealing_pool.h"
 
 // TODO: Implement these classes and functions
 
@@ -50,20 +62,101 @@ public:
     void add(int value);
 };
 
+// Lock-free bounded MPMC ring buffer (Dmitry Vyukov's sequence-numbered design)
+// Each cell carries a sequence number telling producers and consumers whose
+// turn it is, so a slot is claimed with one CAS on a head/tail counter.
+enum class WaitStrategy {
+    Spin,          // Busy-wait (lowest latency, burns a core)
+    SpinThenPark   // Spin briefly, then sleep on a condition variable
+};
+
+template<typename T>
+class MPMCRingBuffer {
+private:
+    static constexpr size_t CacheLine = 64;
+    static constexpr int SpinLimit = 256;
+    
+    struct alignas(CacheLine) Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+    
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    const WaitStrategy strategy;
+    
+    // Producers and consumers each own a cache line
+    alignas(CacheLine) std::atomic<size_t> enqueuePos{0};
+    alignas(CacheLine) std::atomic<size_t> dequeuePos{0};
+    
+    alignas(CacheLine) std::atomic<bool> closed{false};
+    std::atomic<size_t> waitingProducers{0};
+    std::atomic<size_t> waitingConsumers{0};
+    std::mutex parkMutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    
+    bool pushOne(const T& item);
+    bool popOne(T& item);
+    
+    template<typename Attempt>
+    bool waitUntil(Attempt attempt, std::atomic<size_t>& waiters, std::condition_variable& cv);
+    void wake(std::atomic<size_t>& waiters, std::condition_variable& cv, bool all = false);
+    
+public:
+    // Capacity is rounded up to a power of two so positions wrap with a mask
+    explicit MPMCRingBuffer(size_t minCapacity, WaitStrategy wait = WaitStrategy::SpinThenPark);
+    
+    MPMCRingBuffer(const MPMCRingBuffer&) = delete;
+    MPMCRingBuffer& operator=(const MPMCRingBuffer&) = delete;
+    
+    // Non-blocking: false when full / empty
+    bool try_produce(const T& item);
+    bool try_consume(T& item);
+    
+    // Non-blocking batches: claim up to count slots with a single CAS,
+    // return how many items were actually transferred
+    size_t produce_n(const T* items, size_t count);
+    size_t consume_n(T* out, size_t maxCount);
+    
+    // Blocking, using the configured wait strategy.
+    // produce() returns false if the buffer was closed while it was full and
+    // the item was not added; consume() returns false once the buffer is
+    // closed and drained.
+    bool produce(const T& item);
+    bool consume(T& item);
+    
+    void close();
+    bool isClosed() const;
+    size_t size() const;  // Approximate while other threads are active
+    size_t getCapacity() const { return capacity; }
+};
+
 // 3. Producer-Consumer pattern with condition variables
 class ProducerConsumer {
+public:
+    enum class Backend {
+        Mutex,    // std::queue guarded by bufferMutex + notEmpty/notFull
+        LockFree  // MPMCRingBuffer (capacity rounded up to a power of two)
+    };
+    
 private:
     std::queue<int> buffer;
-    std::mutex bufferMutex;
+    mutable std::mutex bufferMutex;
     std::condition_variable notEmpty;
     std::condition_variable notFull;
     const size_t maxSize;
     bool finished;
+    const Backend backend;
+    std::unique_ptr<MPMCRingBuffer<int>> ring;
     
 public:
-    ProducerConsumer(size_t size = 10);
+    ProducerConsumer(size_t size = 10, Backend backend = Backend::Mutex,
+                     WaitStrategy wait = WaitStrategy::SpinThenPark);
     
-    void produce(int item);
+    // False only for the lock-free backend, closed while full (the item is dropped)
+    bool produce(int item);
     bool consume(int& item);
     void setFinished();
     size_t size() const;
@@ -102,23 +195,44 @@ public:
     void taskBSafe();  // Deadlock prevention
 };
 
-// 6. Thread pool (simplified)
-class SimpleThreadPool {
+// 6. Thread pool (simplified) lives in simple_thread_pool.h, shared with
+// async_io.h (coroutine continuations)
+
+// 7. Chase-Lev work-stealing deque and 8. Work-stealing thread pool
+// live in work_stealing_pool.h, shared with parallel_algorithms.h
+
+// 9. Sharded counter
+// One cache-line-padded slot per thread, so increments never bounce a shared
+// line between cores; reads pay instead by summing every shard.
+class ShardedCounter {
+public:
+    enum class ReadMode {
+        Relaxed,                // Cheap snapshot; may miss increments racing with the read
+        SequentiallyConsistent  // Also ordered against other seq_cst operations (e.g. a "done" flag)
+    };
+    
 private:
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-    std::mutex queueMutex;
-    std::condition_variable condition;
-    bool stop;
+    struct alignas(64) Shard {
+        std::atomic<long long> value{0};
+    };
     
-public:
-    SimpleThreadPool(size_t numThreads);
-    ~SimpleThreadPool();
+    const size_t shardCount;
+    std::unique_ptr<Shard[]> shards;
+    
+    static std::atomic<size_t> nextThreadSlot;
+    static size_t threadSlot();
+    Shard& localShard();
     
-    template<typename F>
-    void enqueue(F&& task);
+public:
+    // 0 picks a shard count from hardware_concurrency()
+    explicit ShardedCounter(size_t numShards = 0);
     
-    void shutdown();
+    void increment();
+    void decrement();
+    void add(long long value);
+    long long getValue(ReadMode mode = ReadMode::Relaxed) const;
+    void reset();
+    size_t getShardCount() const { return shardCount; }
 };
 
 // Function prototypes for demonstrations
@@ -130,6 +244,11 @@ void demonstrateRaceConditions();
 void demonstrateDeadlockPrevention();
 void demonstrateFuturesAndPromises();
 void demonstrateThreadPool();
+void demonstrateWorkStealingPool();
+void benchmarkThreadPools();
+void benchmarkProducerConsumer();
+void benchmarkCounters();
+void benchmarkInstrumentation();
 
 int main() {
     std::cout << "=== Multithreading Examples ===\n\n";
@@ -143,6 +262,11 @@ int main() {
     demonstrateDeadlockPrevention();
     demonstrateFuturesAndPromises();
     demonstrateThreadPool();
+    demonstrateWorkStealingPool();
+    benchmarkThreadPools();
+    benchmarkProducerConsumer();
+    benchmarkCounters();
+    benchmarkInstrumentation();
     
     return 0;
 }
@@ -322,6 +446,341 @@ void demonstrateThreadPool() {
     std::cout << "---\n\n";
 }
 
+void demonstrateWorkStealingPool() {
+    std::cout << "9. Work-Stealing Thread Pool:\n";
+    
+    WorkStealingThreadPool pool(4);
+    
+    // submit() hands back a std::future, just like std::async
+    std::vector<std::future<int>> squares;
+    for (int i = 1; i <= 5; ++i) {
+        squares.push_back(pool.submit([](int x) { return x * x; }, i));
+    }
+    std::cout << "Squares:";
+    for (auto& square : squares) {
+        std::cout << " " << square.get();
+    }
+    std::cout << "\n";
+    
+    // Tasks spawned from inside a worker go onto that worker's own deque;
+    // idle workers steal them from the other end
+    std::atomic<int> leaves{0};
+    auto root = pool.submit([&pool, &leaves]() {
+        for (int i = 0; i < 100; ++i) {
+            pool.enqueue([&leaves]() { leaves.fetch_add(1, std::memory_order_relaxed); });
+        }
+    });
+    root.get();
+    
+    pool.shutdown();  // Drains every spawned task before joining
+    std::cout << "Spawned tasks executed: " << leaves.load() << "\n";
+    
+    std::cout << "---\n\n";
+}
+
+// Busy-wait so the task body costs CPU time rather than a sleep
+static void spinFor(std::chrono::nanoseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+static void waitUntilDone(const std::atomic<int>& remaining) {
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+}
+
+// Returns tasks/sec for taskCount tasks of the given body length
+template<typename Pool, typename Submit>
+static double measurePoolThroughput(size_t numThreads, int taskCount, Submit submitAll) {
+    Pool pool(numThreads);
+    std::atomic<int> remaining{taskCount};
+    
+    auto start = std::chrono::steady_clock::now();
+    submitAll(pool, remaining);
+    waitUntilDone(remaining);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    
+    return taskCount / elapsed.count();
+}
+
+void benchmarkThreadPools() {
+    std::cout << "10. Thread Pool Throughput (tasks/sec):\n";
+    
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> threadCounts;
+    for (size_t t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+    
+    const std::chrono::microseconds bodies[] = {
+        std::chrono::microseconds(1), std::chrono::microseconds(10), std::chrono::microseconds(100)
+    };
+    // Roughly 50ms of single-threaded work per measurement
+    const std::chrono::microseconds workPerRun(50000);
+    
+    std::cout << std::setw(8) << "threads" << std::setw(8) << "body"
+              << std::setw(16) << "global queue" << std::setw(16) << "ws external"
+              << std::setw(16) << "ws spawned" << "\n";
+    
+    for (auto body : bodies) {
+        const int taskCount = static_cast<int>(workPerRun / body);
+        
+        for (size_t threads : threadCounts) {
+            double global = measurePoolThroughput<SimpleThreadPool>(threads, taskCount,
+                [taskCount, body](SimpleThreadPool& pool, std::atomic<int>& remaining) {
+                    for (int i = 0; i < taskCount; ++i) {
+                        pool.enqueue([body, &remaining]() {
+                            spinFor(body);
+                            remaining.fetch_sub(1, std::memory_order_release);
+                        });
+                    }
+                });
+            
+            double external = measurePoolThroughput<WorkStealingThreadPool>(threads, taskCount,
+                [taskCount, body](WorkStealingThreadPool& pool, std::atomic<int>& remaining) {
+                    for (int i = 0; i < taskCount; ++i) {
+                        pool.enqueue([body, &remaining]() {
+                            spinFor(body);
+                            remaining.fetch_sub(1, std::memory_order_release);
+                        });
+                    }
+                });
+            
+            // One root task fans out from inside the pool, so every push is local
+            double spawned = measurePoolThroughput<WorkStealingThreadPool>(threads, taskCount,
+                [taskCount, body](WorkStealingThreadPool& pool, std::atomic<int>& remaining) {
+                    pool.enqueue([&pool, taskCount, body, &remaining]() {
+                        for (int i = 0; i < taskCount; ++i) {
+                            pool.enqueue([body, &remaining]() {
+                                spinFor(body);
+                                remaining.fetch_sub(1, std::memory_order_release);
+                            });
+                        }
+                    });
+                });
+            
+            std::cout << std::setw(8) << threads << std::setw(6) << body.count() << "us"
+                      << std::fixed << std::setprecision(0)
+                      << std::setw(16) << global << std::setw(16) << external
+                      << std::setw(16) << spawned << "\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+    
+    std::cout << "---\n\n";
+}
+
+// Handoff latency = time from just before produce() to just after consume()
+static void reportHandoffLatency(const char* label, ProducerConsumer::Backend backend,
+                                 WaitStrategy wait, int producers, int consumers) {
+    const int itemsPerProducer = 20000;
+    const int totalItems = itemsPerProducer * producers;
+    
+    ProducerConsumer pc(64, backend, wait);
+    std::vector<std::chrono::steady_clock::time_point> sent(totalItems);
+    std::vector<int64_t> latencies(totalItems);
+    std::atomic<int> producersLeft{producers};
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < itemsPerProducer; ++i) {
+                int item = p * itemsPerProducer + i;
+                sent[item] = std::chrono::steady_clock::now();
+                pc.produce(item);
+                // Light pacing so we measure handoff rather than a full queue
+                spinFor(std::chrono::nanoseconds(500));
+            }
+            if (producersLeft.fetch_sub(1) == 1) {
+                pc.setFinished();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            int item;
+            while (pc.consume(item)) {
+                auto received = std::chrono::steady_clock::now();
+                latencies[item] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    received - sent[item]).count();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))];
+    };
+    
+    std::cout << std::setw(22) << label << std::setw(6) << producers << "P/" << consumers << "C"
+              << std::setw(10) << percentile(0.50) << std::setw(10) << percentile(0.99)
+              << std::setw(12) << percentile(0.999)
+              << std::setw(14) << static_cast<int64_t>(totalItems / elapsed.count()) << "\n";
+}
+
+void benchmarkProducerConsumer() {
+    std::cout << "11. Producer-Consumer Handoff Latency (ns):\n";
+    
+    std::cout << std::setw(22) << "backend" << std::setw(10) << "threads"
+              << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(12) << "p999"
+              << std::setw(14) << "items/sec" << "\n";
+    
+    const std::pair<int, int> shapes[] = {{1, 1}, {2, 2}};
+    for (auto [producers, consumers] : shapes) {
+        reportHandoffLatency("mutex + condvar", ProducerConsumer::Backend::Mutex,
+                             WaitStrategy::SpinThenPark, producers, consumers);
+        reportHandoffLatency("ring, spin-then-park", ProducerConsumer::Backend::LockFree,
+                             WaitStrategy::SpinThenPark, producers, consumers);
+        reportHandoffLatency("ring, spin", ProducerConsumer::Backend::LockFree,
+                             WaitStrategy::Spin, producers, consumers);
+    }
+    
+    // Batch API: one CAS claims a whole run of slots
+    MPMCRingBuffer<int> ring(16);
+    int batch[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int drained[8] = {};
+    size_t pushed = ring.produce_n(batch, 8);
+    size_t popped = ring.consume_n(drained, 8);
+    std::cout << "produce_n pushed " << pushed << ", consume_n popped " << popped;
+    if (popped > 0) {
+        std::cout << " (last = " << drained[popped - 1] << ")";
+    }
+    std::cout << "\n";
+    
+    std::cout << "---\n\n";
+}
+
+// Returns increments/sec with numThreads threads each doing opsPerThread increments
+template<typename Increment>
+static double measureIncrements(size_t numThreads, int opsPerThread, Increment increment) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < opsPerThread; ++i) {
+                increment();
+            }
+        });
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return numThreads * opsPerThread / elapsed.count();
+}
+
+void benchmarkCounters() {
+    std::cout << "12. Counter Scaling (increments/sec):\n";
+    
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    const int opsPerThread = 200000;
+    
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "mutex"
+              << std::setw(16) << "atomic" << std::setw(16) << "sharded" << std::setw(16) << "metrics" << "\n";
+    
+    for (size_t threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        ThreadSafeCounter mutexCounter(0);
+        AtomicDemo atomicCounter;
+        ShardedCounter shardedCounter;
+        instrumentation::Counter metricsCounter;
+        
+        double mutexRate = measureIncrements(threads, opsPerThread, [&]() { mutexCounter.increment(); });
+        double atomicRate = measureIncrements(threads, opsPerThread, [&]() { atomicCounter.incrementAtomic(); });
+        double shardedRate = measureIncrements(threads, opsPerThread, [&]() { shardedCounter.increment(); });
+        double metricsRate = measureIncrements(threads, opsPerThread, [&]() { metricsCounter.add(); });
+        
+        const long long expected = static_cast<long long>(threads) * opsPerThread;
+        bool correct = mutexCounter.getValue() == expected &&
+                       atomicCounter.getAtomicValue() == expected &&
+                       shardedCounter.getValue(ShardedCounter::ReadMode::SequentiallyConsistent) == expected &&
+                       (!instrumentation::Enabled || metricsCounter.value() == static_cast<uint64_t>(expected));
+        
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(0)
+                  << std::setw(16) << mutexRate << std::setw(16) << atomicRate
+                  << std::setw(16) << shardedRate << std::setw(16) << metricsRate
+                  << (correct ? "" : "  (count mismatch!)") << "\n";
+        std::cout.unsetf(std::ios::fixed);
+        
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+    
+    std::cout << "---\n\n";
+}
+
+// Cost of one empty timed scope, in ns
+template<typename Clock>
+static double scopedTimerCost(instrumentation::Histogram& histogram, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        instrumentation::ScopedTimer<Clock> timer(histogram);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+void benchmarkInstrumentation() {
+    std::cout << "13. Instrumentation Overhead and Export:\n";
+    
+    const int iterations = 1000000;
+    instrumentation::Histogram scratch;
+    std::cout << "instrumentation " << (instrumentation::Enabled ? "enabled" : "compiled out")
+              << "; per empty scope: steady_clock " << std::fixed << std::setprecision(1)
+              << scopedTimerCost<instrumentation::SteadyClock>(scratch, iterations) << " ns, TSC "
+              << scopedTimerCost<instrumentation::TscClock>(scratch, iterations) << " ns\n";
+    std::cout.unsetf(std::ios::fixed);
+    
+    // The pool records into the thread_pool_* metrics while the exporter
+    // rewrites the file in the background
+    {
+        instrumentation::PeriodicExporter exporter("pool_metrics.prom", instrumentation::ExportFormat::Prometheus,
+                                                   std::chrono::milliseconds(20));
+        SimpleThreadPool pool(4);
+        std::atomic<int> remaining{20000};
+        for (int i = 0; i < 20000; ++i) {
+            pool.enqueue([&remaining]() {
+                spinFor(std::chrono::microseconds(2));
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        waitUntilDone(remaining);
+        std::cout << "periodic exports while the pool ran: " << exporter.exportCount() << "\n";
+    }
+    
+    instrumentation::writeSummary(std::cout, "thread_pool_queue_wait",
+                                  instrumentation::histogram("thread_pool_queue_wait", ""));
+    instrumentation::writeSummary(std::cout, "thread_pool_task_run",
+                                  instrumentation::histogram("thread_pool_task_run", ""));
+    
+    std::ifstream exported("pool_metrics.prom");
+    std::string line;
+    std::cout << "pool_metrics.prom (first lines):\n";
+    for (int i = 0; i < 6 && std::getline(exported, line); ++i) {
+        std::cout << "  " << line << "\n";
+    }
+    std::cout << "JSON export:\n";
+    instrumentation::MetricsRegistry::instance().writeJson(std::cout);
+    
+    std::cout << "---\n\n";
+}
+
+
 // TODO: Implement all class methods
 void ThreadBasics::simpleTask(int id, const std::string& message) {
     std::cout << "Thread " << id << ": " << message << "\n";
@@ -361,4 +820,386 @@ void ThreadSafeCounter::add(int value) {
     count += value;
 }
 
+void AtomicDemo::incrementAtomic() {
+    ++atomicCounter;
+}
+
+int AtomicDemo::getAtomicValue() const {
+    return atomicCounter.load();
+}
+
 // TODO: Implement remaining class methods...
+
+// ProducerConsumer implementation
+ProducerConsumer::ProducerConsumer(size_t size, Backend backend, WaitStrategy wait)
+    : maxSize(size), finished(false), backend(backend) {
+    if (backend == Backend::LockFree) {
+        ring = std::make_unique<MPMCRingBuffer<int>>(size, wait);
+    }
+}
+
+bool ProducerConsumer::produce(int item) {
+    if (backend == Backend::LockFree) {
+        return ring->produce(item);
+    }
+    
+    std::unique_lock<std::mutex> lock(bufferMutex);
+    notFull.wait(lock, [this]() { return buffer.size() < maxSize; });
+    buffer.push(item);
+    lock.unlock();
+    notEmpty.notify_one();
+    return true;
+}
+
+bool ProducerConsumer::consume(int& item) {
+    if (backend == Backend::LockFree) {
+        return ring->consume(item);
+    }
+    
+    std::unique_lock<std::mutex> lock(bufferMutex);
+    // The predicate guards against spurious wakeups
+    notEmpty.wait(lock, [this]() { return !buffer.empty() || finished; });
+    if (buffer.empty()) {
+        return false;  // Finished and drained
+    }
+    item = buffer.front();
+    buffer.pop();
+    lock.unlock();
+    notFull.notify_one();
+    return true;
+}
+
+void ProducerConsumer::setFinished() {
+    if (backend == Backend::LockFree) {
+        ring->close();
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        finished = true;
+    }
+    notEmpty.notify_all();
+}
+
+size_t ProducerConsumer::size() const {
+    if (backend == Backend::LockFree) {
+        return ring->size();
+    }
+    
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    return buffer.size();
+}
+
+// MPMCRingBuffer implementation
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+template<typename T>
+MPMCRingBuffer<T>::MPMCRingBuffer(size_t minCapacity, WaitStrategy wait)
+    : capacity([minCapacity]() {
+          size_t cap = 2;
+          while (cap < minCapacity) {
+              cap <<= 1;
+          }
+          return cap;
+      }()),
+      mask(capacity - 1),
+      cells(new Cell[capacity]),
+      strategy(wait) {
+    for (size_t i = 0; i < capacity; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+bool MPMCRingBuffer<T>::try_produce(const T& item) {
+    if (!pushOne(item)) {
+        return false;
+    }
+    wake(waitingConsumers, notEmpty);
+    return true;
+}
+
+template<typename T>
+bool MPMCRingBuffer<T>::try_consume(T& item) {
+    if (!popOne(item)) {
+        return false;
+    }
+    wake(waitingProducers, notFull);
+    return true;
+}
+
+// pushOne/popOne never touch parkMutex, so they are safe inside a wait predicate
+template<typename T>
+bool MPMCRingBuffer<T>::pushOne(const T& item) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            // Slot is free for this lap: try to claim it
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Full: the consumer of the previous lap hasn't freed it yet
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);  // Another producer won
+        }
+    }
+    
+    cell->data = item;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool MPMCRingBuffer<T>::popOne(T& item) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Empty
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    
+    item = std::move(cell->data);
+    // Hand the cell to the producer one lap ahead
+    cell->sequence.store(pos + capacity, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+size_t MPMCRingBuffer<T>::produce_n(const T* items, size_t count) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    size_t n;
+    for (;;) {
+        // Every position below dequeuePos + capacity has been claimed by a consumer,
+        // so those slots are free or about to be
+        size_t head = dequeuePos.load(std::memory_order_acquire);
+        if (head > pos) {
+            // Consumers never pass enqueuePos, so pos is stale: pos - head would wrap
+            pos = enqueuePos.load(std::memory_order_relaxed);
+            continue;
+        }
+        size_t used = pos - head;
+        if (used >= capacity) {
+            return 0;
+        }
+        n = std::min(count, capacity - used);
+        if (n == 0) {
+            return 0;
+        }
+        if (enqueuePos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    
+    for (size_t i = 0; i < n; ++i) {
+        Cell& cell = cells[(pos + i) & mask];
+        // A consumer may still be moving the previous lap's value out
+        while (cell.sequence.load(std::memory_order_acquire) != pos + i) {
+            cpuRelax();
+        }
+        cell.data = items[i];
+        cell.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    wake(waitingConsumers, notEmpty, n > 1);
+    return n;
+}
+
+template<typename T>
+size_t MPMCRingBuffer<T>::consume_n(T* out, size_t maxCount) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    size_t n;
+    for (;;) {
+        // Every position below enqueuePos has been claimed by a producer
+        size_t tail = enqueuePos.load(std::memory_order_acquire);
+        if (tail <= pos) {
+            return 0;
+        }
+        n = std::min(maxCount, tail - pos);
+        if (n == 0) {
+            return 0;
+        }
+        if (dequeuePos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    
+    for (size_t i = 0; i < n; ++i) {
+        Cell& cell = cells[(pos + i) & mask];
+        // The producer that claimed this slot may still be writing it
+        while (cell.sequence.load(std::memory_order_acquire) != pos + i + 1) {
+            cpuRelax();
+        }
+        out[i] = std::move(cell.data);
+        cell.sequence.store(pos + i + capacity, std::memory_order_release);
+    }
+    wake(waitingProducers, notFull, n > 1);
+    return n;
+}
+
+template<typename T>
+template<typename Attempt>
+bool MPMCRingBuffer<T>::waitUntil(Attempt attempt, std::atomic<size_t>& waiters,
+                                  std::condition_variable& cv) {
+    for (int spin = 0; spin < SpinLimit; ++spin) {
+        if (attempt()) {
+            return true;
+        }
+        if (closed.load(std::memory_order_acquire)) {
+            return attempt();
+        }
+        cpuRelax();
+    }
+    
+    if (strategy == WaitStrategy::Spin) {
+        for (;;) {
+            if (attempt()) {
+                return true;
+            }
+            if (closed.load(std::memory_order_acquire)) {
+                return attempt();
+            }
+            std::this_thread::yield();
+        }
+    }
+    
+    bool succeeded = false;
+    std::unique_lock<std::mutex> lock(parkMutex);
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    // Pairs with the fence in wake(): either we see the new item or the waker sees us
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cv.wait(lock, [&]() {
+        succeeded = attempt();
+        return succeeded || closed.load(std::memory_order_acquire);
+    });
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+    lock.unlock();
+    
+    return succeeded || attempt();
+}
+
+template<typename T>
+void MPMCRingBuffer<T>::wake(std::atomic<size_t>& waiters, std::condition_variable& cv, bool all) {
+    if (strategy != WaitStrategy::SpinThenPark) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        if (all) {
+            cv.notify_all();
+        } else {
+            cv.notify_one();
+        }
+    }
+}
+
+template<typename T>
+bool MPMCRingBuffer<T>::produce(const T& item) {
+    if (waitUntil([this, &item]() { return pushOne(item); }, waitingProducers, notFull)) {
+        wake(waitingConsumers, notEmpty);
+        return true;
+    }
+    return false;
+}
+
+template<typename T>
+bool MPMCRingBuffer<T>::consume(T& item) {
+    if (waitUntil([this, &item]() { return popOne(item); }, waitingConsumers, notEmpty)) {
+        wake(waitingProducers, notFull);
+        return true;
+    }
+    return false;
+}
+
+template<typename T>
+void MPMCRingBuffer<T>::close() {
+    closed.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(parkMutex);
+    notEmpty.notify_all();
+    notFull.notify_all();
+}
+
+template<typename T>
+bool MPMCRingBuffer<T>::isClosed() const {
+    return closed.load(std::memory_order_acquire);
+}
+
+template<typename T>
+size_t MPMCRingBuffer<T>::size() const {
+    size_t tail = enqueuePos.load(std::memory_order_acquire);
+    size_t head = dequeuePos.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+// ShardedCounter implementation
+std::atomic<size_t> ShardedCounter::nextThreadSlot{0};
+
+size_t ShardedCounter::threadSlot() {
+    // Assigned once per thread; consecutive threads land on different shards
+    thread_local size_t slot = nextThreadSlot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+ShardedCounter::ShardedCounter(size_t numShards)
+    : shardCount(numShards > 0 ? numShards
+                               : std::max<size_t>(1, std::thread::hardware_concurrency()) * 2),
+      shards(new Shard[shardCount]) {}
+
+ShardedCounter::Shard& ShardedCounter::localShard() {
+    return shards[threadSlot() % shardCount];
+}
+
+void ShardedCounter::increment() {
+    add(1);
+}
+
+void ShardedCounter::decrement() {
+    add(-1);
+}
+
+void ShardedCounter::add(long long value) {
+    // Still an atomic RMW because two threads may share a shard once there are
+    // more threads than shards, but the line is normally owned by this core
+    localShard().value.fetch_add(value, std::memory_order_relaxed);
+}
+
+long long ShardedCounter::getValue(ReadMode mode) const {
+    const std::memory_order order = mode == ReadMode::Relaxed ? std::memory_order_relaxed
+                                                              : std::memory_order_seq_cst;
+    if (mode == ReadMode::SequentiallyConsistent) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    
+    long long total = 0;
+    for (size_t i = 0; i < shardCount; ++i) {
+        total += shards[i].value.load(order);
+    }
+    return total;
+}
+
+void ShardedCounter::reset() {
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards[i].value.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Allocation Counter
+ *
+ * Replaces global operator new/delete with malloc-backed versions that
+ * count every allocation, so benchmarks can report allocations per
+ * operation next to their timings. Replacement operators cannot be inline:
+ * include this header from exactly one translation unit per executable.
+ * Used by 06_operator_overloading.cpp (string concatenation, expression
+ * templates), 13_friend_functions.cpp (Vector3DArray expressions),
+ * 19_move_semantics.cpp (log formatting) and 22_lambda_functions.cpp
+ * (callable wrappers).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Relaxed: a benchmark reads it on one thread around the code it measures
+inline std::atomic<size_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+struct AllocationRun {
+    double nsPerOp;
+    double allocationsPerOp;
+};
+
+// Runs fn() once, which is expected to do ops operations
+template<typename Fn>
+AllocationRun measureAllocations(size_t ops, Fn&& fn) {
+    size_t before = allocationCount.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
+    return {elapsed.count() / static_cast<double>(ops), static_cast<double>(allocations) / static_cast<double>(ops)};
+}
@@ -0,0 +1,785 @@
+/*
+ * Coroutine Async File I/O
+ *
+ * co_await io.read_at(fd, buffer, offset) and io.write_at(...) suspend the
+ * calling coroutine until the transfer finishes, then resume it on a
+ * SimpleThreadPool (or on the I/O thread when no pool is given). On Linux the
+ * backend is io_uring, driven through the raw syscalls so liburing is not
+ * needed; when no ring can be created (old kernel, seccomp, other OS) the
+ * same operations run as blocking pread/pwrite on a small thread pool.
+ *
+ * Results follow io_uring: bytes transferred, or -errno. Every operation must
+ * have completed before the AsyncIO that issued it is destroyed.
+ * Needs C++20 (coroutines). Used by 25_file_io.cpp.
+ */
+
+#pragma once
+
+#if __cplusplus < 202002L
+#error "async_io.h uses coroutines and needs a C++20 target"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define ASYNC_IO_HAS_URING 1
+#else
+#define ASYNC_IO_HAS_URING 0
+#endif
+
+#include "simple_thread_pool.h"
+
+namespace async_detail {
+
+// Resumes whoever awaited the task; a task nobody awaited just stops
+struct FinalAwaiter {
+    bool await_ready() noexcept { return false; }
+    template<typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+        std::coroutine_handle<> next = h.promise().continuation;
+        return next ? next : std::noop_coroutine();
+    }
+    void await_resume() noexcept {}
+};
+
+template<typename T>
+struct TaskResult {
+    std::optional<T> value;
+    std::exception_ptr error;
+
+    void return_value(T v) { value.emplace(std::move(v)); }
+    T take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template<>
+struct TaskResult<void> {
+    std::exception_ptr error;
+
+    void return_void() {}
+    void take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+} // namespace async_detail
+
+// Lazily started coroutine: runs when first awaited and resumes the awaiter
+// (by symmetric transfer, so chains of tasks do not grow the stack) when done
+template<typename T = void>
+class IoTask {
+public:
+    struct promise_type : async_detail::TaskResult<T> {
+        std::coroutine_handle<> continuation;
+
+        IoTask get_return_object() { return IoTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        async_detail::FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() { this->error = std::current_exception(); }
+    };
+
+private:
+    using Handle = std::coroutine_handle<promise_type>;
+    Handle handle;
+
+    explicit IoTask(Handle h) : handle(h) {}
+
+    // TakeResult: await_resume yields the task's value (or rethrows) instead of nothing
+    template<bool TakeResult>
+    struct Awaiter {
+        Handle handle;
+
+        bool await_ready() const noexcept { return handle.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            handle.promise().continuation = awaiting;
+            return handle;
+        }
+        decltype(auto) await_resume() {
+            if constexpr (TakeResult) {
+                return handle.promise().take();
+            }
+        }
+    };
+
+public:
+    IoTask(IoTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    IoTask& operator=(IoTask other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    ~IoTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    // co_await task: starts it and yields its result, rethrowing its exception
+    Awaiter<true> operator co_await() const noexcept { return {handle}; }
+    // Only waits for completion; result() collects the outcome afterwards
+    Awaiter<false> completion() const noexcept { return {handle}; }
+
+    bool done() const { return handle.done(); }
+    T result() { return handle.promise().take(); }
+};
+
+// A buffer registered with AsyncIO::registerBuffers(). The kernel pins its
+// pages once, so fixed reads and writes skip the per-operation page mapping.
+struct RegisteredBuffer {
+    std::span<std::byte> data;
+    unsigned index = 0;
+};
+
+namespace async_detail {
+
+#if ASYNC_IO_HAS_URING
+// Submission and completion rings shared with the kernel. Not thread-safe:
+// AsyncIO serializes push/submit, and only its completion thread drains.
+class UringQueue {
+private:
+    int ringFd = -1;
+    void* sqMap = nullptr;
+    void* cqMap = nullptr;
+    size_t sqMapSize = 0;
+    size_t cqMapSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+    unsigned unsubmitted = 0;
+
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+
+    static void* mapRing(int fd, size_t size, off_t offset) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+public:
+    UringQueue() = default;
+    ~UringQueue() { close(); }
+
+    UringQueue(const UringQueue&) = delete;
+    UringQueue& operator=(const UringQueue&) = delete;
+
+    bool setup(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd < 0) {
+            return false;
+        }
+
+        // Since 5.4 both rings share one mapping
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (singleMap) {
+            sqMapSize = cqMapSize = std::max(sqMapSize, cqMapSize);
+        }
+        sqMap = mapRing(ringFd, sqMapSize, IORING_OFF_SQ_RING);
+        cqMap = singleMap ? sqMap : mapRing(ringFd, cqMapSize, IORING_OFF_CQ_RING);
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(mapRing(ringFd, sqesSize, IORING_OFF_SQES));
+        if (!sqMap || !cqMap || !sqes) {
+            close();
+            return false;
+        }
+
+        char* sq = static_cast<char*>(sqMap);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries = params.sq_entries;
+        char* cq = static_cast<char*>(cqMap);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void close() {
+        if (sqes) {
+            munmap(sqes, sqesSize);
+        }
+        if (cqMap && cqMap != sqMap) {
+            munmap(cqMap, cqMapSize);
+        }
+        if (sqMap) {
+            munmap(sqMap, sqMapSize);
+        }
+        if (ringFd >= 0) {
+            ::close(ringFd);
+        }
+        sqes = nullptr;
+        sqMap = cqMap = nullptr;
+        ringFd = -1;
+    }
+
+    // Queues one SQE; false when the submission ring is full
+    bool push(uint8_t opcode, int fd, void* address, unsigned length, uint64_t offset,
+              unsigned bufferIndex, uint64_t userData) {
+        unsigned tail = *sqTail;  // Only this side writes the tail
+        unsigned head = std::atomic_ref<unsigned>(*sqHead).load(std::memory_order_acquire);
+        if (tail - head == sqEntries) {
+            return false;
+        }
+        unsigned index = tail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uintptr_t>(address);
+        sqe.len = length;
+        sqe.off = offset;
+        sqe.buf_index = static_cast<uint16_t>(bufferIndex);
+        sqe.user_data = userData;
+        sqArray[index] = index;
+        // Publishes the SQE contents before the kernel can see the new tail
+        std::atomic_ref<unsigned>(*sqTail).store(tail + 1, std::memory_order_release);
+        ++unsubmitted;
+        return true;
+    }
+
+    // Hands every queued SQE to the kernel in one syscall; 0 or -errno
+    int submit() {
+        while (unsubmitted > 0) {
+            int submitted = enter(unsubmitted, 0, 0);
+            if (submitted < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return -errno;
+            }
+            unsubmitted -= static_cast<unsigned>(submitted);
+        }
+        return 0;
+    }
+
+    // Takes back the SQEs the kernel has not consumed, handing each one's
+    // userData to onWithdrawn. Without SQPOLL the kernel reads the ring only
+    // inside io_uring_enter, which the caller serializes with push/submit.
+    template<typename F>
+    void withdrawUnsubmitted(F&& onWithdrawn) {
+        unsigned tail = *sqTail;
+        for (unsigned i = tail - unsubmitted; i != tail; ++i) {
+            onWithdrawn(sqes[sqArray[i & sqMask]].user_data);
+        }
+        std::atomic_ref<unsigned>(*sqTail).store(tail - unsubmitted, std::memory_order_release);
+        unsubmitted = 0;
+    }
+
+    // Blocks until at least one completion is posted; false if the ring failed
+    bool waitForCompletion() {
+        while (enter(0, 1, IORING_ENTER_GETEVENTS) < 0) {
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Hands each posted completion to onCompletion(userData, result)
+    template<typename F>
+    void drainCompletions(F&& onCompletion) {
+        unsigned head = *cqHead;  // Only this side writes the head
+        unsigned tail = std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire);
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes[head & cqMask];
+            uint64_t userData = cqe.user_data;
+            int32_t result = cqe.res;
+            // Frees the slot before running the callback, which may issue more I/O
+            std::atomic_ref<unsigned>(*cqHead).store(++head, std::memory_order_release);
+            onCompletion(userData, result);
+        }
+    }
+
+    bool registerBuffers(const iovec* buffers, unsigned count) {
+        syscall(__NR_io_uring_register, ringFd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        return syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+    }
+};
+#endif
+
+} // namespace async_detail
+
+struct AsyncIOOptions {
+    unsigned queueDepth = 128;   // Submission ring size; a full ring is handed to the kernel early
+    bool preferIoUring = true;
+    size_t fallbackThreads = 4;  // Blocking workers for the thread-pool backend
+};
+
+class AsyncIO {
+public:
+    enum class Backend { IoUring, ThreadPool };
+
+    class Operation;
+    class Batch;
+
+private:
+    enum class Kind { Read, Write, ReadFixed, WriteFixed };
+
+    SimpleThreadPool* executor;
+    Backend activeBackend = Backend::ThreadPool;
+    std::mutex submitMutex;
+    unsigned batchDepth = 0;
+    std::vector<std::span<std::byte>> registered;
+    bool kernelBuffers = false;
+#if ASYNC_IO_HAS_URING
+    async_detail::UringQueue uring;
+    std::thread completionThread;
+#endif
+    std::vector<Operation*> deferred;  // Thread-pool backend: held back by an open Batch
+    std::unique_ptr<SimpleThreadPool> blockingPool;
+
+    Operation makeOperation(Kind kind, int fd, void* address, size_t length, uint64_t offset, unsigned index);
+    void submit(Operation* op);
+    void beginBatch();
+    void endBatch();
+#if ASYNC_IO_HAS_URING
+    int flushSubmissions(std::vector<Operation*>& failed);
+#endif
+    void complete(Operation* op, ssize_t result);
+    void runBlocking(Operation* op);
+    void completionLoop();
+
+public:
+    // executor runs the continuations; nullptr resumes them on the I/O thread
+    explicit AsyncIO(SimpleThreadPool* executor = nullptr, AsyncIOOptions options = AsyncIOOptions());
+    ~AsyncIO();
+
+    AsyncIO(const AsyncIO&) = delete;
+    AsyncIO& operator=(const AsyncIO&) = delete;
+
+    Backend backend() const { return activeBackend; }
+    const char* backendName() const { return activeBackend == Backend::IoUring ? "io_uring" : "thread pool"; }
+
+    // Call with no operations in flight. Returns false when the kernel kept
+    // no registration (thread-pool backend, RLIMIT_MEMLOCK); fixed
+    // operations then run as plain ones on the same memory.
+    bool registerBuffers(const std::vector<std::span<std::byte>>& buffers);
+    RegisteredBuffer registeredBuffer(unsigned index) const { return {registered[index], index}; }
+    bool hasKernelBuffers() const { return kernelBuffers; }
+
+    Operation read_at(int fd, std::span<std::byte> buffer, uint64_t offset);
+    Operation write_at(int fd, std::span<const std::byte> buffer, uint64_t offset);
+    Operation read_at(int fd, RegisteredBuffer buffer, uint64_t offset);
+    Operation write_at(int fd, RegisteredBuffer buffer, uint64_t offset);
+};
+
+// Awaitable for one transfer; co_await yields bytes transferred or -errno
+class AsyncIO::Operation {
+private:
+    friend class AsyncIO;
+
+    AsyncIO& io;
+    Kind kind;
+    int fd;
+    void* address;
+    unsigned length;
+    uint64_t offset;
+    unsigned bufferIndex;
+    ssize_t result = 0;
+    std::coroutine_handle<> waiter;
+
+    Operation(AsyncIO& io, Kind kind, int fd, void* address, unsigned length, uint64_t offset, unsigned index)
+        : io(io), kind(kind), fd(fd), address(address), length(length), offset(offset), bufferIndex(index) {}
+
+public:
+    Operation(const Operation&) = delete;
+    Operation& operator=(const Operation&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+    // The coroutine may resume on another thread before this returns
+    void await_suspend(std::coroutine_handle<> h) {
+        waiter = h;
+        io.submit(this);
+    }
+    ssize_t await_resume() const noexcept { return result; }
+};
+
+// While any Batch is alive, operations from every thread are queued and go
+// to the kernel together when the last one ends. Do not wait on them inside.
+class AsyncIO::Batch {
+private:
+    AsyncIO& io;
+
+public:
+    explicit Batch(AsyncIO& target) : io(target) { io.beginBatch(); }
+    ~Batch() { io.endBatch(); }
+
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+};
+
+// RAII file descriptor bound to an AsyncIO: the async counterpart of
+// FileRAII in 17_raii.cpp
+class AsyncFile {
+private:
+    AsyncIO* io = nullptr;
+    int fd = -1;
+
+public:
+    AsyncFile() = default;
+    AsyncFile(AsyncIO& target, const char* path, int flags, mode_t mode = 0644)
+        : io(&target), fd(::open(path, flags | O_CLOEXEC, mode)) {}
+    ~AsyncFile() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    AsyncFile(const AsyncFile&) = delete;
+    AsyncFile& operator=(const AsyncFile&) = delete;
+    AsyncFile(AsyncFile&& other) noexcept : io(other.io), fd(std::exchange(other.fd, -1)) {}
+    AsyncFile& operator=(AsyncFile&& other) noexcept {
+        if (this != &other) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            io = other.io;
+            fd = std::exchange(other.fd, -1);
+        }
+        return *this;
+    }
+
+    bool isOpen() const { return fd >= 0; }
+    int handle() const { return fd; }
+
+    AsyncIO::Operation read_at(std::span<std::byte> buffer, uint64_t offset) { return io->read_at(fd, buffer, offset); }
+    AsyncIO::Operation write_at(std::span<const std::byte> buffer, uint64_t offset) {
+        return io->write_at(fd, buffer, offset);
+    }
+    AsyncIO::Operation read_at(RegisteredBuffer buffer, uint64_t offset) { return io->read_at(fd, buffer, offset); }
+    AsyncIO::Operation write_at(RegisteredBuffer buffer, uint64_t offset) { return io->write_at(fd, buffer, offset); }
+};
+
+namespace async_detail {
+
+// Counts finished tasks; notifies under the lock so the waiter cannot
+// destroy the counter while a finishing task is still inside arrive()
+class CompletionCounter {
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t remaining;
+
+public:
+    explicit CompletionCounter(size_t count) : remaining(count) {}
+
+    void arrive() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--remaining == 0) {
+            condition.notify_all();
+        }
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return remaining == 0; });
+    }
+};
+
+// Starts eagerly and frees its own frame when it finishes
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+template<typename T>
+DetachedTask signalWhenDone(IoTask<T>& task, CompletionCounter& counter) {
+    co_await task.completion();
+    counter.arrive();
+}
+
+} // namespace async_detail
+
+// Runs task to completion from ordinary code, blocking the calling thread
+template<typename T>
+T syncWait(IoTask<T> task) {
+    async_detail::CompletionCounter counter(1);
+    async_detail::signalWhenDone(task, counter);
+    counter.wait();
+    return task.result();
+}
+
+// Starts every task, blocks until all have finished and rethrows the first
+// failure. With batchOn, the tasks' first operations share one submission.
+inline void syncWaitAll(std::vector<IoTask<>>& tasks, AsyncIO* batchOn = nullptr) {
+    async_detail::CompletionCounter counter(tasks.size());
+    {
+        std::optional<AsyncIO::Batch> batch;
+        if (batchOn) {
+            batch.emplace(*batchOn);
+        }
+        for (IoTask<>& task : tasks) {
+            async_detail::signalWhenDone(task, counter);
+        }
+    }
+    counter.wait();
+    for (IoTask<>& task : tasks) {
+        task.result();
+    }
+}
+
+// AsyncIO implementation
+inline AsyncIO::AsyncIO(SimpleThreadPool* executor, AsyncIOOptions options) : executor(executor) {
+#if ASYNC_IO_HAS_URING
+    if (options.preferIoUring && uring.setup(options.queueDepth)) {
+        activeBackend = Backend::IoUring;
+        completionThread = std::thread([this]() { completionLoop(); });
+        return;
+    }
+#endif
+    activeBackend = Backend::ThreadPool;
+    blockingPool = std::make_unique<SimpleThreadPool>(std::max<size_t>(1, options.fallbackThreads));
+}
+
+inline AsyncIO::~AsyncIO() {
+#if ASYNC_IO_HAS_URING
+    if (activeBackend == Backend::IoUring) {
+        // A NOP tagged 0 tells the completion thread to stop
+        {
+            std::lock_guard<std::mutex> lock(submitMutex);
+            while (!uring.push(IORING_OP_NOP, -1, nullptr, 0, 0, 0, 0)) {
+                uring.submit();
+            }
+            uring.submit();
+        }
+        completionThread.join();
+        return;
+    }
+#endif
+    blockingPool.reset();  // Drains any work still queued
+}
+
+inline bool AsyncIO::registerBuffers(const std::vector<std::span<std::byte>>& buffers) {
+    registered = buffers;
+    kernelBuffers = false;
+#if ASYNC_IO_HAS_URING
+    if (activeBackend == Backend::IoUring && !buffers.empty()) {
+        std::vector<iovec> iovecs;
+        for (std::span<std::byte> buffer : buffers) {
+            iovecs.push_back({buffer.data(), buffer.size()});
+        }
+        kernelBuffers = uring.registerBuffers(iovecs.data(), static_cast<unsigned>(iovecs.size()));
+    }
+#endif
+    return kernelBuffers;
+}
+
+inline AsyncIO::Operation AsyncIO::makeOperation(Kind kind, int fd, void* address, size_t length, uint64_t offset,
+                                                 unsigned index) {
+    // One SQE moves at most 2 GiB, like read(2)
+    unsigned clamped = static_cast<unsigned>(std::min<size_t>(length, 0x7ffff000));
+    return Operation(*this, kind, fd, address, clamped, offset, index);
+}
+
+inline AsyncIO::Operation AsyncIO::read_at(int fd, std::span<std::byte> buffer, uint64_t offset) {
+    return makeOperation(Kind::Read, fd, buffer.data(), buffer.size(), offset, 0);
+}
+
+inline AsyncIO::Operation AsyncIO::write_at(int fd, std::span<const std::byte> buffer, uint64_t offset) {
+    return makeOperation(Kind::Write, fd, const_cast<std::byte*>(buffer.data()), buffer.size(), offset, 0);
+}
+
+inline AsyncIO::Operation AsyncIO::read_at(int fd, RegisteredBuffer buffer, uint64_t offset) {
+    Kind kind = kernelBuffers ? Kind::ReadFixed : Kind::Read;
+    return makeOperation(kind, fd, buffer.data.data(), buffer.data.size(), offset, buffer.index);
+}
+
+inline AsyncIO::Operation AsyncIO::write_at(int fd, RegisteredBuffer buffer, uint64_t offset) {
+    Kind kind = kernelBuffers ? Kind::WriteFixed : Kind::Write;
+    return makeOperation(kind, fd, buffer.data.data(), buffer.data.size(), offset, buffer.index);
+}
+
+inline void AsyncIO::submit(Operation* op) {
+#if ASYNC_IO_HAS_URING
+    if (activeBackend == Backend::IoUring) {
+        static constexpr uint8_t opcodes[] = {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED,
+                                              IORING_OP_WRITE_FIXED};
+        uint8_t opcode = opcodes[static_cast<int>(op->kind)];
+        int error = 0;
+        bool queued = false;
+        std::vector<Operation*> failed;
+        {
+            std::lock_guard<std::mutex> lock(submitMutex);
+            // A full ring is drained into the kernel, even inside a batch
+            queued = uring.push(opcode, op->fd, op->address, op->length, op->offset, op->bufferIndex,
+                                reinterpret_cast<uintptr_t>(op));
+            if (!queued) {
+                error = flushSubmissions(failed);
+                queued = error == 0 && uring.push(opcode, op->fd, op->address, op->length, op->offset,
+                                                  op->bufferIndex, reinterpret_cast<uintptr_t>(op));
+            }
+            if (queued && batchDepth == 0) {
+                error = flushSubmissions(failed);
+            }
+        }
+        // Completed outside the lock: an inline resume may submit again
+        for (Operation* failedOp : failed) {
+            complete(failedOp, error);
+        }
+        if (!queued) {
+            complete(op, error < 0 ? error : -EBUSY);
+        }
+        return;
+    }
+#endif
+    {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        if (batchDepth > 0) {
+            deferred.push_back(op);
+            return;
+        }
+    }
+    runBlocking(op);
+}
+
+inline void AsyncIO::beginBatch() {
+    std::lock_guard<std::mutex> lock(submitMutex);
+    ++batchDepth;
+}
+
+inline void AsyncIO::endBatch() {
+    std::vector<Operation*> ready;
+    std::vector<Operation*> failed;
+    int error = 0;
+    {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        if (--batchDepth > 0) {
+            return;
+        }
+#if ASYNC_IO_HAS_URING
+        if (activeBackend == Backend::IoUring) {
+            error = flushSubmissions(failed);
+        }
+#endif
+        ready.swap(deferred);  // Always empty on io_uring
+    }
+    for (Operation* op : failed) {
+        complete(op, error);
+    }
+    for (Operation* op : ready) {
+        runBlocking(op);
+    }
+}
+
+#if ASYNC_IO_HAS_URING
+// Called with submitMutex held. -EBUSY means the completion ring is backed
+// up, so the completion thread is about to wake: it retries the SQEs after
+// draining. Any other failure would leave them queued with nobody to wake
+// for them, so they are withdrawn into failed for the caller to complete
+// with the error once the lock is released.
+inline int AsyncIO::flushSubmissions(std::vector<Operation*>& failed) {
+    int error = uring.submit();
+    if (error < 0 && error != -EBUSY) {
+        uring.withdrawUnsubmitted([&failed](uint64_t userData) {
+            failed.push_back(reinterpret_cast<Operation*>(userData));
+        });
+    }
+    return error;
+}
+#endif
+
+inline void AsyncIO::complete(Operation* op, ssize_t result) {
+    // op lives in the suspended coroutine's frame: read it before resuming
+    op->result = result;
+    std::coroutine_handle<> waiter = op->waiter;
+    if (executor) {
+        executor->enqueue([waiter]() { waiter.resume(); });
+    } else {
+        waiter.resume();
+    }
+}
+
+inline void AsyncIO::runBlocking(Operation* op) {
+    blockingPool->enqueue([this, op]() {
+        bool reading = op->kind == Kind::Read || op->kind == Kind::ReadFixed;
+        ssize_t n = reading ? ::pread(op->fd, op->address, op->length, static_cast<off_t>(op->offset))
+                            : ::pwrite(op->fd, op->address, op->length, static_cast<off_t>(op->offset));
+        complete(op, n < 0 ? -errno : n);
+    });
+}
+
+inline void AsyncIO::completionLoop() {
+#if ASYNC_IO_HAS_URING
+    bool stopping = false;
+    std::vector<std::pair<Operation*, int32_t>> done;
+    std::vector<Operation*> failed;
+    while (!stopping && uring.waitForCompletion()) {
+        int error = 0;
+        {
+            // Draining under the lock also orders each submitter before its
+            // completion for race detectors, which cannot see the handoff
+            // through the kernel.
+            std::lock_guard<std::mutex> lock(submitMutex);
+            uring.drainCompletions([&done, &stopping](uint64_t userData, int32_t result) {
+                if (userData == 0) {
+                    stopping = true;
+                } else {
+                    done.emplace_back(reinterpret_cast<Operation*>(userData), result);
+                }
+            });
+            // Retries SQEs an -EBUSY submission left behind, now that the
+            // completion ring has room
+            if (batchDepth == 0) {
+                error = flushSubmissions(failed);
+            }
+        }
+        for (auto [op, result] : done) {
+            complete(op, result);
+        }
+        for (Operation* op : failed) {
+            if (op) {
+                complete(op, error);
+            } else {
+                stopping = true;  // The stop NOP could not be submitted either
+            }
+        }
+        done.clear();
+        failed.clear();
+    }
+#endif
+}
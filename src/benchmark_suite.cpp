@@ -0,0 +1,98 @@
+/*
+ * Benchmark Suite - standalone runner
+ *
+ * Runs the container and smart pointer benchmarks with repetitions and
+ * reports them as a table, JSON or CSV for tracking regressions across builds.
+ *
+ * Usage: benchmark_suite [--suite=all|containers|pointers] [--format=table|json|csv]
+ *                        [--output=FILE] [--filter=SUBSTRING] [--elements=N]
+ *                        [--repetitions=N] [--warmup=N] [--no-counters]
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark_suite.h"
+#include "container_benchmarks.h"
+#include "pointer_benchmarks.h"
+
+struct RunnerOptions {
+    std::string suite = "all";
+    std::string format = "table";
+    std::string output;
+    size_t elements = 100000;
+    BenchmarkOptions benchmark;
+};
+
+static bool parseArgument(const std::string& arg, RunnerOptions& options) {
+    auto valueOf = [&arg](const char* prefix) -> const char* {
+        size_t length = std::char_traits<char>::length(prefix);
+        return arg.compare(0, length, prefix) == 0 ? arg.c_str() + length : nullptr;
+    };
+    if (const char* v = valueOf("--suite=")) {
+        options.suite = v;
+    } else if (const char* v = valueOf("--format=")) {
+        options.format = v;
+    } else if (const char* v = valueOf("--output=")) {
+        options.output = v;
+    } else if (const char* v = valueOf("--filter=")) {
+        options.benchmark.filter = v;
+    } else if (const char* v = valueOf("--elements=")) {
+        options.elements = std::strtoull(v, nullptr, 10);
+    } else if (const char* v = valueOf("--repetitions=")) {
+        options.benchmark.repetitions = std::atoi(v);
+    } else if (const char* v = valueOf("--warmup=")) {
+        options.benchmark.warmupRuns = std::atoi(v);
+    } else if (arg == "--no-counters") {
+        options.benchmark.hardwareCounters = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    RunnerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (!parseArgument(argv[i], options)) {
+            std::cerr << "Unknown argument: " << argv[i] << "\n"
+                      << "Usage: " << argv[0] << " [--suite=all|containers|pointers] [--format=table|json|csv]\n"
+                      << "       [--output=FILE] [--filter=SUBSTRING] [--elements=N] [--repetitions=N]\n"
+                      << "       [--warmup=N] [--no-counters]\n";
+            return 2;
+        }
+    }
+    if (options.elements == 0 || (options.format != "table" && options.format != "json" && options.format != "csv")) {
+        std::cerr << "Invalid --elements or --format\n";
+        return 2;
+    }
+
+    BenchmarkSuite suite("cpp-interview-prep");
+    if (options.suite == "all" || options.suite == "containers") {
+        addContainerBenchmarks(suite, options.elements);
+    }
+    if (options.suite == "all" || options.suite == "pointers") {
+        addPointerBenchmarks(suite, options.elements);
+    }
+    suite.run(options.benchmark);
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Cannot open " << options.output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    if (options.format == "json") {
+        suite.writeJson(out);
+    } else if (options.format == "csv") {
+        suite.writeCsv(out);
+    } else {
+        suite.writeTable(out);
+    }
+    return 0;
+}
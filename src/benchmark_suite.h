@@ -0,0 +1,437 @@
+/*
+ * Benchmark Suite
+ *
+ * Small benchmarking framework shared by the topic files and the standalone
+ * benchmark_suite target:
+ * - Warmup runs, then repeated timed runs per case; median / percentile stats
+ * - Hardware counters through perf_event_open on Linux (cycles, instructions,
+ *   cache misses), silently disabled when the kernel refuses them
+ * - Extra per-case metrics (e.g. bytes per element)
+ * - Table, JSON and CSV reports so results can be diffed across builds
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 1. Hardware counters
+// One perf_event group (cycles leads, instructions and cache misses follow)
+// for the calling thread. available() is false when perf_event_open fails,
+// e.g. in containers or with kernel.perf_event_paranoid > 2.
+class PerfCounters {
+public:
+    static constexpr size_t Count = 3;
+    static constexpr const char* names[Count] = {"cycles", "instructions", "cache_misses"};
+
+private:
+    int fds[Count] = {-1, -1, -1};
+    bool ok = false;
+
+#if defined(__linux__)
+    static int openCounter(uint64_t config, int groupFd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = groupFd == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+#endif
+
+public:
+    PerfCounters() {
+#if defined(__linux__)
+        const uint64_t configs[Count] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                         PERF_COUNT_HW_CACHE_MISSES};
+        for (size_t i = 0; i < Count; ++i) {
+            fds[i] = openCounter(configs[i], i == 0 ? -1 : fds[0]);
+            if (fds[i] < 0) {
+                close();
+                return;
+            }
+        }
+        ok = true;
+#endif
+    }
+
+    ~PerfCounters() { close(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return ok; }
+
+    void start() {
+#if defined(__linux__)
+        if (ok) {
+            ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    // Fills values[] with the counts since start(); false if unavailable
+    bool stop(uint64_t (&values)[Count]) {
+#if defined(__linux__)
+        if (ok) {
+            ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            uint64_t buffer[1 + Count] = {};
+            if (read(fds[0], buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer)) && buffer[0] == Count) {
+                std::copy(buffer + 1, buffer + 1 + Count, values);
+                return true;
+            }
+        }
+#endif
+        (void)values;
+        return false;
+    }
+
+private:
+    void close() {
+#if defined(__linux__)
+        for (int& fd : fds) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+        ok = false;
+    }
+};
+
+// 2. Live-byte tracking allocator, for memory footprint of std containers
+// Counts requested bytes only; malloc headers and rounding are not included.
+inline size_t& trackedAllocatorBytes() {
+    static size_t bytes = 0;
+    return bytes;
+}
+
+template<typename T>
+struct TrackingAllocator {
+    using value_type = T;
+
+    TrackingAllocator() = default;
+    template<typename U>
+    TrackingAllocator(const TrackingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        trackedAllocatorBytes() += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) {
+        trackedAllocatorBytes() -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const TrackingAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const TrackingAllocator<U>&) const { return false; }
+};
+
+// Keeps a value observable so the optimizer cannot drop the computation
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// 3. Runs and results
+struct BenchmarkOptions {
+    int warmupRuns = 1;
+    int repetitions = 7;
+    bool hardwareCounters = true;
+    std::string filter;  // Substring of "group/name"; empty runs everything
+};
+
+// Passed to each case body. A body does its (untimed) setup, then calls
+// measure() exactly once with the number of operations the timed part does.
+class BenchmarkRun {
+private:
+    PerfCounters* counters;
+    double elapsedNs = 0;
+    uint64_t operations = 1;
+    uint64_t counterValues[PerfCounters::Count] = {};
+    bool haveCounters = false;
+    std::vector<std::pair<std::string, double>> metrics;
+
+    friend class BenchmarkSuite;
+
+public:
+    explicit BenchmarkRun(PerfCounters* perf) : counters(perf) {}
+
+    template<typename Fn>
+    void measure(uint64_t ops, Fn&& fn) {
+        operations = ops == 0 ? 1 : ops;
+        if (counters) {
+            counters->start();
+        }
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        if (counters) {
+            haveCounters = counters->stop(counterValues);
+        }
+        elapsedNs = std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    // Extra value reported with the case (last repetition wins)
+    void setMetric(const std::string& name, double value) {
+        for (auto& metric : metrics) {
+            if (metric.first == name) {
+                metric.second = value;
+                return;
+            }
+        }
+        metrics.emplace_back(name, value);
+    }
+};
+
+struct BenchmarkResult {
+    std::string group;
+    std::string name;
+    uint64_t operations = 0;
+    std::vector<double> nsPerOp;  // One sample per repetition, sorted
+    double median = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double min = 0;
+    double mean = 0;
+    double stddev = 0;
+    bool haveCounters = false;
+    double countersPerOp[PerfCounters::Count] = {};  // Medians per operation
+    std::vector<std::pair<std::string, double>> metrics;
+};
+
+// 4. Suite
+class BenchmarkSuite {
+private:
+    struct Case {
+        std::string group;
+        std::string name;
+        std::function<void(BenchmarkRun&)> body;
+    };
+
+    std::string suiteName;
+    std::vector<Case> cases;
+    std::vector<BenchmarkResult> results;
+    bool countersAvailable = false;
+
+    static double percentile(const std::vector<double>& sorted, double q) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        double rank = q * static_cast<double>(sorted.size() - 1);
+        size_t lo = static_cast<size_t>(rank);
+        size_t hi = std::min(lo + 1, sorted.size() - 1);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - static_cast<double>(lo));
+    }
+
+    static std::string jsonEscape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+
+public:
+    explicit BenchmarkSuite(std::string name) : suiteName(std::move(name)) {}
+
+    void add(std::string group, std::string name, std::function<void(BenchmarkRun&)> body) {
+        cases.push_back({std::move(group), std::move(name), std::move(body)});
+    }
+
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+    bool hardwareCountersAvailable() const { return countersAvailable; }
+
+    void run(const BenchmarkOptions& options) {
+        std::unique_ptr<PerfCounters> perf;
+        if (options.hardwareCounters) {
+            perf = std::make_unique<PerfCounters>();
+            if (!perf->available()) {
+                perf.reset();
+            }
+        }
+        countersAvailable = perf != nullptr;
+        results.clear();
+
+        for (const Case& c : cases) {
+            if (!options.filter.empty() && (c.group + "/" + c.name).find(options.filter) == std::string::npos) {
+                continue;
+            }
+            for (int w = 0; w < options.warmupRuns; ++w) {
+                BenchmarkRun warmup(nullptr);
+                c.body(warmup);
+            }
+
+            BenchmarkResult result;
+            result.group = c.group;
+            result.name = c.name;
+            std::vector<double> counterSamples[PerfCounters::Count];
+            for (int r = 0; r < std::max(1, options.repetitions); ++r) {
+                BenchmarkRun run(perf.get());
+                c.body(run);
+                result.operations = run.operations;
+                result.nsPerOp.push_back(run.elapsedNs / static_cast<double>(run.operations));
+                if (run.haveCounters) {
+                    for (size_t i = 0; i < PerfCounters::Count; ++i) {
+                        counterSamples[i].push_back(static_cast<double>(run.counterValues[i]) /
+                                                    static_cast<double>(run.operations));
+                    }
+                }
+                result.metrics = run.metrics;
+            }
+
+            std::sort(result.nsPerOp.begin(), result.nsPerOp.end());
+            const auto& samples = result.nsPerOp;
+            result.median = percentile(samples, 0.5);
+            result.p90 = percentile(samples, 0.9);
+            result.p99 = percentile(samples, 0.99);
+            result.min = samples.front();
+            double sum = 0;
+            for (double v : samples) {
+                sum += v;
+            }
+            result.mean = sum / static_cast<double>(samples.size());
+            double var = 0;
+            for (double v : samples) {
+                var += (v - result.mean) * (v - result.mean);
+            }
+            result.stddev = std::sqrt(var / static_cast<double>(samples.size()));
+            result.haveCounters = counterSamples[0].size() == samples.size();
+            if (result.haveCounters) {
+                for (size_t i = 0; i < PerfCounters::Count; ++i) {
+                    std::sort(counterSamples[i].begin(), counterSamples[i].end());
+                    result.countersPerOp[i] = percentile(counterSamples[i], 0.5);
+                }
+            }
+            results.push_back(std::move(result));
+        }
+    }
+
+    void writeTable(std::ostream& out) const {
+        out << std::left << std::setw(15) << "Group" << std::setw(34) << "Case" << std::right
+            << std::setw(11) << "median ns" << std::setw(10) << "p90 ns" << std::setw(9) << "cv %";
+        if (countersAvailable) {
+            out << std::setw(10) << "IPC" << std::setw(13) << "misses/op";
+        }
+        out << "  metrics\n";
+        for (const auto& r : results) {
+            out << std::left << std::setw(15) << r.group << std::setw(34) << r.name << std::right << std::fixed
+                << std::setprecision(2) << std::setw(11) << r.median << std::setw(10) << r.p90
+                << std::setprecision(1) << std::setw(9) << (r.mean > 0 ? 100.0 * r.stddev / r.mean : 0.0);
+            if (countersAvailable) {
+                if (r.haveCounters && r.countersPerOp[0] > 0) {
+                    out << std::setprecision(2) << std::setw(10) << r.countersPerOp[1] / r.countersPerOp[0]
+                        << std::setprecision(3) << std::setw(13) << r.countersPerOp[2];
+                } else {
+                    out << std::setw(10) << "-" << std::setw(13) << "-";
+                }
+            }
+            out << " ";
+            for (const auto& metric : r.metrics) {
+                out << " " << metric.first << "=" << std::setprecision(1) << metric.second;
+            }
+            out << "\n" << std::defaultfloat;
+        }
+        if (!countersAvailable) {
+            out << "(hardware counters unavailable: perf_event_open refused or not Linux)\n";
+        }
+    }
+
+    void writeJson(std::ostream& out) const {
+        std::time_t now = std::time(nullptr);
+        char timestamp[32];
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        out << std::setprecision(6) << "{\n  \"suite\": \"" << jsonEscape(suiteName) << "\",\n"
+            << "  \"timestamp\": \"" << timestamp << "\",\n"
+#if defined(__VERSION__)
+            << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n"
+#endif
+#if defined(__OPTIMIZE__)
+            << "  \"optimized\": true,\n"
+#else
+            << "  \"optimized\": false,\n"
+#endif
+            << "  \"hardware_counters\": " << (countersAvailable ? "true" : "false") << ",\n"
+            << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            out << "    {\"group\": \"" << jsonEscape(r.group) << "\", \"name\": \"" << jsonEscape(r.name)
+                << "\", \"operations\": " << r.operations << ", \"median_ns\": " << r.median
+                << ", \"p90_ns\": " << r.p90 << ", \"p99_ns\": " << r.p99 << ", \"min_ns\": " << r.min
+                << ", \"mean_ns\": " << r.mean << ", \"stddev_ns\": " << r.stddev << ", \"samples_ns\": [";
+            for (size_t s = 0; s < r.nsPerOp.size(); ++s) {
+                out << (s ? ", " : "") << r.nsPerOp[s];
+            }
+            out << "]";
+            if (r.haveCounters) {
+                for (size_t c = 0; c < PerfCounters::Count; ++c) {
+                    out << ", \"" << PerfCounters::names[c] << "_per_op\": " << r.countersPerOp[c];
+                }
+            }
+            for (const auto& metric : r.metrics) {
+                out << ", \"" << jsonEscape(metric.first) << "\": " << metric.second;
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    // One row per case; metric columns are emitted as name=value pairs in the last field
+    void writeCsv(std::ostream& out) const {
+        out << "suite,group,name,operations,median_ns,p90_ns,p99_ns,min_ns,mean_ns,stddev_ns";
+        for (const char* name : PerfCounters::names) {
+            out << "," << name << "_per_op";
+        }
+        out << ",metrics\n" << std::setprecision(6);
+        for (const auto& r : results) {
+            out << suiteName << "," << r.group << "," << r.name << "," << r.operations << "," << r.median << ","
+                << r.p90 << "," << r.p99 << "," << r.min << "," << r.mean << "," << r.stddev;
+            for (size_t c = 0; c < PerfCounters::Count; ++c) {
+                out << ",";
+                if (r.haveCounters) {
+                    out << r.countersPerOp[c];
+                }
+            }
+            out << ",";
+            for (size_t m = 0; m < r.metrics.size(); ++m) {
+                out << (m ? ";" : "") << r.metrics[m].first << "=" << r.metrics[m].second;
+            }
+            out << "\n";
+        }
+    }
+};
@@ -0,0 +1,214 @@
+/*
+ * Container Benchmarks
+ *
+ * Cases for BenchmarkSuite comparing vector / deque / list / set / map /
+ * unordered_map on build, iteration, random access, middle insertion and
+ * lookup. The build case reports bytes per element (TrackingAllocator).
+ * Used by 23_stl_containers.cpp and the benchmark_suite target.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark_suite.h"
+
+namespace container_bench {
+
+using Value = uint64_t;
+using Vector = std::vector<Value, TrackingAllocator<Value>>;
+using Deque = std::deque<Value, TrackingAllocator<Value>>;
+using List = std::list<Value, TrackingAllocator<Value>>;
+using Set = std::set<Value, std::less<Value>, TrackingAllocator<Value>>;
+using Map = std::map<Value, Value, std::less<Value>, TrackingAllocator<std::pair<const Value, Value>>>;
+using UnorderedMap = std::unordered_map<Value, Value, std::hash<Value>, std::equal_to<Value>,
+                                        TrackingAllocator<std::pair<const Value, Value>>>;
+
+// Keys in random order plus a shuffled lookup order, shared by all cases
+struct Data {
+    std::vector<Value> keys;
+    std::vector<Value> lookups;
+    std::vector<size_t> positions;
+};
+
+inline Data makeData(size_t n) {
+    Data data;
+    std::mt19937_64 rng(42);
+    data.keys.resize(n);
+    for (auto& key : data.keys) {
+        key = rng();
+    }
+    data.lookups = data.keys;
+    std::shuffle(data.lookups.begin(), data.lookups.end(), rng);
+    data.positions.resize(n);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    for (auto& position : data.positions) {
+        position = pick(rng);
+    }
+    return data;
+}
+
+template<typename C>
+inline C buildSequence(const Data& data) {
+    return C(data.keys.begin(), data.keys.end());
+}
+
+template<typename C>
+inline C buildAssociative(const Data& data) {
+    C c;
+    for (Value key : data.keys) {
+        if constexpr (std::is_same<C, Set>::value) {
+            c.insert(key);
+        } else {
+            c.emplace(key, key);
+        }
+    }
+    return c;
+}
+
+template<typename C>
+inline Value sumOf(const C& c) {
+    Value sum = 0;
+    for (const auto& element : c) {
+        if constexpr (std::is_same<C, Map>::value || std::is_same<C, UnorderedMap>::value) {
+            sum += element.second;
+        } else {
+            sum += element;
+        }
+    }
+    return sum;
+}
+
+// Build time and footprint: live bytes after construction over element count
+template<typename C, typename Build>
+inline void addBuild(BenchmarkSuite& suite, const std::shared_ptr<Data>& data, const char* group, Build build) {
+    const size_t n = data->keys.size();
+    suite.add(group, "build " + std::to_string(n), [data, n, build](BenchmarkRun& run) {
+        size_t before = trackedAllocatorBytes();
+        C* built = nullptr;
+        run.measure(n, [&]() { built = new C(build(*data)); });
+        run.setMetric("bytes/elem", static_cast<double>(trackedAllocatorBytes() - before) / n);
+        delete built;
+    });
+}
+
+template<typename C, typename Build>
+inline void addIterate(BenchmarkSuite& suite, const std::shared_ptr<Data>& data, const char* group, Build build) {
+    auto container = std::make_shared<C>(build(*data));
+    suite.add(group, "iterate", [container](BenchmarkRun& run) {
+        run.measure(container->size(), [&]() { doNotOptimize(sumOf(*container)); });
+    });
+}
+
+template<typename C>
+inline void addRandomAccess(BenchmarkSuite& suite, const std::shared_ptr<Data>& data, const char* group) {
+    auto container = std::make_shared<C>(buildSequence<C>(*data));
+    suite.add(group, "random access", [container, data](BenchmarkRun& run) {
+        run.measure(data->positions.size(), [&]() {
+            Value sum = 0;
+            for (size_t position : data->positions) {
+                sum += (*container)[position];
+            }
+            doNotOptimize(sum);
+        });
+    });
+}
+
+// Inserts in the middle; list gets its middle iterator outside the timed part
+template<typename C>
+inline void addInsertMiddle(BenchmarkSuite& suite, const std::shared_ptr<Data>& data, const char* group) {
+    constexpr size_t Inserts = 1000;
+    suite.add(group, "insert middle x" + std::to_string(Inserts), [data](BenchmarkRun& run) {
+        C c = buildSequence<C>(*data);
+        if constexpr (std::is_same<C, List>::value) {
+            auto middle = std::next(c.begin(), static_cast<std::ptrdiff_t>(c.size() / 2));
+            run.measure(Inserts, [&]() {
+                for (size_t i = 0; i < Inserts; ++i) {
+                    middle = c.insert(middle, data->keys[i]);
+                }
+            });
+        } else {
+            run.measure(Inserts, [&]() {
+                for (size_t i = 0; i < Inserts; ++i) {
+                    c.insert(c.begin() + static_cast<std::ptrdiff_t>(c.size() / 2), data->keys[i]);
+                }
+            });
+        }
+    });
+}
+
+template<typename C, typename Build>
+inline void addLookup(BenchmarkSuite& suite, const std::shared_ptr<Data>& data, const char* group, Build build) {
+    auto container = std::make_shared<C>(build(*data));
+    suite.add(group, "lookup", [container, data](BenchmarkRun& run) {
+        run.measure(data->lookups.size(), [&]() {
+            size_t found = 0;
+            for (Value key : data->lookups) {
+                found += container->find(key) != container->end();
+            }
+            doNotOptimize(found);
+        });
+    });
+}
+
+} // namespace container_bench
+
+// Registers every container case with n elements
+inline void addContainerBenchmarks(BenchmarkSuite& suite, size_t n) {
+    using namespace container_bench;
+    auto data = std::make_shared<Data>(makeData(n));
+    auto sortedVector = [](const Data& d) {
+        Vector v(d.keys.begin(), d.keys.end());
+        std::sort(v.begin(), v.end());
+        return v;
+    };
+
+    addBuild<Vector>(suite, data, "vector", buildSequence<Vector>);
+    addIterate<Vector>(suite, data, "vector", buildSequence<Vector>);
+    addRandomAccess<Vector>(suite, data, "vector");
+    addInsertMiddle<Vector>(suite, data, "vector");
+    // Sorted vector + binary search as the cache-friendly alternative to set
+    auto sorted = std::make_shared<Vector>(sortedVector(*data));
+    suite.add("vector", "lookup (sorted, lower_bound)", [sorted, data](BenchmarkRun& run) {
+        run.measure(data->lookups.size(), [&]() {
+            size_t found = 0;
+            for (Value key : data->lookups) {
+                auto it = std::lower_bound(sorted->begin(), sorted->end(), key);
+                found += it != sorted->end() && *it == key;
+            }
+            doNotOptimize(found);
+        });
+    });
+
+    addBuild<Deque>(suite, data, "deque", buildSequence<Deque>);
+    addIterate<Deque>(suite, data, "deque", buildSequence<Deque>);
+    addRandomAccess<Deque>(suite, data, "deque");
+    addInsertMiddle<Deque>(suite, data, "deque");
+
+    addBuild<List>(suite, data, "list", buildSequence<List>);
+    addIterate<List>(suite, data, "list", buildSequence<List>);
+    addInsertMiddle<List>(suite, data, "list");
+
+    addBuild<Set>(suite, data, "set", buildAssociative<Set>);
+    addIterate<Set>(suite, data, "set", buildAssociative<Set>);
+    addLookup<Set>(suite, data, "set", buildAssociative<Set>);
+
+    addBuild<Map>(suite, data, "map", buildAssociative<Map>);
+    addIterate<Map>(suite, data, "map", buildAssociative<Map>);
+    addLookup<Map>(suite, data, "map", buildAssociative<Map>);
+
+    addBuild<UnorderedMap>(suite, data, "unordered_map", buildAssociative<UnorderedMap>);
+    addIterate<UnorderedMap>(suite, data, "unordered_map", buildAssociative<UnorderedMap>);
+    addLookup<UnorderedMap>(suite, data, "unordered_map", buildAssociative<UnorderedMap>);
+}
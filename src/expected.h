@@ -0,0 +1,280 @@
+/*
+ * Expected
+ *
+ * expected<T, E> holds either a T or an error E, for hot paths where errors
+ * are common enough that throwing (a heap-allocated exception plus two-phase
+ * unwinding, microseconds per throw) dominates the work. It follows the
+ * C++23 std::expected interface: has_value()/value()/error()/value_or() and
+ * the monadic and_then/transform/or_else/transform_error. value() on an
+ * error throws bad_expected_access<E>. When T and E are trivially copyable
+ * so is expected<T, E>, so small results come back in registers.
+ *
+ * Error is a compact 8-byte error code (ErrorCode plus one integer of
+ * detail) that API boundaries convert to exception types. Used by
+ * 16_exception_handling.cpp (noexcept divide, exception conversion,
+ * error-rate benchmark) and 25_file_io.cpp (ConfigFileHandler::tryGetInt,
+ * CSVFileHandler::tryParseRow).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+enum class ErrorCode : uint16_t {
+    DivideByZero,
+    InvalidInput,      // detail: the offending value when there is one
+    OutOfRange,
+    NotFound,
+    TypeMismatch,
+    UnterminatedQuote, // detail: offset of the opening quote
+    FieldCount,        // detail: number of fields found
+    OutOfMemory
+};
+
+struct Error {
+    ErrorCode code;
+    int32_t detail = 0;
+};
+
+inline const char* errorMessage(ErrorCode code) noexcept {
+    switch (code) {
+        case ErrorCode::DivideByZero: return "Division by zero";
+        case ErrorCode::InvalidInput: return "Invalid input";
+        case ErrorCode::OutOfRange: return "Value out of range";
+        case ErrorCode::NotFound: return "Not found";
+        case ErrorCode::TypeMismatch: return "Type mismatch";
+        case ErrorCode::UnterminatedQuote: return "Unterminated quoted field";
+        case ErrorCode::FieldCount: return "Unexpected number of fields";
+        case ErrorCode::OutOfMemory: return "Out of memory";
+    }
+    return "Unknown error";
+}
+
+template<typename E>
+class unexpected {
+private:
+    E value;
+
+public:
+    constexpr explicit unexpected(const E& e) : value(e) {}
+    constexpr explicit unexpected(E&& e) : value(std::move(e)) {}
+
+    constexpr const E& error() const& noexcept { return value; }
+    constexpr E& error() & noexcept { return value; }
+    constexpr E&& error() && noexcept { return std::move(value); }
+};
+
+template<typename E>
+unexpected(E) -> unexpected<E>;
+
+class bad_expected_access_base : public std::exception {
+public:
+    const char* what() const noexcept override { return "bad expected access"; }
+};
+
+template<typename E>
+class bad_expected_access : public bad_expected_access_base {
+private:
+    E value;
+
+public:
+    explicit bad_expected_access(E e) : value(std::move(e)) {}
+    const E& error() const noexcept { return value; }
+};
+
+template<typename T, typename E>
+class expected;
+
+namespace expected_detail {
+
+template<typename T>
+struct IsExpected : std::false_type {};
+
+template<typename T, typename E>
+struct IsExpected<expected<T, E>> : std::true_type {};
+
+// Trivially copyable T and E: every special member stays trivial
+template<typename T, typename E,
+         bool Trivial = std::is_trivially_copyable<T>::value && std::is_trivially_copyable<E>::value>
+struct Storage {
+    union {
+        T val;
+        E err;
+    };
+    bool has;
+
+    template<typename... Args>
+    constexpr explicit Storage(std::in_place_t, Args&&... args) : val(std::forward<Args>(args)...), has(true) {}
+    constexpr explicit Storage(const unexpected<E>& e) : err(e.error()), has(false) {}
+    constexpr explicit Storage(unexpected<E>&& e) : err(std::move(e).error()), has(false) {}
+};
+
+// Otherwise the active member is copied and destroyed by hand
+template<typename T, typename E>
+struct Storage<T, E, false> {
+    union {
+        T val;
+        E err;
+    };
+    bool has;
+
+    template<typename... Args>
+    explicit Storage(std::in_place_t, Args&&... args) : val(std::forward<Args>(args)...), has(true) {}
+    explicit Storage(const unexpected<E>& e) : err(e.error()), has(false) {}
+    explicit Storage(unexpected<E>&& e) : err(std::move(e).error()), has(false) {}
+
+    Storage(const Storage& other) : has(other.has) {
+        if (has) {
+            ::new (&val) T(other.val);
+        } else {
+            ::new (&err) E(other.err);
+        }
+    }
+    Storage(Storage&& other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                      std::is_nothrow_move_constructible<E>::value)
+        : has(other.has) {
+        if (has) {
+            ::new (&val) T(std::move(other.val));
+        } else {
+            ::new (&err) E(std::move(other.err));
+        }
+    }
+    // By value, so a throwing copy happens before *this is touched
+    Storage& operator=(Storage other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                               std::is_nothrow_move_constructible<E>::value) {
+        destroy();
+        if (other.has) {
+            ::new (&val) T(std::move(other.val));
+        } else {
+            ::new (&err) E(std::move(other.err));
+        }
+        has = other.has;
+        return *this;
+    }
+    ~Storage() { destroy(); }
+
+    void destroy() noexcept {
+        if (has) {
+            val.~T();
+        } else {
+            err.~E();
+        }
+    }
+};
+
+} // namespace expected_detail
+
+template<typename T, typename E>
+class expected : private expected_detail::Storage<T, E> {
+    static_assert(!std::is_reference<T>::value && !std::is_void<T>::value, "expected<T, E> needs an object type T");
+
+private:
+    using Storage = expected_detail::Storage<T, E>;
+    using Storage::val;
+    using Storage::err;
+    using Storage::has;
+
+public:
+    using value_type = T;
+    using error_type = E;
+
+    template<typename U = T, typename = std::enable_if_t<std::is_default_constructible<U>::value>>
+    constexpr expected() : Storage(std::in_place) {}
+    constexpr expected(const T& value) : Storage(std::in_place, value) {}
+    constexpr expected(T&& value) : Storage(std::in_place, std::move(value)) {}
+    constexpr expected(const unexpected<E>& e) : Storage(e) {}
+    constexpr expected(unexpected<E>&& e) : Storage(std::move(e)) {}
+    template<typename... Args>
+    constexpr explicit expected(std::in_place_t, Args&&... args) : Storage(std::in_place, std::forward<Args>(args)...) {}
+
+    constexpr bool has_value() const noexcept { return has; }
+    constexpr explicit operator bool() const noexcept { return has; }
+
+    // Unchecked access: the caller has tested has_value()
+    constexpr T& operator*() & noexcept { return val; }
+    constexpr const T& operator*() const& noexcept { return val; }
+    constexpr T&& operator*() && noexcept { return std::move(val); }
+    constexpr T* operator->() noexcept { return &val; }
+    constexpr const T* operator->() const noexcept { return &val; }
+
+    constexpr T& value() & {
+        checkValue();
+        return val;
+    }
+    constexpr const T& value() const& {
+        checkValue();
+        return val;
+    }
+    constexpr T&& value() && {
+        checkValue();
+        return std::move(val);
+    }
+
+    constexpr const E& error() const& noexcept { return err; }
+    constexpr E& error() & noexcept { return err; }
+    constexpr E&& error() && noexcept { return std::move(err); }
+
+    template<typename U>
+    constexpr T value_or(U&& fallback) const& {
+        return has ? val : static_cast<T>(std::forward<U>(fallback));
+    }
+    template<typename U>
+    constexpr T value_or(U&& fallback) && {
+        return has ? std::move(val) : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    // f(T) -> expected<U, E>; an error passes through untouched
+    template<typename F>
+    constexpr auto and_then(F&& f) const& {
+        using Result = std::decay_t<std::invoke_result_t<F, const T&>>;
+        static_assert(expected_detail::IsExpected<Result>::value, "and_then needs a function returning an expected");
+        static_assert(std::is_same<typename Result::error_type, E>::value, "and_then must keep the error type");
+        return has ? std::forward<F>(f)(val) : Result(unexpected<E>(err));
+    }
+    template<typename F>
+    constexpr auto and_then(F&& f) && {
+        using Result = std::decay_t<std::invoke_result_t<F, T&&>>;
+        static_assert(expected_detail::IsExpected<Result>::value, "and_then needs a function returning an expected");
+        static_assert(std::is_same<typename Result::error_type, E>::value, "and_then must keep the error type");
+        return has ? std::forward<F>(f)(std::move(val)) : Result(unexpected<E>(std::move(err)));
+    }
+
+    // f(T) -> U, giving expected<U, E>
+    template<typename F>
+    constexpr auto transform(F&& f) const& {
+        using U = std::decay_t<std::invoke_result_t<F, const T&>>;
+        return has ? expected<U, E>(std::forward<F>(f)(val)) : expected<U, E>(unexpected<E>(err));
+    }
+    template<typename F>
+    constexpr auto transform(F&& f) && {
+        using U = std::decay_t<std::invoke_result_t<F, T&&>>;
+        return has ? expected<U, E>(std::forward<F>(f)(std::move(val))) : expected<U, E>(unexpected<E>(std::move(err)));
+    }
+
+    // f(E) -> expected<T, G>: recover from, or replace, an error
+    template<typename F>
+    constexpr auto or_else(F&& f) const& {
+        using Result = std::decay_t<std::invoke_result_t<F, const E&>>;
+        static_assert(expected_detail::IsExpected<Result>::value, "or_else needs a function returning an expected");
+        static_assert(std::is_same<typename Result::value_type, T>::value, "or_else must keep the value type");
+        return has ? Result(val) : std::forward<F>(f)(err);
+    }
+
+    // f(E) -> G, giving expected<T, G>
+    template<typename F>
+    constexpr auto transform_error(F&& f) const& {
+        using G = std::decay_t<std::invoke_result_t<F, const E&>>;
+        return has ? expected<T, G>(val) : expected<T, G>(unexpected<G>(std::forward<F>(f)(err)));
+    }
+
+private:
+    constexpr void checkValue() const {
+        if (!has) {
+            throw bad_expected_access<E>(err);
+        }
+    }
+};
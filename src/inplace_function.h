@@ -0,0 +1,218 @@
+/*
+ * Inline Type-Erased Callables
+ *
+ * inplace_function<Sig, Capacity> is a copyable std::function replacement
+ * that always stores the callable in its own buffer: a capture that does not
+ * fit is a compile error, never a heap allocation. unique_function<Sig,
+ * Capacity> is move-only, so it also accepts move-only callables (a
+ * packaged_task, a unique_ptr capture); it stores inline when the callable
+ * fits and falls back to the heap otherwise.
+ *
+ * Both dispatch through one pointer to a static per-type operation table.
+ * Calling an empty one throws std::bad_function_call, like std::function.
+ * Used by 22_lambda_functions.cpp, 26_multithreading.cpp (pool task type)
+ * and 02_pointers_references.cpp.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace function_detail {
+
+// relocate move-constructs into the destination and destroys the source
+template<typename R, typename... Args>
+struct VTable {
+    R (*invoke)(void* storage, Args&&... args);
+    void (*copy)(const void* from, void* to);
+    void (*relocate)(void* from, void* to) noexcept;
+    void (*destroy)(void* storage) noexcept;
+    bool onHeap;
+};
+
+// Plain call unless F is a member pointer, which needs std::invoke
+template<typename R, typename F, typename... Args>
+inline R invokeAs(F& f, Args&&... args) {
+    if constexpr (std::is_member_pointer<F>::value) {
+        return static_cast<R>(std::invoke(f, std::forward<Args>(args)...));
+    } else {
+        return static_cast<R>(f(std::forward<Args>(args)...));
+    }
+}
+
+// Empty state: no branch on the call path, the table itself throws
+template<typename R, typename... Args>
+struct EmptyOps {
+    static R invoke(void*, Args&&...) { throw std::bad_function_call(); }
+    static void copy(const void*, void*) {}
+    static void relocate(void*, void*) noexcept {}
+    static void destroy(void*) noexcept {}
+    static constexpr VTable<R, Args...> table{&invoke, &copy, &relocate, &destroy, false};
+};
+
+// Callable stored in the buffer itself
+template<typename F, typename R, typename... Args>
+struct InlineOps {
+    static R invoke(void* storage, Args&&... args) {
+        return invokeAs<R>(*static_cast<F*>(storage), std::forward<Args>(args)...);
+    }
+    static void copy(const void* from, void* to) { ::new (to) F(*static_cast<const F*>(from)); }
+    static void relocate(void* from, void* to) noexcept {
+        F* source = static_cast<F*>(from);
+        ::new (to) F(std::move(*source));
+        source->~F();
+    }
+    static void destroy(void* storage) noexcept { static_cast<F*>(storage)->~F(); }
+};
+
+// Buffer holds an owning F*; relocation just moves the pointer
+template<typename F, typename R, typename... Args>
+struct HeapOps {
+    static F*& target(void* storage) { return *static_cast<F**>(storage); }
+    static R invoke(void* storage, Args&&... args) {
+        return invokeAs<R>(*target(storage), std::forward<Args>(args)...);
+    }
+    static void relocate(void* from, void* to) noexcept { ::new (to) F*(target(from)); }
+    static void destroy(void* storage) noexcept { delete target(storage); }
+};
+
+template<typename F>
+inline bool isNullCallable(const F& f) {
+    if constexpr (std::is_pointer<F>::value || std::is_member_pointer<F>::value) {
+        return f == nullptr;
+    } else {
+        (void)f;
+        return false;
+    }
+}
+
+} // namespace function_detail
+
+template<typename Signature, size_t Capacity = 32, size_t Alignment = alignof(std::max_align_t)>
+class inplace_function;
+
+template<typename R, typename... Args, size_t Capacity, size_t Alignment>
+class inplace_function<R(Args...), Capacity, Alignment> {
+private:
+    using VTable = function_detail::VTable<R, Args...>;
+
+    template<typename F>
+    static constexpr VTable tableFor{&function_detail::InlineOps<F, R, Args...>::invoke,
+                                     &function_detail::InlineOps<F, R, Args...>::copy,
+                                     &function_detail::InlineOps<F, R, Args...>::relocate,
+                                     &function_detail::InlineOps<F, R, Args...>::destroy, false};
+
+    const VTable* vtable = &function_detail::EmptyOps<R, Args...>::table;
+    alignas(Alignment) mutable unsigned char storage[Capacity];
+
+public:
+    inplace_function() noexcept = default;
+    inplace_function(std::nullptr_t) noexcept {}
+
+    template<typename F, typename D = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same<D, inplace_function>::value &&
+                                         std::is_invocable_r<R, D&, Args...>::value>>
+    inplace_function(F&& f) {
+        static_assert(sizeof(D) <= Capacity, "callable does not fit the inline buffer; raise Capacity");
+        static_assert(Alignment % alignof(D) == 0, "callable is over-aligned for the inline buffer");
+        static_assert(std::is_copy_constructible<D>::value, "inplace_function needs a copyable callable");
+        static_assert(std::is_nothrow_move_constructible<D>::value, "callable must be nothrow movable");
+        if (!function_detail::isNullCallable(f)) {
+            ::new (storage) D(std::forward<F>(f));
+            vtable = &tableFor<D>;
+        }
+    }
+
+    inplace_function(const inplace_function& other) : vtable(other.vtable) {
+        other.vtable->copy(other.storage, storage);
+    }
+    inplace_function(inplace_function&& other) noexcept : vtable(other.vtable) {
+        other.vtable->relocate(other.storage, storage);
+        other.vtable = &function_detail::EmptyOps<R, Args...>::table;
+    }
+    ~inplace_function() { vtable->destroy(storage); }
+
+    // By value: copies (or converts) first, so *this is untouched if that throws
+    inplace_function& operator=(inplace_function other) noexcept {
+        vtable->destroy(storage);
+        other.vtable->relocate(other.storage, storage);
+        vtable = other.vtable;
+        other.vtable = &function_detail::EmptyOps<R, Args...>::table;
+        return *this;
+    }
+
+    R operator()(Args... args) const { return vtable->invoke(storage, std::forward<Args>(args)...); }
+    explicit operator bool() const noexcept { return vtable != &function_detail::EmptyOps<R, Args...>::table; }
+};
+
+template<typename Signature, size_t Capacity = 32>
+class unique_function;
+
+template<typename R, typename... Args, size_t Capacity>
+class unique_function<R(Args...), Capacity> {
+private:
+    using VTable = function_detail::VTable<R, Args...>;
+    static constexpr size_t Alignment = alignof(std::max_align_t);
+    static_assert(Capacity >= sizeof(void*), "the buffer must at least hold the heap fallback pointer");
+
+    template<typename F>
+    static constexpr bool storedInline = sizeof(F) <= Capacity && Alignment % alignof(F) == 0 &&
+                                         std::is_nothrow_move_constructible<F>::value;
+
+    template<typename F>
+    static constexpr VTable inlineTable{&function_detail::InlineOps<F, R, Args...>::invoke, nullptr,
+                                        &function_detail::InlineOps<F, R, Args...>::relocate,
+                                        &function_detail::InlineOps<F, R, Args...>::destroy, false};
+    template<typename F>
+    static constexpr VTable heapTable{&function_detail::HeapOps<F, R, Args...>::invoke, nullptr,
+                                      &function_detail::HeapOps<F, R, Args...>::relocate,
+                                      &function_detail::HeapOps<F, R, Args...>::destroy, true};
+
+    const VTable* vtable = &function_detail::EmptyOps<R, Args...>::table;
+    alignas(Alignment) mutable unsigned char storage[Capacity];
+
+public:
+    unique_function() noexcept = default;
+    unique_function(std::nullptr_t) noexcept {}
+
+    template<typename F, typename D = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same<D, unique_function>::value &&
+                                         std::is_invocable_r<R, D&, Args...>::value>>
+    unique_function(F&& f) {
+        if (function_detail::isNullCallable(f)) {
+            return;
+        }
+        if constexpr (storedInline<D>) {
+            ::new (storage) D(std::forward<F>(f));
+            vtable = &inlineTable<D>;
+        } else {
+            ::new (storage) D*(new D(std::forward<F>(f)));
+            vtable = &heapTable<D>;
+        }
+    }
+
+    unique_function(const unique_function&) = delete;
+    unique_function(unique_function&& other) noexcept : vtable(other.vtable) {
+        other.vtable->relocate(other.storage, storage);
+        other.vtable = &function_detail::EmptyOps<R, Args...>::table;
+    }
+    ~unique_function() { vtable->destroy(storage); }
+
+    unique_function& operator=(unique_function other) noexcept {
+        vtable->destroy(storage);
+        other.vtable->relocate(other.storage, storage);
+        vtable = other.vtable;
+        other.vtable = &function_detail::EmptyOps<R, Args...>::table;
+        return *this;
+    }
+
+    R operator()(Args... args) const { return vtable->invoke(storage, std::forward<Args>(args)...); }
+    explicit operator bool() const noexcept { return vtable != &function_detail::EmptyOps<R, Args...>::table; }
+
+    // True when the callable lives in the inline buffer (false when empty)
+    bool isInline() const noexcept { return static_cast<bool>(*this) && !vtable->onHeap; }
+};
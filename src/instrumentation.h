@@ -0,0 +1,548 @@
+/*
+ * Instrumentation
+ *
+ * Hot-path metrics with a compile-time off switch:
+ * - Counter: sharded relaxed atomics, one cache line per shard, so threads
+ *   counting the same event rarely share a line; value() sums the shards
+ * - Histogram: HDR-style log-linear buckets (16 per power of two, ~6%
+ *   relative error) over nanoseconds, recorded without locks
+ * - ScopedTimer / INSTRUMENT_SCOPE: records the lifetime of a scope into a
+ *   Histogram, timed with steady_clock or the TSC (TscClock)
+ * - MetricsRegistry + PeriodicExporter: named metrics dumped as JSON or in
+ *   the Prometheus text exposition format
+ * Used by simple_thread_pool.h (queue wait, task run time), 25_file_io.cpp
+ * (LogFileHandler write latency) and 17_raii.cpp (ResourcePool acquire
+ * wait); 26_multithreading.cpp shows the exporters.
+ *
+ * Build with -DINSTRUMENTATION_ENABLED=0 to compile every record, add and
+ * clock read out; metrics are still registered and export as zeros. All
+ * code linked into one program must agree on the setting.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef INSTRUMENTATION_ENABLED
+#define INSTRUMENTATION_ENABLED 1
+#endif
+
+namespace instrumentation {
+
+constexpr bool Enabled = INSTRUMENTATION_ENABLED != 0;
+
+// Clocks: now() returns ticks, toNanos() converts a tick difference
+struct SteadyClock {
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+    static uint64_t toNanos(uint64_t ticks) {
+        auto elapsed = std::chrono::steady_clock::duration(static_cast<std::chrono::steady_clock::rep>(ticks));
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+// Time-stamp counter: a few cycles per read against ~20 ns for
+// steady_clock's vDSO call. Assumes an invariant TSC (constant rate across
+// cores and power states, true of x86 CPUs from the last decade). The tick
+// rate is calibrated once against steady_clock, taking ~10 ms on first use.
+struct TscClock {
+    static uint64_t now() { return __rdtsc(); }
+    static uint64_t toNanos(uint64_t ticks) { return static_cast<uint64_t>(ticks * nanosPerTick()); }
+    static double nanosPerTick() {
+        static const double rate = [] {
+            auto wallStart = std::chrono::steady_clock::now();
+            uint64_t tscStart = __rdtsc();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            uint64_t tscEnd = __rdtsc();
+            std::chrono::duration<double, std::nano> wall = std::chrono::steady_clock::now() - wallStart;
+            return wall.count() / static_cast<double>(tscEnd - tscStart);
+        }();
+        return rate;
+    }
+};
+#else
+using TscClock = SteadyClock;
+#endif
+
+// Index of the highest set bit; value must be non-zero
+inline int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+// Thread's shard slot, assigned round-robin on first use
+inline size_t threadShardIndex() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed);
+    return shard;
+}
+
+class Counter {
+public:
+    static constexpr size_t Shards = 16;
+
+    Counter() = default;
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    void add(uint64_t n = 1) {
+        if constexpr (Enabled) {
+            shards[threadShardIndex() % Shards].value.fetch_add(n, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    Shard shards[Shards];
+};
+
+struct HistogramSnapshot {
+    std::vector<uint64_t> buckets;
+    uint64_t count = 0;
+    uint64_t sumNanos = 0;
+    uint64_t maxNanos = 0;
+
+    // Upper bound of the bucket holding the q-quantile (0 < q <= 1), capped at the maximum
+    uint64_t percentile(double q) const;
+    double mean() const { return count == 0 ? 0.0 : static_cast<double>(sumNanos) / count; }
+    // Recorded values below 2^bit ns
+    uint64_t countBelowPowerOfTwo(int bit) const;
+};
+
+// Bucket i < 16 holds the value i; above that every power-of-two range
+// [2^e, 2^(e+1)) is split into 16 equal sub-buckets, so a bucket's width is
+// at most 1/16 of its lower bound.
+class Histogram {
+public:
+    static constexpr int SubBucketBits = 4;
+    static constexpr size_t SubBuckets = size_t(1) << SubBucketBits;
+    static constexpr size_t BucketCount = (64 - SubBucketBits + 1) * SubBuckets;
+
+    Histogram() = default;
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(uint64_t nanos) {
+        if constexpr (Enabled) {
+            buckets[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(nanos, std::memory_order_relaxed);
+            uint64_t seen = max.load(std::memory_order_relaxed);
+            while (nanos > seen && !max.compare_exchange_weak(seen, nanos, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    // Concurrent records may land in only some of the fields
+    HistogramSnapshot snapshot() const;
+
+    static size_t bucketIndex(uint64_t value) {
+        if (value < SubBuckets) {
+            return static_cast<size_t>(value);
+        }
+        int shift = highestBit(value) - SubBucketBits;
+        return (shift + 1) * SubBuckets + static_cast<size_t>((value >> shift) - SubBuckets);
+    }
+    static uint64_t bucketLowerBound(size_t index) {
+        if (index < SubBuckets) {
+            return index;
+        }
+        size_t group = index / SubBuckets;
+        return (SubBuckets + index % SubBuckets) << (group - 1);
+    }
+    static uint64_t bucketUpperBound(size_t index) {
+        return index + 1 == BucketCount ? UINT64_MAX : bucketLowerBound(index + 1) - 1;
+    }
+
+private:
+    std::atomic<uint64_t> buckets[BucketCount] = {};
+    alignas(64) std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+};
+
+// Start and elapsed time of an event that begins and ends in different
+// places (e.g. enqueue and dequeue); reads no clock when instrumentation is off
+template<typename Clock = SteadyClock>
+class BasicTimestamp {
+public:
+    static BasicTimestamp now() {
+        BasicTimestamp stamp;
+        if constexpr (Enabled) {
+            stamp.ticks = Clock::now();
+        }
+        return stamp;
+    }
+    uint64_t elapsedNanos() const {
+        if constexpr (Enabled) {
+            return Clock::toNanos(Clock::now() - ticks);
+        }
+        return 0;
+    }
+
+private:
+    uint64_t ticks = 0;
+};
+
+using Timestamp = BasicTimestamp<>;
+
+// Records the time from construction to destruction into a histogram
+template<typename Clock = SteadyClock>
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& h) : target(h), start(BasicTimestamp<Clock>::now()) {}
+    ~ScopedTimer() {
+        if constexpr (Enabled) {
+            target.record(start.elapsedNanos());
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& target;
+    BasicTimestamp<Clock> start;
+};
+
+enum class ExportFormat { Json, Prometheus };
+
+// Process-wide named metrics. Lookups lock, so call sites fetch their
+// metrics once (a member or a function-local static) and keep the
+// reference; metrics live until the process exits.
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    // Returns the existing metric when the name is already registered
+    Counter& counter(const std::string& name, const std::string& help);
+    Histogram& histogram(const std::string& name, const std::string& help);
+
+    void write(std::ostream& out, ExportFormat format) const;
+    void writeJson(std::ostream& out) const;
+    // Counters as <name>_total; histograms in seconds as <name>_seconds with
+    // cumulative buckets at 2^k - 1 nanoseconds, the largest value below each
+    // power of two
+    void writePrometheus(std::ostream& out) const;
+
+private:
+    template<typename Metric>
+    struct Entry {
+        std::string name;
+        std::string help;
+        std::unique_ptr<Metric> metric;
+    };
+
+    MetricsRegistry() = default;
+
+    template<typename Metric>
+    static Metric& findOrAdd(std::vector<Entry<Metric>>& entries, const std::string& name, const std::string& help);
+
+    mutable std::mutex mutex;
+    std::vector<Entry<Counter>> counters;
+    std::vector<Entry<Histogram>> histograms;
+};
+
+inline Counter& counter(const std::string& name, const std::string& help) {
+    return MetricsRegistry::instance().counter(name, help);
+}
+
+inline Histogram& histogram(const std::string& name, const std::string& help) {
+    return MetricsRegistry::instance().histogram(name, help);
+}
+
+// One line: count, mean and p50/p99/p99.9/max in microseconds
+void writeSummary(std::ostream& out, const std::string& label, const Histogram& metric);
+
+// Rewrites path with a fresh export every interval, and once more on
+// destruction. Each export goes to path + ".tmp" first and is renamed over
+// path, so a reader never sees a half-written file.
+class PeriodicExporter {
+public:
+    PeriodicExporter(std::string path, ExportFormat format, std::chrono::milliseconds interval);
+    ~PeriodicExporter();
+
+    PeriodicExporter(const PeriodicExporter&) = delete;
+    PeriodicExporter& operator=(const PeriodicExporter&) = delete;
+
+    bool exportNow() const;
+    uint64_t exportCount() const { return exports.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    std::string path;
+    ExportFormat format;
+    std::chrono::milliseconds interval;
+    mutable std::atomic<uint64_t> exports{0};
+    std::mutex stopMutex;
+    std::condition_variable stopSignal;
+    bool stopping = false;
+    std::thread worker;
+};
+
+} // namespace instrumentation
+
+#define INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_IMPL(a, b)
+
+// Times the rest of the enclosing scope into histogram
+#if INSTRUMENTATION_ENABLED
+    #define INSTRUMENT_SCOPE(histogram) \
+        ::instrumentation::ScopedTimer<> INSTRUMENT_CONCAT(instrumentScope_, __LINE__)(histogram)
+#else
+    #define INSTRUMENT_SCOPE(histogram) ((void)0)
+#endif
+
+namespace instrumentation {
+
+// Counter implementation
+inline uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// HistogramSnapshot implementation
+inline uint64_t HistogramSnapshot::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count) + 0.5);
+    rank = rank == 0 ? 1 : rank;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = Histogram::bucketUpperBound(i);
+            return upper < maxNanos ? upper : maxNanos;
+        }
+    }
+    return maxNanos;
+}
+
+// Power-of-two boundaries fall on bucket boundaries, so this is exact
+inline uint64_t HistogramSnapshot::countBelowPowerOfTwo(int bit) const {
+    size_t end = bit >= 64 ? buckets.size() : Histogram::bucketIndex(uint64_t(1) << bit);
+    uint64_t total = 0;
+    for (size_t i = 0; i < end && i < buckets.size(); ++i) {
+        total += buckets[i];
+    }
+    return total;
+}
+
+// Histogram implementation
+inline HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot result;
+    result.buckets.resize(BucketCount);
+    for (size_t i = 0; i < BucketCount; ++i) {
+        result.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        result.count += result.buckets[i];
+    }
+    result.sumNanos = sum.load(std::memory_order_relaxed);
+    result.maxNanos = max.load(std::memory_order_relaxed);
+    return result;
+}
+
+// Restores a stream's number formatting on scope exit, so exports look the
+// same whatever the caller left set
+class StreamFormatGuard {
+public:
+    explicit StreamFormatGuard(std::ostream& s) : stream(s), flags(s.flags()), precision(s.precision()) {}
+    ~StreamFormatGuard() {
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+    StreamFormatGuard(const StreamFormatGuard&) = delete;
+    StreamFormatGuard& operator=(const StreamFormatGuard&) = delete;
+
+private:
+    std::ostream& stream;
+    std::ios::fmtflags flags;
+    std::streamsize precision;
+};
+
+// Whole nanoseconds as exact decimal seconds (1023 -> "0.000001023"), so a
+// bucket bound never rounds past the values it counts
+inline std::string nanosAsSeconds(uint64_t nanos) {
+    std::string fraction = std::to_string(nanos % 1000000000);
+    return std::to_string(nanos / 1000000000) + "." + std::string(9 - fraction.size(), '0') + fraction;
+}
+
+// MetricsRegistry implementation
+// Never destroyed: worker threads and static destructors may still record
+// into metrics while the process exits
+inline MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
+
+template<typename Metric>
+Metric& MetricsRegistry::findOrAdd(std::vector<Entry<Metric>>& entries, const std::string& name,
+                                   const std::string& help) {
+    for (auto& entry : entries) {
+        if (entry.name == name) {
+            return *entry.metric;
+        }
+    }
+    entries.push_back({name, help, std::make_unique<Metric>()});
+    return *entries.back().metric;
+}
+
+inline Counter& MetricsRegistry::counter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return findOrAdd(counters, name, help);
+}
+
+inline Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return findOrAdd(histograms, name, help);
+}
+
+inline void MetricsRegistry::write(std::ostream& out, ExportFormat format) const {
+    if (format == ExportFormat::Json) {
+        writeJson(out);
+    } else {
+        writePrometheus(out);
+    }
+}
+
+// Metric names are identifiers chosen by the code, so they need no escaping
+inline void MetricsRegistry::writeJson(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    StreamFormatGuard restore(out);
+    out << std::fixed << std::setprecision(1);
+    out << "{\n  \"counters\": {";
+    for (size_t i = 0; i < counters.size(); ++i) {
+        out << (i ? "," : "") << "\n    \"" << counters[i].name << "\": " << counters[i].metric->value();
+    }
+    out << (counters.empty() ? "" : "\n  ") << "},\n  \"histograms\": {";
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        HistogramSnapshot snap = histograms[i].metric->snapshot();
+        out << (i ? "," : "") << "\n    \"" << histograms[i].name << "\": {\"count\": " << snap.count
+            << ", \"sum_ns\": " << snap.sumNanos << ", \"mean_ns\": " << snap.mean()
+            << ", \"p50_ns\": " << snap.percentile(0.50) << ", \"p90_ns\": " << snap.percentile(0.90)
+            << ", \"p99_ns\": " << snap.percentile(0.99) << ", \"p999_ns\": " << snap.percentile(0.999)
+            << ", \"max_ns\": " << snap.maxNanos << "}";
+    }
+    out << (histograms.empty() ? "" : "\n  ") << "}\n}\n";
+}
+
+// Buckets stop at the first boundary that holds every value, so an idle
+// histogram exports only +Inf
+inline void MetricsRegistry::writePrometheus(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    StreamFormatGuard restore(out);
+    out << std::defaultfloat << std::setprecision(9);
+    for (const auto& entry : counters) {
+        out << "# HELP " << entry.name << "_total " << entry.help << "\n"
+            << "# TYPE " << entry.name << "_total counter\n"
+            << entry.name << "_total " << entry.metric->value() << "\n";
+    }
+    for (const auto& entry : histograms) {
+        HistogramSnapshot snap = entry.metric->snapshot();
+        const std::string name = entry.name + "_seconds";
+        out << "# HELP " << name << " " << entry.help << "\n"
+            << "# TYPE " << name << " histogram\n";
+        for (int bit = 0; bit < 64 && snap.count > 0; ++bit) {
+            uint64_t below = snap.countBelowPowerOfTwo(bit);
+            if (below == 0 && bit < 63 && snap.countBelowPowerOfTwo(bit + 1) == 0) {
+                continue;  // Leading empty buckets carry no information
+            }
+            // le means "at most": values below 2^bit are exactly those <= 2^bit - 1
+            out << name << "_bucket{le=\"" << nanosAsSeconds((uint64_t(1) << bit) - 1) << "\"} " << below << "\n";
+            if (below == snap.count) {
+                break;
+            }
+        }
+        out << name << "_bucket{le=\"+Inf\"} " << snap.count << "\n"
+            << name << "_sum " << static_cast<double>(snap.sumNanos) * 1e-9 << "\n"
+            << name << "_count " << snap.count << "\n";
+    }
+}
+
+inline void writeSummary(std::ostream& out, const std::string& label, const Histogram& metric) {
+    HistogramSnapshot snap = metric.snapshot();
+    StreamFormatGuard restore(out);
+    out << std::fixed << std::setprecision(2);
+    auto micros = [](double nanos) { return nanos / 1000.0; };
+    out << label << ": " << snap.count << " samples, mean " << micros(snap.mean()) << " us, p50 "
+        << micros(snap.percentile(0.50)) << " us, p99 " << micros(snap.percentile(0.99)) << " us, p99.9 "
+        << micros(snap.percentile(0.999)) << " us, max " << micros(snap.maxNanos) << " us\n";
+}
+
+// PeriodicExporter implementation
+inline PeriodicExporter::PeriodicExporter(std::string file, ExportFormat fmt, std::chrono::milliseconds every)
+    : path(std::move(file)), format(fmt), interval(every) {
+    worker = std::thread(&PeriodicExporter::run, this);
+}
+
+inline PeriodicExporter::~PeriodicExporter() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopSignal.notify_one();
+    worker.join();
+    exportNow();
+}
+
+inline bool PeriodicExporter::exportNow() const {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        MetricsRegistry::instance().write(out, format);
+        if (!out.flush()) {
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        return false;
+    }
+    exports.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+inline void PeriodicExporter::run() {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopSignal.wait_for(lock, interval, [this]() { return stopping; })) {
+        lock.unlock();
+        exportNow();
+        lock.lock();
+    }
+}
+
+} // namespace instrumentation
@@ -0,0 +1,362 @@
+/*
+ * Memory Arena and Size-Class Allocator
+ *
+ * Shared by 07_memory_management.cpp and 23_stl_containers.cpp:
+ * - MonotonicArena: chunked bump allocator growing by geometric blocks
+ * - SizeClassAllocator: segregated free lists for small objects with
+ *   per-thread caches, carving fresh blocks out of a MonotonicArena
+ * - std::pmr::memory_resource adapters for both, so STL containers can use them
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// 1. Monotonic arena
+// Allocation is a pointer bump; nothing is freed until release() or destruction.
+// When a block runs out, the next one is growthFactor times larger (capped).
+class MonotonicArena {
+private:
+    struct alignas(std::max_align_t) BlockHeader {
+        BlockHeader* next;
+        size_t capacity;  // Usable bytes after the header
+    };
+
+    BlockHeader* blocks = nullptr;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+
+    size_t nextBlockSize;
+    const double growthFactor;
+    const size_t maxBlockSize;
+
+    size_t bytesUsed = 0;
+    size_t bytesReserved = 0;
+    size_t blockCount = 0;
+
+    static uintptr_t alignUp(uintptr_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+
+    void grow(size_t bytes, size_t alignment) {
+        size_t capacity = std::max(nextBlockSize, bytes + alignment);
+        void* raw = ::operator new(sizeof(BlockHeader) + capacity);
+
+        BlockHeader* block = static_cast<BlockHeader*>(raw);
+        block->next = blocks;
+        block->capacity = capacity;
+        blocks = block;
+
+        cursor = reinterpret_cast<char*>(block + 1);
+        limit = cursor + capacity;
+        bytesReserved += capacity;
+        ++blockCount;
+
+        nextBlockSize = std::min(maxBlockSize, static_cast<size_t>(nextBlockSize * growthFactor));
+    }
+
+public:
+    explicit MonotonicArena(size_t initialBlockSize = 4096, double growth = 2.0,
+                            size_t maxBlock = size_t(64) << 20)
+        : nextBlockSize(std::max<size_t>(initialBlockSize, 64)),
+          growthFactor(std::max(growth, 1.0)),
+          maxBlockSize(std::max(maxBlock, nextBlockSize)) {}
+
+    ~MonotonicArena() { release(); }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    // alignment must be a power of two
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        uintptr_t start = alignUp(reinterpret_cast<uintptr_t>(cursor), alignment);
+        if (cursor == nullptr || start + bytes > reinterpret_cast<uintptr_t>(limit)) {
+            grow(bytes, alignment);
+            start = alignUp(reinterpret_cast<uintptr_t>(cursor), alignment);
+        }
+        cursor = reinterpret_cast<char*>(start + bytes);
+        bytesUsed += bytes;
+        return reinterpret_cast<void*>(start);
+    }
+
+    // Frees every block at once; all pointers handed out become invalid
+    void release() {
+        while (blocks) {
+            BlockHeader* next = blocks->next;
+            ::operator delete(blocks);
+            blocks = next;
+        }
+        cursor = limit = nullptr;
+        bytesUsed = bytesReserved = blockCount = 0;
+    }
+
+    size_t getBytesUsed() const { return bytesUsed; }
+    size_t getBytesReserved() const { return bytesReserved; }
+    size_t getBlockCount() const { return blockCount; }
+};
+
+// 2. Size-class allocator
+// Class sizes (four per power of two, like tcmalloc) and a lookup table from
+// (bytes + 15) / 16 to class index, built at compile time
+struct SizeClassTable {
+    static constexpr size_t MaxSize = 1024;
+    static constexpr size_t Count = 20;
+    static constexpr size_t Granularity = 16;
+    static constexpr size_t sizes[Count] = {
+        16, 32, 48, 64, 80, 96, 112, 128,
+        160, 192, 224, 256, 320, 384, 448, 512,
+        640, 768, 896, 1024
+    };
+
+    uint8_t index[MaxSize / Granularity + 1] = {};
+
+    constexpr SizeClassTable() {
+        size_t cls = 0;
+        for (size_t slot = 0; slot <= MaxSize / Granularity; ++slot) {
+            while (sizes[cls] < slot * Granularity) {
+                ++cls;
+            }
+            index[slot] = static_cast<uint8_t>(cls);
+        }
+    }
+};
+
+// Requests up to MaxSmallSize are rounded up to one of ClassCount size classes
+// and served from per-thread caches.
+// Caches refill from / spill to central free lists in batches, so the central
+// mutex is taken roughly once per BatchSize operations. Larger requests go
+// straight to ::operator new.
+class SizeClassAllocator {
+public:
+    static constexpr size_t MaxSmallSize = SizeClassTable::MaxSize;
+    static constexpr size_t ClassCount = SizeClassTable::Count;
+    static constexpr size_t Alignment = SizeClassTable::Granularity;
+
+private:
+    static constexpr size_t BatchSize = 32;
+    static constexpr size_t CacheCapacity = 2 * BatchSize;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    // State shared by every thread cache; kept alive by shared_ptr so a thread
+    // can still flush its cache after the allocator object itself is gone
+    struct Central {
+        std::mutex mutex;
+        MonotonicArena arena{64 * 1024};
+        FreeNode* freeLists[ClassCount] = {};
+        std::atomic<bool> retired{false};
+    };
+
+    struct ThreadCache {
+        uint64_t ownerId;
+        std::shared_ptr<Central> central;
+        FreeNode* heads[ClassCount] = {};
+        size_t counts[ClassCount] = {};
+
+        ThreadCache(uint64_t id, std::shared_ptr<Central> owner) : ownerId(id), central(std::move(owner)) {}
+
+        ~ThreadCache() {
+            std::lock_guard<std::mutex> lock(central->mutex);
+            for (size_t cls = 0; cls < ClassCount; ++cls) {
+                while (heads[cls]) {
+                    FreeNode* node = heads[cls];
+                    heads[cls] = node->next;
+                    node->next = central->freeLists[cls];
+                    central->freeLists[cls] = node;
+                }
+            }
+        }
+    };
+
+    static constexpr const size_t* classSizes = SizeClassTable::sizes;
+    static constexpr SizeClassTable classTable{};
+
+    inline static std::atomic<uint64_t> nextId{1};
+
+    std::shared_ptr<Central> central;
+    const uint64_t id;
+
+    static size_t classIndex(size_t bytes) {
+        return classTable.index[(bytes + Alignment - 1) / Alignment];
+    }
+
+    struct CacheList {
+        std::vector<std::unique_ptr<ThreadCache>> caches;
+        ThreadCache* last = nullptr;  // Most recently used, checked first
+    };
+
+    ThreadCache& localCache() {
+        thread_local CacheList list;
+        if (list.last && list.last->ownerId == id) {
+            return *list.last;
+        }
+        auto& caches = list.caches;
+        for (size_t i = 0; i < caches.size(); ++i) {
+            if (caches[i]->ownerId == id) {
+                list.last = caches[i].get();
+                return *list.last;
+            }
+            if (caches[i]->central->retired.load(std::memory_order_relaxed)) {
+                // Hand blocks of destroyed allocators back and drop the cache
+                caches.erase(caches.begin() + i);
+                --i;
+            }
+        }
+        caches.push_back(std::make_unique<ThreadCache>(id, central));
+        list.last = caches.back().get();
+        return *list.last;
+    }
+
+    void refill(ThreadCache& cache, size_t cls) {
+        const size_t size = classSizes[cls];
+        std::lock_guard<std::mutex> lock(central->mutex);
+
+        size_t moved = 0;
+        while (moved < BatchSize && central->freeLists[cls]) {
+            FreeNode* node = central->freeLists[cls];
+            central->freeLists[cls] = node->next;
+            node->next = cache.heads[cls];
+            cache.heads[cls] = node;
+            ++moved;
+        }
+
+        // Carve the rest of the batch as one contiguous run
+        if (moved < BatchSize) {
+            const size_t carve = BatchSize - moved;
+            char* run = static_cast<char*>(central->arena.allocate(size * carve, Alignment));
+            for (size_t i = 0; i < carve; ++i) {
+                FreeNode* node = reinterpret_cast<FreeNode*>(run + i * size);
+                node->next = cache.heads[cls];
+                cache.heads[cls] = node;
+            }
+        }
+        cache.counts[cls] += BatchSize;
+    }
+
+    void spill(ThreadCache& cache, size_t cls) {
+        std::lock_guard<std::mutex> lock(central->mutex);
+        for (size_t i = 0; i < BatchSize; ++i) {
+            FreeNode* node = cache.heads[cls];
+            cache.heads[cls] = node->next;
+            node->next = central->freeLists[cls];
+            central->freeLists[cls] = node;
+        }
+        cache.counts[cls] -= BatchSize;
+    }
+
+public:
+    SizeClassAllocator() : central(std::make_shared<Central>()), id(nextId.fetch_add(1)) {}
+
+    // Callers must have freed (or abandoned) every block before destruction;
+    // the arena memory lives until the last thread cache lets go of it
+    ~SizeClassAllocator() { central->retired.store(true, std::memory_order_relaxed); }
+
+    SizeClassAllocator(const SizeClassAllocator&) = delete;
+    SizeClassAllocator& operator=(const SizeClassAllocator&) = delete;
+
+    void* allocate(size_t bytes) {
+        if (bytes > MaxSmallSize) {
+            return ::operator new(bytes);
+        }
+        const size_t cls = classIndex(bytes == 0 ? 1 : bytes);
+        ThreadCache& cache = localCache();
+        if (!cache.heads[cls]) {
+            refill(cache, cls);
+        }
+        FreeNode* node = cache.heads[cls];
+        cache.heads[cls] = node->next;
+        --cache.counts[cls];
+        return node;
+    }
+
+    // bytes must match the size passed to allocate()
+    void deallocate(void* ptr, size_t bytes) {
+        if (!ptr) {
+            return;
+        }
+        if (bytes > MaxSmallSize) {
+            ::operator delete(ptr);
+            return;
+        }
+        const size_t cls = classIndex(bytes == 0 ? 1 : bytes);
+        ThreadCache& cache = localCache();
+        FreeNode* node = static_cast<FreeNode*>(ptr);
+        node->next = cache.heads[cls];
+        cache.heads[cls] = node;
+        if (++cache.counts[cls] >= CacheCapacity) {
+            spill(cache, cls);
+        }
+    }
+
+    static size_t roundedSize(size_t bytes) {
+        return bytes > MaxSmallSize ? bytes : classSizes[classIndex(bytes == 0 ? 1 : bytes)];
+    }
+
+    size_t getBytesReserved() const {
+        std::lock_guard<std::mutex> lock(central->mutex);
+        return central->arena.getBytesReserved();
+    }
+};
+
+// 3. std::pmr adapters
+// Pool-style resource: memory is recycled through the size classes
+class SizeClassMemoryResource : public std::pmr::memory_resource {
+private:
+    SizeClassAllocator allocator;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (alignment > SizeClassAllocator::Alignment) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+        return allocator.allocate(bytes);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (alignment > SizeClassAllocator::Alignment) {
+            ::operator delete(ptr, std::align_val_t(alignment));
+            return;
+        }
+        allocator.deallocate(ptr, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    size_t getBytesReserved() const { return allocator.getBytesReserved(); }
+};
+
+// Monotonic resource: deallocate is a no-op, everything goes at release().
+// Not thread-safe; meant for one container (or one request) at a time.
+class MonotonicArenaResource : public std::pmr::memory_resource {
+private:
+    MonotonicArena arena;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        return arena.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    explicit MonotonicArenaResource(size_t initialBlockSize = 4096, double growthFactor = 2.0)
+        : arena(initialBlockSize, growthFactor) {}
+
+    void release() { arena.release(); }
+    const MonotonicArena& getArena() const { return arena; }
+};
@@ -0,0 +1,341 @@
+/*
+ * Parallel Algorithms
+ *
+ * Fork-join algorithms on WorkStealingThreadPool:
+ * - parallel_for, with static or dynamic chunking
+ * - parallel_reduce / parallel_transform_reduce, optionally deterministic
+ * - parallel_sort (sample sort)
+ * - parallel_inclusive_scan
+ *
+ * The calling thread runs queued tasks while it waits, so the algorithms
+ * also nest inside pool tasks. An exception thrown by a body is rethrown
+ * once every chunk has finished. Used by 22_lambda_functions.cpp and
+ * 23_stl_containers.cpp.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "work_stealing_pool.h"
+
+enum class Schedule {
+    Static,  // One contiguous chunk per worker (or per grainSize): lowest overhead for uniform work
+    Dynamic  // Chunks of grainSize claimed from a shared counter: balances uneven work
+};
+
+struct ParallelOptions {
+    Schedule schedule = Schedule::Dynamic;
+    size_t grainSize = 0;        // 0 picks about 8 chunks per worker
+    bool deterministic = false;  // Reductions and scans: chunking and combine order do not depend on pool size
+};
+
+// Outstanding tasks of one fork-join region. wait() helps run pool tasks
+// until all of them are done, then rethrows the first exception.
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingThreadPool& pool) : pool(pool) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // Tasks reference this group, so it never goes away before they finish
+    ~TaskGroup() { drain(); }
+
+    template<typename F>
+    void run(F&& f) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        try {
+            pool.enqueue([this, f = std::forward<F>(f)]() mutable {
+                try {
+                    f();
+                } catch (...) {
+                    recordError();
+                }
+                pending.fetch_sub(1, std::memory_order_release);
+            });
+        } catch (...) {
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    void wait() {
+        drain();
+        if (error) {
+            std::rethrow_exception(std::exchange(error, nullptr));
+        }
+    }
+
+private:
+    WorkStealingThreadPool& pool;
+    std::atomic<size_t> pending{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    void drain() {
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (!pool.runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void recordError() {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+};
+
+namespace parallel_detail {
+
+// Fixed chunk size for deterministic mode, independent of the pool size
+constexpr size_t DeterministicGrain = 1 << 14;
+
+inline size_t defaultGrain(size_t n, size_t workers) {
+    return std::max<size_t>(1, n / (workers * 8));
+}
+
+// Calls chunk(begin, end) over [first, last); the caller runs a share too
+template<typename Chunk>
+void forEachChunk(WorkStealingThreadPool& pool, size_t first, size_t last, const ParallelOptions& options,
+                  const Chunk& chunk) {
+    if (first >= last) {
+        return;
+    }
+    const size_t n = last - first;
+    // Each branch declares its TaskGroup after the state the tasks use, so
+    // if the caller's own chunk throws, ~TaskGroup waits while it is alive
+    if (options.schedule == Schedule::Static) {
+        size_t chunks = options.grainSize ? (n + options.grainSize - 1) / options.grainSize : pool.size();
+        chunks = std::min(std::max<size_t>(1, chunks), n);
+        TaskGroup group(pool);
+        for (size_t c = 1; c < chunks; ++c) {
+            group.run([&chunk, first, n, c, chunks]() { chunk(first + n * c / chunks, first + n * (c + 1) / chunks); });
+        }
+        chunk(first, first + n / chunks);
+        group.wait();
+    } else {
+        const size_t grain = options.grainSize ? options.grainSize : defaultGrain(n, pool.size());
+        std::atomic<size_t> next{first};
+        auto claim = [&]() {
+            for (;;) {
+                size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (begin >= last) {
+                    return;
+                }
+                chunk(begin, std::min(begin + grain, last));
+            }
+        };
+        size_t helpers = std::min(pool.size(), (n + grain - 1) / grain);
+        TaskGroup group(pool);
+        for (size_t t = 1; t < helpers; ++t) {
+            group.run(claim);
+        }
+        claim();
+        group.wait();
+    }
+}
+
+} // namespace parallel_detail
+
+// body(i) for every i in [first, last)
+template<typename Body>
+void parallel_for(WorkStealingThreadPool& pool, size_t first, size_t last, Body body,
+                  const ParallelOptions& options = {}) {
+    parallel_detail::forEachChunk(pool, first, last, options, [&body](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            body(i);
+        }
+    });
+}
+
+// reduce(init, transform(x)...) over [first, last); reduce must be
+// associative. Chunk partials are always combined left to right, so reduce
+// need not be commutative. Deterministic mode also fixes the chunk size, so
+// floating-point results are the same for any pool size.
+template<typename RandomIt, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(WorkStealingThreadPool& pool, RandomIt first, RandomIt last, T init, Reduce reduce,
+                            Transform transform, const ParallelOptions& options = {}) {
+    const size_t n = static_cast<size_t>(last - first);
+    auto fold = [&](size_t begin, size_t end) {
+        T partial = transform(first[begin]);
+        for (size_t i = begin + 1; i < end; ++i) {
+            partial = reduce(std::move(partial), transform(first[i]));
+        }
+        return partial;
+    };
+
+    if (options.deterministic) {
+        const size_t grain = options.grainSize ? options.grainSize : parallel_detail::DeterministicGrain;
+        const size_t chunks = (n + grain - 1) / grain;
+        std::vector<std::optional<T>> partials(chunks);
+        parallel_for(pool, 0, chunks, [&](size_t c) { partials[c] = fold(c * grain, std::min(n, (c + 1) * grain)); },
+                     ParallelOptions{Schedule::Dynamic, 1, false});
+        for (auto& partial : partials) {
+            init = reduce(std::move(init), std::move(*partial));
+        }
+        return init;
+    }
+
+    // Chunks finish in any order; keyed by their start, they fold in order
+    std::mutex partialsMutex;
+    std::vector<std::pair<size_t, T>> partials;
+    parallel_detail::forEachChunk(pool, 0, n, options, [&](size_t begin, size_t end) {
+        T partial = fold(begin, end);
+        std::lock_guard<std::mutex> lock(partialsMutex);
+        partials.emplace_back(begin, std::move(partial));
+    });
+    std::sort(partials.begin(), partials.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto& partial : partials) {
+        init = reduce(std::move(init), std::move(partial.second));
+    }
+    return init;
+}
+
+template<typename RandomIt, typename T, typename Reduce = std::plus<>>
+T parallel_reduce(WorkStealingThreadPool& pool, RandomIt first, RandomIt last, T init, Reduce reduce = Reduce(),
+                  const ParallelOptions& options = {}) {
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    return parallel_transform_reduce(pool, first, last, std::move(init), reduce,
+                                     [](const Value& value) -> const Value& { return value; }, options);
+}
+
+// Writes the running op-fold of [first, last) to d_first (which may equal
+// first). Two passes: chunk totals in parallel, a short sequential scan of
+// the totals, then every chunk rescans from its offset in parallel. Sums
+// are kept in op's result type, so std::plus<long long> over ints does not
+// truncate the partials to int.
+template<typename RandomIt, typename OutIt, typename Op = std::plus<>>
+OutIt parallel_inclusive_scan(WorkStealingThreadPool& pool, RandomIt first, RandomIt last, OutIt d_first,
+                              Op op = Op(), const ParallelOptions& options = {}) {
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    using T = std::decay_t<std::invoke_result_t<Op&, const Value&, const Value&>>;
+    const size_t n = static_cast<size_t>(last - first);
+    if (n == 0) {
+        return d_first;
+    }
+    size_t grain = options.grainSize;
+    if (grain == 0) {
+        grain = options.deterministic ? parallel_detail::DeterministicGrain
+                                      : std::max<size_t>(1, (n + pool.size() * 4 - 1) / (pool.size() * 4));
+    }
+    const size_t chunks = (n + grain - 1) / grain;
+    std::vector<std::optional<T>> offsets(chunks);
+    const ParallelOptions perChunk{Schedule::Dynamic, 1, false};
+
+    // Chunk 0 needs no offset, so it is scanned directly in the first pass
+    parallel_for(pool, 0, chunks, [&](size_t c) {
+        const size_t begin = c * grain, end = std::min(n, begin + grain);
+        T sum = first[begin];
+        if (c == 0) {
+            d_first[begin] = sum;
+        }
+        for (size_t i = begin + 1; i < end; ++i) {
+            sum = op(std::move(sum), first[i]);
+            if (c == 0) {
+                d_first[i] = sum;
+            }
+        }
+        offsets[c] = std::move(sum);
+    }, perChunk);
+    for (size_t c = 1; c < chunks; ++c) {
+        // offsets[c - 1] stays intact: chunk c starts from it in the second pass
+        offsets[c] = op(*offsets[c - 1], std::move(*offsets[c]));
+    }
+    // offsets[c] is now the fold through chunk c; chunk c + 1 starts from it
+    parallel_for(pool, 1, chunks, [&](size_t c) {
+        const size_t begin = c * grain, end = std::min(n, begin + grain);
+        T running = *offsets[c - 1];
+        for (size_t i = begin; i < end; ++i) {
+            running = op(std::move(running), first[i]);
+            d_first[i] = running;
+        }
+    }, perChunk);
+    return d_first + static_cast<std::ptrdiff_t>(n);
+}
+
+// Sample sort: sorted oversample picks bucket splitters, blocks count and
+// scatter their elements into buckets in parallel, then buckets sort in
+// parallel. Not stable. Value type must be default-constructible (scratch
+// buffer). Heavily duplicated keys can land in one bucket, which then sorts
+// on one thread.
+template<typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(WorkStealingThreadPool& pool, RandomIt first, RandomIt last, Compare comp = Compare()) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr size_t SequentialCutoff = 1 << 15;
+    constexpr size_t Oversample = 64;
+    const size_t n = static_cast<size_t>(last - first);
+    const size_t buckets = std::min(pool.size() * 8, n / SequentialCutoff);
+    if (pool.size() < 2 || buckets < 2) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<T> samples;
+    const size_t sampleCount = buckets * Oversample;
+    const size_t stride = n / sampleCount;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        samples.push_back(first[i * stride + (i * 7919) % stride]);
+    }
+    std::sort(samples.begin(), samples.end(), comp);
+    std::vector<T> splitters;
+    for (size_t b = 1; b < buckets; ++b) {
+        splitters.push_back(samples[b * Oversample]);
+    }
+    auto bucketOf = [&](const T& value) {
+        return static_cast<size_t>(std::upper_bound(splitters.begin(), splitters.end(), value, comp) -
+                                   splitters.begin());
+    };
+
+    // counts[k * buckets + j]: elements of block k that fall into bucket j
+    const size_t blocks = buckets;
+    const ParallelOptions perTask{Schedule::Dynamic, 1, false};
+    std::vector<size_t> counts(blocks * buckets, 0);
+    parallel_for(pool, 0, blocks, [&](size_t k) {
+        size_t* blockCounts = &counts[k * buckets];
+        for (size_t i = n * k / blocks; i < n * (k + 1) / blocks; ++i) {
+            ++blockCounts[bucketOf(first[i])];
+        }
+    }, perTask);
+
+    // Turn counts into write positions: bucket-major, blocks in order
+    std::vector<size_t> bucketStart(buckets + 1);
+    size_t position = 0;
+    for (size_t j = 0; j < buckets; ++j) {
+        bucketStart[j] = position;
+        for (size_t k = 0; k < blocks; ++k) {
+            size_t count = counts[k * buckets + j];
+            counts[k * buckets + j] = position;
+            position += count;
+        }
+    }
+    bucketStart[buckets] = n;
+
+    std::vector<T> scratch(n);
+    parallel_for(pool, 0, blocks, [&](size_t k) {
+        size_t* cursor = &counts[k * buckets];
+        for (size_t i = n * k / blocks; i < n * (k + 1) / blocks; ++i) {
+            scratch[cursor[bucketOf(first[i])]++] = std::move(first[i]);
+        }
+    }, perTask);
+    parallel_for(pool, 0, buckets, [&](size_t j) {
+        auto begin = scratch.begin() + static_cast<std::ptrdiff_t>(bucketStart[j]);
+        auto end = scratch.begin() + static_cast<std::ptrdiff_t>(bucketStart[j + 1]);
+        std::sort(begin, end, comp);
+        std::move(begin, end, first + static_cast<std::ptrdiff_t>(bucketStart[j]));
+    }, perTask);
+}
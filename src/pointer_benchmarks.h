@@ -0,0 +1,168 @@
+/*
+ * Pointer Benchmarks
+ *
+ * Cases for BenchmarkSuite comparing raw pointers, unique_ptr and shared_ptr:
+ * creation/destruction, copying (shared_ptr pays two atomic refcount
+ * updates per copy), and dereferencing through a container of pointers.
+ * Used by 18_smart_pointers.cpp and the benchmark_suite target.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark_suite.h"
+
+struct PointerPayload {
+    uint64_t value;
+    uint64_t padding[3];
+
+    explicit PointerPayload(uint64_t v = 0) : value(v), padding{} {}
+};
+
+// Registers every pointer case, each doing count operations
+inline void addPointerBenchmarks(BenchmarkSuite& suite, size_t count) {
+    suite.add("create", "new/delete", [count](BenchmarkRun& run) {
+        std::vector<PointerPayload*> ptrs(count);
+        run.measure(count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                ptrs[i] = new PointerPayload(i);
+            }
+            for (PointerPayload* p : ptrs) {
+                delete p;
+            }
+        });
+    });
+    suite.add("create", "make_unique", [count](BenchmarkRun& run) {
+        std::vector<std::unique_ptr<PointerPayload>> ptrs(count);
+        run.measure(count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                ptrs[i] = std::make_unique<PointerPayload>(i);
+            }
+            for (auto& p : ptrs) {
+                p.reset();
+            }
+        });
+    });
+    suite.add("create", "make_shared (one allocation)", [count](BenchmarkRun& run) {
+        std::vector<std::shared_ptr<PointerPayload>> ptrs(count);
+        run.measure(count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                ptrs[i] = std::make_shared<PointerPayload>(i);
+            }
+            for (auto& p : ptrs) {
+                p.reset();
+            }
+        });
+    });
+    suite.add("create", "shared_ptr(new) (two allocations)", [count](BenchmarkRun& run) {
+        std::vector<std::shared_ptr<PointerPayload>> ptrs(count);
+        run.measure(count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                ptrs[i] = std::shared_ptr<PointerPayload>(new PointerPayload(i));
+            }
+            for (auto& p : ptrs) {
+                p.reset();
+            }
+        });
+    });
+
+    // Copying the same pointer count times into a preallocated vector
+    suite.add("copy", "raw pointer", [count](BenchmarkRun& run) {
+        PointerPayload payload(1);
+        std::vector<PointerPayload*> copies(count);
+        run.measure(count, [&]() {
+            for (auto& copy : copies) {
+                copy = &payload;
+                doNotOptimize(copy);
+            }
+        });
+    });
+    suite.add("copy", "unique_ptr move", [count](BenchmarkRun& run) {
+        std::vector<std::unique_ptr<PointerPayload>> slots(count);
+        slots[0] = std::make_unique<PointerPayload>(1);
+        run.measure(count, [&]() {
+            for (size_t i = 1; i < count; ++i) {
+                slots[i] = std::move(slots[i - 1]);
+            }
+            doNotOptimize(slots.back());
+        });
+    });
+    suite.add("copy", "shared_ptr copy (atomic inc+dec)", [count](BenchmarkRun& run) {
+        auto shared = std::make_shared<PointerPayload>(1);
+        std::vector<std::shared_ptr<PointerPayload>> copies(count);
+        run.measure(count, [&]() {
+            for (auto& copy : copies) {
+                copy = shared;
+            }
+            for (auto& copy : copies) {
+                copy.reset();
+            }
+        });
+    });
+    suite.add("copy", "shared_ptr by const& (no refcount)", [count](BenchmarkRun& run) {
+        auto shared = std::make_shared<PointerPayload>(1);
+        std::vector<const PointerPayload*> seen(count);
+        auto observe = [](const std::shared_ptr<PointerPayload>& p) { return p.get(); };
+        run.measure(count, [&]() {
+            for (auto& s : seen) {
+                s = observe(shared);
+                doNotOptimize(s);
+            }
+        });
+    });
+
+    // Dereference: all three handles point at the same payloads and are built
+    // once, so differences come from the handle alone. unique_ptr gets a
+    // no-op deleter and shared_ptr the aliasing constructor, so neither owns
+    // its pointee and both keep their usual size.
+    struct NonOwningDelete {
+        void operator()(PointerPayload*) const noexcept {}
+    };
+    struct DerefHandles {
+        std::shared_ptr<std::vector<PointerPayload>> storage;
+        std::vector<PointerPayload*> raw;
+        std::vector<std::unique_ptr<PointerPayload, NonOwningDelete>> unique;
+        std::vector<std::shared_ptr<PointerPayload>> shared;
+    };
+    auto handles = std::make_shared<DerefHandles>();
+    handles->storage = std::make_shared<std::vector<PointerPayload>>();
+    for (size_t i = 0; i < count; ++i) {
+        handles->storage->emplace_back(i);
+    }
+    for (PointerPayload& payload : *handles->storage) {
+        handles->raw.push_back(&payload);
+        handles->unique.emplace_back(&payload);
+        handles->shared.emplace_back(handles->storage, &payload);
+    }
+    suite.add("deref", "raw pointer", [count, handles](BenchmarkRun& run) {
+        run.measure(count, [&]() {
+            uint64_t sum = 0;
+            for (PointerPayload* p : handles->raw) {
+                sum += p->value;
+            }
+            doNotOptimize(sum);
+        });
+    });
+    suite.add("deref", "unique_ptr", [count, handles](BenchmarkRun& run) {
+        run.measure(count, [&]() {
+            uint64_t sum = 0;
+            for (const auto& p : handles->unique) {
+                sum += p->value;
+            }
+            doNotOptimize(sum);
+        });
+    });
+    suite.add("deref", "shared_ptr", [count, handles](BenchmarkRun& run) {
+        run.measure(count, [&]() {
+            uint64_t sum = 0;
+            for (const auto& p : handles->shared) {
+                sum += p->value;
+            }
+            doNotOptimize(sum);
+        });
+    });
+}
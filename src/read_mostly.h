@@ -0,0 +1,255 @@
+/*
+ * Read-Mostly Synchronization
+ *
+ * Primitives for data read far more often than it is written:
+ * - ReadLockRAII / WriteLockRAII: LockRAII's shape over a std::shared_mutex,
+ *   so readers share the lock and only writers exclude each other
+ * - SeqLock<T>: small trivially copyable snapshots; readers never write
+ *   shared memory and retry if a write overlapped their copy
+ * - RcuPtr<T>: read-copy-update publication of an immutable T; a reader's
+ *   snapshot stays valid across any number of later publishes
+ * Used by 17_raii.cpp (read/write ratio benchmark) and 25_file_io.cpp
+ * (config hot reload).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Shared (reader) ownership of a shared_mutex for the guard's lifetime
+class ReadLockRAII {
+private:
+    std::shared_mutex& mtx;
+    bool locked;
+
+public:
+    explicit ReadLockRAII(std::shared_mutex& m) : mtx(m), locked(false) { lock(); }
+    ~ReadLockRAII() { unlock(); }
+
+    // Non-copyable, non-movable
+    ReadLockRAII(const ReadLockRAII&) = delete;
+    ReadLockRAII& operator=(const ReadLockRAII&) = delete;
+    ReadLockRAII(ReadLockRAII&&) = delete;
+    ReadLockRAII& operator=(ReadLockRAII&&) = delete;
+
+    void unlock() {
+        if (locked) {
+            mtx.unlock_shared();
+            locked = false;
+        }
+    }
+    void lock() {
+        if (!locked) {
+            mtx.lock_shared();
+            locked = true;
+        }
+    }
+    bool isLocked() const { return locked; }
+};
+
+// Exclusive (writer) ownership of a shared_mutex for the guard's lifetime
+class WriteLockRAII {
+private:
+    std::shared_mutex& mtx;
+    bool locked;
+
+public:
+    explicit WriteLockRAII(std::shared_mutex& m) : mtx(m), locked(false) { lock(); }
+    ~WriteLockRAII() { unlock(); }
+
+    // Non-copyable, non-movable
+    WriteLockRAII(const WriteLockRAII&) = delete;
+    WriteLockRAII& operator=(const WriteLockRAII&) = delete;
+    WriteLockRAII(WriteLockRAII&&) = delete;
+    WriteLockRAII& operator=(WriteLockRAII&&) = delete;
+
+    void unlock() {
+        if (locked) {
+            mtx.unlock();
+            locked = false;
+        }
+    }
+    void lock() {
+        if (!locked) {
+            mtx.lock();
+            locked = true;
+        }
+    }
+    bool isLocked() const { return locked; }
+};
+
+// Sequence lock. The counter is odd while a write is in progress; a reader
+// copies the payload between two reads of the counter and retries if they
+// differ. Readers stay off the lock's cache line entirely (a shared_mutex
+// reader count bounces between cores on every read), but a write makes
+// every overlapping reader retry. Writers are serialized by a mutex.
+// The payload is held in relaxed atomic words so the racing copy is
+// well-defined (Boehm, "Can Seqlocks Get Along with Programming Language
+// Memory Models?", MSPC 2012).
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies T as raw bytes");
+    static_assert(std::is_default_constructible<T>::value, "SeqLock::load() returns a T built from raw bytes");
+
+private:
+    static constexpr size_t Words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> words[Words];
+    std::mutex writerMutex;
+
+    void storeWords(const T& value);
+    T loadWords() const;
+
+public:
+    explicit SeqLock(const T& initial = T());
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    T load() const;
+    void store(const T& value);
+
+    // Read-modify-write under the writer mutex: mutate(T&) edits a copy
+    template<typename F>
+    void update(F&& mutate);
+
+    // Completed writes so far
+    uint64_t version() const { return sequence.load(std::memory_order_acquire) / 2; }
+};
+
+// Read-copy-update cell. read() hands out a shared_ptr snapshot; publish()
+// swaps in a new version and the old one is freed when its last reader
+// drops it. Writers are serialized so update() never loses a change.
+// libstdc++ guards the pointer itself with a tiny internal lock, so a read
+// costs that lock plus a refcount increment, but never waits for a writer
+// to finish building the next version.
+template<typename T>
+class RcuPtr {
+private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<const T>> current;
+#else
+    std::shared_ptr<const T> current;  // Only touched through std::atomic_load/atomic_store
+#endif
+    std::mutex writerMutex;
+
+public:
+    explicit RcuPtr(std::shared_ptr<const T> initial);
+
+    RcuPtr(const RcuPtr&) = delete;
+    RcuPtr& operator=(const RcuPtr&) = delete;
+
+    std::shared_ptr<const T> read() const;
+    void publish(std::shared_ptr<const T> next);
+
+    // Copies the current version, applies mutate(T&) and publishes the copy
+    template<typename F>
+    void update(F&& mutate);
+};
+
+// SeqLock implementation
+template<typename T>
+SeqLock<T>::SeqLock(const T& initial) {
+    storeWords(initial);
+}
+
+template<typename T>
+void SeqLock<T>::storeWords(const T& value) {
+    uint64_t buffer[Words] = {};
+    std::memcpy(buffer, &value, sizeof(T));
+    for (size_t i = 0; i < Words; ++i) {
+        words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+T SeqLock<T>::loadWords() const {
+    uint64_t buffer[Words];
+    for (size_t i = 0; i < Words; ++i) {
+        buffer[i] = words[i].load(std::memory_order_relaxed);
+    }
+    T value;
+    std::memcpy(&value, buffer, sizeof(T));
+    return value;
+}
+
+template<typename T>
+T SeqLock<T>::load() const {
+    for (;;) {
+        uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();  // The writer may have been preempted mid-write
+            continue;
+        }
+        T value = loadWords();
+        // Keeps the payload loads above the re-check of the counter
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+            return value;
+        }
+    }
+}
+
+template<typename T>
+void SeqLock<T>::store(const T& value) {
+    update([&value](T& current) { current = value; });
+}
+
+template<typename T>
+template<typename F>
+void SeqLock<T>::update(F&& mutate) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    T value = loadWords();  // No other writer can run, so this copy is stable
+    mutate(value);
+    uint64_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    // Orders the odd counter before any payload store becomes visible
+    std::atomic_thread_fence(std::memory_order_release);
+    storeWords(value);
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+// RcuPtr implementation
+template<typename T>
+RcuPtr<T>::RcuPtr(std::shared_ptr<const T> initial) : current(std::move(initial)) {}
+
+template<typename T>
+std::shared_ptr<const T> RcuPtr<T>::read() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return current.load(std::memory_order_acquire);
+#else
+    return std::atomic_load_explicit(&current, std::memory_order_acquire);
+#endif
+}
+
+template<typename T>
+void RcuPtr<T>::publish(std::shared_ptr<const T> next) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+#if defined(__cpp_lib_atomic_shared_ptr)
+    current.store(std::move(next), std::memory_order_release);
+#else
+    std::atomic_store_explicit(&current, std::move(next), std::memory_order_release);
+#endif
+}
+
+template<typename T>
+template<typename F>
+void RcuPtr<T>::update(F&& mutate) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    auto next = std::make_shared<T>(*read());
+    mutate(*next);
+#if defined(__cpp_lib_atomic_shared_ptr)
+    current.store(std::move(next), std::memory_order_release);
+#else
+    std::atomic_store_explicit(&current, std::shared_ptr<const T>(std::move(next)), std::memory_order_release);
+#endif
+}
@@ -0,0 +1,104 @@
+/*
+ * Simple Thread Pool
+ *
+ * Fixed set of workers draining one mutex-protected FIFO queue. Tasks are
+ * unique_function: small captures stay inline in the queue slot (libstdc++
+ * std::function allocates for anything over 16 bytes), and move-only tasks
+ * such as a packaged_task work without a shared_ptr. Queue wait and task
+ * run time go to the thread_pool_* metrics (instrumentation.h). Used by
+ * 26_multithreading.cpp and async_io.h (coroutine continuations).
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "inplace_function.h"
+#include "instrumentation.h"
+
+class SimpleThreadPool {
+public:
+    using Task = unique_function<void(), 48>;
+    
+private:
+    struct QueuedTask {
+        Task task;
+        instrumentation::Timestamp enqueued;
+    };
+    
+    std::vector<std::thread> workers;
+    std::queue<QueuedTask> tasks;
+    std::mutex queueMutex;
+    std::condition_variable condition;
+    bool stop;
+    instrumentation::Histogram& queueWait;
+    instrumentation::Histogram& runTime;
+    
+public:
+    SimpleThreadPool(size_t numThreads);
+    ~SimpleThreadPool();
+    
+    template<typename F>
+    void enqueue(F&& task);
+    
+    void shutdown();
+};
+
+// SimpleThreadPool implementation
+inline SimpleThreadPool::SimpleThreadPool(size_t numThreads)
+    : stop(false),
+      queueWait(instrumentation::histogram("thread_pool_queue_wait", "Time from enqueue to a worker taking the task")),
+      runTime(instrumentation::histogram("thread_pool_task_run", "Task execution time")) {
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers.emplace_back([this]() {
+            for (;;) {
+                Task task;
+                instrumentation::Timestamp enqueued;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    condition.wait(lock, [this]() { return stop || !tasks.empty(); });
+                    if (stop && tasks.empty()) {
+                        return;
+                    }
+                    task = std::move(tasks.front().task);
+                    enqueued = tasks.front().enqueued;
+                    tasks.pop();
+                }
+                queueWait.record(enqueued.elapsedNanos());
+                INSTRUMENT_SCOPE(runTime);
+                task();
+            }
+        });
+    }
+}
+
+inline SimpleThreadPool::~SimpleThreadPool() {
+    shutdown();
+}
+
+// Notifies under the lock: the task may finish, and its owner destroy the
+// pool, as soon as the lock is released (AsyncIO's blocking backend does this)
+template<typename F>
+void SimpleThreadPool::enqueue(F&& task) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    tasks.push({Task(std::forward<F>(task)), instrumentation::Timestamp::now()});
+    condition.notify_one();
+}
+
+inline void SimpleThreadPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stop = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
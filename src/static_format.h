@@ -0,0 +1,247 @@
+/*
+ * Static Format
+ *
+ * Compile-time checked formatting into a thread-local buffer that is emitted
+ * with one fwrite per message, so nothing is allocated and messages from
+ * different threads never interleave. The format string is parsed at compile
+ * time into text pieces and argument slots; each argument is dispatched by
+ * overload to a to_chars kernel (integers, floating point) or a plain copy
+ * (strings). Used by 19_move_semantics.cpp (Logger) and 21_templates.cpp
+ * (printAll).
+ *
+ * Usage: printFormatted(FORMAT_STRING("id={} took {}ms\n"), id, ms);
+ *        "{{" and "}}" print literal braces. Other types plug in with a
+ *        formatValue(FormatBuffer&, const T&) overload found by ADL.
+ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Fixed-capacity output buffer. A message longer than Capacity is written
+// in several pieces as it fills, so only shorter messages are atomic.
+class FormatBuffer {
+public:
+    static constexpr size_t Capacity = 1024;
+
+    explicit FormatBuffer(std::FILE* sink = stdout) : sink(sink) {}
+
+    void setSink(std::FILE* target) { sink = target; }
+
+    void append(const char* text, size_t length) {
+        while (length > Capacity - used) {
+            size_t chunk = Capacity - used;
+            std::memcpy(data + used, text, chunk);
+            used = Capacity;
+            text += chunk;
+            length -= chunk;
+            flush();
+        }
+        std::memcpy(data + used, text, length);
+        used += length;
+    }
+
+    void append(char c) {
+        if (used == Capacity) {
+            flush();
+        }
+        data[used++] = c;
+    }
+
+    // Room for a to_chars kernel: flushes first if fewer than n bytes remain
+    char* reserve(size_t n) {
+        if (Capacity - used < n) {
+            flush();
+        }
+        return data + used;
+    }
+
+    void commit(char* end) { used = static_cast<size_t>(end - data); }
+
+    void flush() {
+        if (used != 0) {
+            std::fwrite(data, 1, used, sink);
+            used = 0;
+        }
+    }
+
+    const char* begin() const { return data; }
+    size_t size() const { return used; }
+
+private:
+    char data[Capacity];
+    size_t used = 0;
+    std::FILE* sink;
+};
+
+inline FormatBuffer& threadFormatBuffer() {
+    thread_local FormatBuffer buffer;
+    return buffer;
+}
+
+// Argument kernels. char and bool print as text, other integers as numbers.
+template<typename T,
+         std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value,
+                          int> = 0>
+inline void formatValue(FormatBuffer& out, T value) {
+    constexpr size_t MaxDigits = 24;  // 64-bit values with sign
+    char* first = out.reserve(MaxDigits);
+    out.commit(std::to_chars(first, first + MaxDigits, value).ptr);
+}
+
+// Shortest representation that round-trips
+template<typename T, std::enable_if_t<std::is_floating_point<T>::value, int> = 0>
+inline void formatValue(FormatBuffer& out, T value) {
+    constexpr size_t MaxChars = 64;
+    char* first = out.reserve(MaxChars);
+    out.commit(std::to_chars(first, first + MaxChars, value).ptr);
+}
+
+inline void formatValue(FormatBuffer& out, bool value) {
+    if (value) {
+        out.append("true", 4);
+    } else {
+        out.append("false", 5);
+    }
+}
+
+inline void formatValue(FormatBuffer& out, char c) {
+    out.append(c);
+}
+
+inline void formatValue(FormatBuffer& out, const char* text) {
+    out.append(text, std::strlen(text));
+}
+
+// Also takes std::string through its string_view conversion
+inline void formatValue(FormatBuffer& out, std::string_view text) {
+    out.append(text.data(), text.size());
+}
+
+// Compile-time format parsing: text runs and {} slots, in order
+struct FormatPiece {
+    size_t begin;
+    size_t length;
+    int arg;  // Argument index, or -1 for text
+};
+
+template<size_t N>
+struct FormatSpec {
+    std::array<FormatPiece, N + 1> pieces{};
+    size_t count = 0;
+    size_t args = 0;
+    bool valid = true;
+};
+
+template<size_t N>
+constexpr FormatSpec<N> parseFormat(std::string_view text) {
+    FormatSpec<N> spec;
+    size_t textStart = 0;
+    auto addText = [&](size_t end) {
+        if (end > textStart) {
+            spec.pieces[spec.count++] = {textStart, end - textStart, -1};
+        }
+    };
+    for (size_t i = 0; i < text.size(); ++i) {
+        bool doubled = i + 1 < text.size() && text[i + 1] == text[i];
+        if (text[i] == '{' && i + 1 < text.size() && text[i + 1] == '}') {
+            addText(i);
+            spec.pieces[spec.count++] = {0, 0, static_cast<int>(spec.args++)};
+        } else if ((text[i] == '{' || text[i] == '}') && doubled) {
+            addText(i + 1);  // Keep one brace of the pair
+        } else if (text[i] == '{' || text[i] == '}') {
+            spec.valid = false;
+            return spec;
+        } else {
+            continue;
+        }
+        textStart = i + 2;
+        ++i;
+    }
+    addText(text.size());
+    return spec;
+}
+
+// Wraps a string literal in a type so it can be parsed in a constant expression
+#define FORMAT_STRING(text)                                                   \
+    [] {                                                                      \
+        struct FormatString {                                                 \
+            static constexpr std::string_view value() { return text; }       \
+        };                                                                    \
+        return FormatString{};                                                \
+    }()
+
+template<typename Str>
+struct FormatTraits {
+    static constexpr std::string_view text = Str::value();
+    static constexpr FormatSpec<text.size()> spec = parseFormat<text.size()>(text);
+};
+
+template<typename Str, size_t I, typename Tuple>
+inline void formatPiece(FormatBuffer& out, const Tuple& args) {
+    constexpr FormatPiece piece = FormatTraits<Str>::spec.pieces[I];
+    if constexpr (piece.arg < 0) {
+        out.append(FormatTraits<Str>::text.data() + piece.begin, piece.length);
+    } else {
+        formatValue(out, std::get<static_cast<size_t>(piece.arg)>(args));
+    }
+}
+
+template<typename Str, typename Tuple, size_t... I>
+inline void formatPieces(FormatBuffer& out, const Tuple& args, std::index_sequence<I...>) {
+    (formatPiece<Str, I>(out, args), ...);
+}
+
+template<typename Str, typename... Args>
+inline void formatTo(FormatBuffer& out, Str, const Args&... args) {
+    using Traits = FormatTraits<Str>;
+    static_assert(Traits::spec.valid, "unmatched '{' or '}' in format string");
+    static_assert(Traits::spec.args == sizeof...(Args), "argument count does not match the {} placeholders");
+    formatPieces<Str>(out, std::forward_as_tuple(args...), std::make_index_sequence<Traits::spec.count>());
+}
+
+// Appends the arguments with separator between them
+template<typename... Args>
+inline void formatJoined(FormatBuffer& out, std::string_view separator, const Args&... args) {
+    bool first = true;
+    auto one = [&](const auto& value) {
+        if (!first) {
+            formatValue(out, separator);
+        }
+        first = false;
+        formatValue(out, value);
+    };
+    (one(args), ...);
+}
+
+// One message in this thread's buffer, written with a single fwrite
+template<typename Str, typename... Args>
+inline void writeFormatted(std::FILE* sink, Str format, const Args&... args) {
+    FormatBuffer& out = threadFormatBuffer();
+    out.setSink(sink);
+    formatTo(out, format, args...);
+    out.flush();
+}
+
+template<typename Str, typename... Args>
+inline void printFormatted(Str format, const Args&... args) {
+    writeFormatted(stdout, format, args...);
+}
+
+// The arguments joined by separator plus a newline, written with a single fwrite
+template<typename... Args>
+inline void printJoined(std::string_view separator, const Args&... args) {
+    FormatBuffer& out = threadFormatBuffer();
+    out.setSink(stdout);
+    formatJoined(out, separator, args...);
+    out.append('\n');
+    out.flush();
+}
@@ -0,0 +1,374 @@
+/*
+ * Work-Stealing Thread Pool
+ *
+ * Chase-Lev deque and the work-stealing pool built on it: each worker owns a
+ * deque (push/pop at the bottom), idle workers steal from the top, and tasks
+ * submitted from outside are spread over per-worker inboxes. Used by
+ * 26_multithreading.cpp and parallel_algorithms.h.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "inplace_function.h"
+
+// Chase-Lev work-stealing deque
+// The owning worker pushes and pops at the bottom (LIFO, cache-warm),
+// thieves take from the top (FIFO, oldest and usually largest work first).
+template<typename T>
+class ChaseLevDeque {
+private:
+    struct RingBuffer {
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+        
+        explicit RingBuffer(int64_t cap);
+        T* get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T* item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+    };
+    
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    alignas(64) std::atomic<RingBuffer*> buffer;
+    // Outgrown buffers stay alive until destruction: a thief may still be reading one
+    std::vector<std::unique_ptr<RingBuffer>> buffers;
+    
+public:
+    explicit ChaseLevDeque(int64_t initialCapacity = 256);
+    
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+    
+    void push(T* item);  // Owner thread only
+    T* pop();            // Owner thread only, nullptr when empty
+    T* steal();          // Any thread, nullptr when empty or the race was lost
+    bool empty() const;
+};
+
+// Work-stealing thread pool
+class WorkStealingThreadPool {
+public:
+    using Task = unique_function<void(), 48>;
+    
+private:
+    struct Worker {
+        ChaseLevDeque<Task> deque;   // Tasks spawned by this worker
+        std::mutex inboxMutex;
+        std::queue<Task*> inbox;     // Tasks submitted from outside the pool
+        std::thread thread;
+    };
+    
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> nextInbox{0};
+    std::atomic<size_t> pendingTasks{0};
+    std::atomic<size_t> sleepingWorkers{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<bool> stop{false};
+    
+    static inline thread_local WorkStealingThreadPool* currentPool = nullptr;
+    static inline thread_local size_t currentIndex = 0;
+    
+    void workerLoop(size_t index);
+    // index == workers.size() for a thread outside the pool: it has no deque
+    // of its own, so it only takes from inboxes and steals
+    Task* findTask(size_t index, uint32_t& rngState);
+    void runTask(Task* task);
+    void schedule(Task* task);
+    
+public:
+    explicit WorkStealingThreadPool(size_t numThreads = std::thread::hardware_concurrency());
+    ~WorkStealingThreadPool();
+    
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+    
+    // Called from a worker: pushed onto that worker's own deque.
+    // Called from any other thread: spread round-robin over the worker inboxes.
+    template<typename F, typename... Args>
+    auto submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
+    
+    template<typename F>
+    void enqueue(F&& task);
+    
+    // Runs one queued task on the calling thread, if any. A thread waiting
+    // for pool work (a fork-join in parallel_algorithms.h) calls this in a
+    // loop so it helps instead of blocking a worker.
+    bool runPendingTask();
+    
+    size_t size() const;
+    void shutdown();
+};
+
+// ChaseLevDeque implementation (Le, Pop, Cohen, Zappa Nardelli: "Correct and
+// Efficient Work-Stealing for Weak Memory Models", PPoPP 2013)
+template<typename T>
+ChaseLevDeque<T>::RingBuffer::RingBuffer(int64_t cap)
+    : capacity(cap), mask(cap - 1), slots(new std::atomic<T*>[cap]) {}
+
+template<typename T>
+ChaseLevDeque<T>::ChaseLevDeque(int64_t initialCapacity) {
+    // Capacity must be a power of two so indices wrap with a mask
+    int64_t cap = 1;
+    while (cap < initialCapacity) {
+        cap <<= 1;
+    }
+    buffers.push_back(std::make_unique<RingBuffer>(cap));
+    buffer.store(buffers.back().get(), std::memory_order_relaxed);
+}
+
+template<typename T>
+void ChaseLevDeque<T>::push(T* item) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    RingBuffer* buf = buffer.load(std::memory_order_relaxed);
+    
+    if (b - t > buf->capacity - 1) {
+        auto grown = std::make_unique<RingBuffer>(buf->capacity * 2);
+        for (int64_t i = t; i < b; ++i) {
+            grown->put(i, buf->get(i));
+        }
+        buf = grown.get();
+        buffers.push_back(std::move(grown));
+        buffer.store(buf, std::memory_order_release);
+    }
+    
+    buf->put(b, item);
+    bottom.store(b + 1, std::memory_order_release);
+}
+
+template<typename T>
+T* ChaseLevDeque<T>::pop() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    RingBuffer* buf = buffer.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+    
+    if (t > b) {
+        // Already empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    T* item = buf->get(b);
+    if (t == b) {
+        // Last element: race against thieves for it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            item = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+}
+
+template<typename T>
+T* ChaseLevDeque<T>::steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    
+    if (t >= b) {
+        return nullptr;
+    }
+    
+    RingBuffer* buf = buffer.load(std::memory_order_acquire);
+    T* item = buf->get(t);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return item;
+}
+
+template<typename T>
+bool ChaseLevDeque<T>::empty() const {
+    return top.load(std::memory_order_acquire) >= bottom.load(std::memory_order_acquire);
+}
+
+// WorkStealingThreadPool implementation
+inline WorkStealingThreadPool::WorkStealingThreadPool(size_t numThreads) {
+    numThreads = std::max<size_t>(1, numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    // Start threads only after every Worker exists, since thieves scan them all
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers[i]->thread = std::thread(&WorkStealingThreadPool::workerLoop, this, i);
+    }
+}
+
+inline WorkStealingThreadPool::~WorkStealingThreadPool() {
+    shutdown();
+}
+
+template<typename F, typename... Args>
+auto WorkStealingThreadPool::submit(F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
+    using Result = std::invoke_result_t<F, Args...>;
+    
+    // Task is move-only, so the packaged_task moves in directly (no shared_ptr)
+    std::packaged_task<Result()> task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    std::future<Result> result = task.get_future();
+    
+    schedule(new Task([task = std::move(task)]() mutable { task(); }));
+    return result;
+}
+
+template<typename F>
+void WorkStealingThreadPool::enqueue(F&& task) {
+    schedule(new Task(std::forward<F>(task)));
+}
+
+inline size_t WorkStealingThreadPool::size() const {
+    return workers.size();
+}
+
+inline void WorkStealingThreadPool::schedule(Task* task) {
+    bool fromWorker = currentPool == this;
+    if (!fromWorker && stop.load(std::memory_order_acquire)) {
+        delete task;
+        throw std::runtime_error("submit on a stopped WorkStealingThreadPool");
+    }
+    
+    // Count the task before publishing it so pendingTasks never underflows
+    pendingTasks.fetch_add(1, std::memory_order_seq_cst);
+    
+    if (fromWorker) {
+        workers[currentIndex]->deque.push(task);
+    } else {
+        Worker& target = *workers[nextInbox.fetch_add(1, std::memory_order_relaxed) % workers.size()];
+        std::lock_guard<std::mutex> lock(target.inboxMutex);
+        target.inbox.push(task);
+    }
+    
+    // Pairs with the seq_cst increment in workerLoop: either the sleeper sees
+    // pendingTasks > 0 or we see it sleeping and wake it
+    if (sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wakeUp.notify_one();
+    }
+}
+
+inline WorkStealingThreadPool::Task* WorkStealingThreadPool::findTask(size_t index, uint32_t& rngState) {
+    if (index < workers.size()) {
+        Worker& self = *workers[index];
+        
+        if (Task* task = self.deque.pop()) {
+            return task;
+        }
+        
+        std::lock_guard<std::mutex> lock(self.inboxMutex);
+        if (!self.inbox.empty()) {
+            Task* task = self.inbox.front();
+            self.inbox.pop();
+            return task;
+        }
+    }
+    
+    // Random starting victim so thieves don't all hammer worker 0
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    const size_t n = workers.size();
+    const size_t start = rngState % n;
+    
+    for (size_t k = 0; k < n; ++k) {
+        size_t victimIndex = (start + k) % n;
+        if (victimIndex == index) {
+            continue;
+        }
+        Worker& victim = *workers[victimIndex];
+        if (Task* task = victim.deque.steal()) {
+            return task;
+        }
+        std::unique_lock<std::mutex> lock(victim.inboxMutex, std::try_to_lock);
+        if (lock.owns_lock() && !victim.inbox.empty()) {
+            Task* task = victim.inbox.front();
+            victim.inbox.pop();
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+inline void WorkStealingThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    uint32_t rngState = static_cast<uint32_t>(index * 2654435761u + 1);
+    
+    for (;;) {
+        Task* task = nullptr;
+        
+        // Spin briefly before parking; a steal often succeeds on the next pass
+        for (int attempt = 0; attempt < 64 && !task; ++attempt) {
+            task = findTask(index, rngState);
+            if (!task && pendingTasks.load(std::memory_order_acquire) == 0) {
+                break;
+            }
+        }
+        
+        if (task) {
+            runTask(task);
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        wakeUp.wait(lock, [this]() {
+            return stop.load(std::memory_order_acquire) ||
+                   pendingTasks.load(std::memory_order_seq_cst) > 0;
+        });
+        sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+        
+        // Workers only exit once every task, including spawned ones, has run
+        if (stop.load(std::memory_order_acquire) &&
+            pendingTasks.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+inline void WorkStealingThreadPool::runTask(Task* task) {
+    pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+    std::unique_ptr<Task> owned(task);
+    (*owned)();
+}
+
+inline bool WorkStealingThreadPool::runPendingTask() {
+    thread_local uint32_t rngState = 0x9e3779b9u;
+    Task* task = findTask(currentPool == this ? currentIndex : workers.size(), rngState);
+    if (!task) {
+        return false;
+    }
+    runTask(task);
+    return true;
+}
+
+inline void WorkStealingThreadPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stop.store(true, std::memory_order_release);
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}